@@ -11,6 +11,7 @@
 
 #include "Components/CapsuleComponent.h"
 #include "Components/TextRenderComponent.h"
+#include "SaveGame/AutosaveCheckpointRegistry.h"
 #include "SaveGame/ModularSaveGame.h"
 #include "SaveGame/SaveGameService.h"
 #include "SaveGame/Modules/SaveGameModule_PlayerStart.h"
@@ -56,6 +57,10 @@ void AAutosaveCheckpoint::PostEditChangeProperty(FPropertyChangedEvent& Property
 	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(APlayerStart, PlayerStartTag))
 	{
 		UpdateCheckpointNameTextRenderer();
+		if (UAutosaveCheckpointRegistry* CheckpointRegistry = UAutosaveCheckpointRegistry::Get(this))
+		{
+			CheckpointRegistry->UpdateCheckpoint(*this);
+		}
 	}
 
 	Super::PostEditChangeProperty(PropertyChangedEvent);
@@ -83,6 +88,11 @@ void AAutosaveCheckpoint::SetPlayerStartTag(const FName& NewPlayerStartTag)
 
 	PlayerStartTag = NewPlayerStartTag;
 	UpdateCheckpointNameTextRenderer();
+
+	if (UAutosaveCheckpointRegistry* CheckpointRegistry = UAutosaveCheckpointRegistry::Get(this))
+	{
+		CheckpointRegistry->UpdateCheckpoint(*this);
+	}
 }
 
 void AAutosaveCheckpoint::UpdateCheckpointNameTextRenderer()
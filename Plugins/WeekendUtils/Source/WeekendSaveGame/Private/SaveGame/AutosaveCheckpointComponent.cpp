@@ -186,6 +186,7 @@ void UAutosaveCheckpointComponent::FindOrCreateCheckpoint()
 			LinkedCheckpoint->AttachToComponent(this, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
 		}
 		RenameCheckpoint();
+		CheckpointRegistry->UpdateCheckpoint(*LinkedCheckpoint);
 	}
 #endif
 }
@@ -10,8 +10,12 @@
 #include "SaveGame/AutosaveCheckpointRegistry.h"
 
 #include "EngineUtils.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Level.h"
 #include "Engine/World.h"
 #include "SaveGame/AutosaveCheckpoint.h"
+#include "SaveGame/Modules/SaveGameModule_PlayerStart.h"
+#include "WeekendSaveGame.h"
 
 UAutosaveCheckpointRegistry* UAutosaveCheckpointRegistry::Get(const UObject* ContextObject)
 {
@@ -22,51 +26,365 @@ void UAutosaveCheckpointRegistry::Initialize(FSubsystemCollectionBase& Collectio
 {
 	Super::Initialize(Collection);
 
+	if (UWorld* World = GetWorld())
+	{
+		OnActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::HandleActorSpawned));
+		OnActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &ThisClass::HandleActorDestroyed));
+	}
+	OnLevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::HandleLevelAddedToWorld);
+	OnLevelRemovedFromWorldHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ThisClass::HandleLevelRemovedFromWorld);
+
 	GatherCheckpointsInWorld();
 }
 
+void UAutosaveCheckpointRegistry::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(OnActorSpawnedHandle);
+		World->RemoveOnActorDestroyedHandler(OnActorDestroyedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(OnLevelAddedToWorldHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(OnLevelRemovedFromWorldHandle);
+	ClearCheckpointIndex();
+
+	Super::Deinitialize();
+}
+
 AAutosaveCheckpoint* UAutosaveCheckpointRegistry::FindCheckpoint(FName PlayerStartTag)
 {
 	if (AAutosaveCheckpoint* Checkpoint = GetRegisteredCheckpoint(PlayerStartTag))
 		return Checkpoint;
 
-	GatherCheckpointsInWorld();
-	return GetRegisteredCheckpoint(PlayerStartTag);
+#if WITH_EDITOR
+	// (i) Editor worlds can add actors without any of the events that maintain the index (e.g. by undo or copy & paste),
+	// so only they are scanned again on a miss. In game worlds, the index is authoritative.
+	const UWorld* World = GetWorld();
+	if (World && !World->IsGameWorld())
+	{
+		GatherCheckpointsInWorld();
+		return GetRegisteredCheckpoint(PlayerStartTag);
+	}
+#endif
+	return nullptr;
 }
 
 AAutosaveCheckpoint* UAutosaveCheckpointRegistry::GetRegisteredCheckpoint(FName PlayerStartTag) const
 {
-	auto* FoundCheckpoint = RegisteredCheckpoints.FindByPredicate([PlayerStartTag](AAutosaveCheckpoint* Checkpoint)
+	const auto* TaggedCheckpoints = CheckpointsByTag.Find(PlayerStartTag);
+	if (!TaggedCheckpoints)
+		return nullptr;
+
+	for (const TWeakObjectPtr<AAutosaveCheckpoint>& TaggedCheckpoint : *TaggedCheckpoints)
+	{
+		AAutosaveCheckpoint* Checkpoint = TaggedCheckpoint.Get();
+		if (IsValid(Checkpoint) && Checkpoint->PlayerStartTag == PlayerStartTag)
+			return Checkpoint;
+	}
+	return nullptr;
+}
+
+AAutosaveCheckpoint* UAutosaveCheckpointRegistry::FindNearestCheckpoint(const FVector& Location, double MaxDistance) const
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAutosaveCheckpointRegistry.FindNearestCheckpoint"), STAT_AutosaveCheckpointRegistry_FindNearestCheckpoint, STATGROUP_SaveGame);
+	if (CheckpointsByGridCell.IsEmpty())
+		return nullptr;
+
+	AAutosaveCheckpoint* NearestCheckpoint = nullptr;
+	double NearestDistanceSquared = FMath::Square(MaxDistance);
+	auto VisitGridCell = [&Location, &NearestCheckpoint, &NearestDistanceSquared](const TArray<TWeakObjectPtr<AAutosaveCheckpoint>>& Checkpoints)
+	{
+		for (const TWeakObjectPtr<AAutosaveCheckpoint>& WeakCheckpoint : Checkpoints)
+		{
+			AAutosaveCheckpoint* Checkpoint = WeakCheckpoint.Get();
+			if (!IsValid(Checkpoint))
+				continue;
+
+			const double DistanceSquared = FVector::DistSquared(Location, Checkpoint->GetActorLocation());
+			if (DistanceSquared < NearestDistanceSquared)
+			{
+				NearestDistanceSquared = DistanceSquared;
+				NearestCheckpoint = Checkpoint;
+			}
+		}
+	};
+
+	const FIntVector Center = GetGridCell(Location);
+	const FIntVector MinOffset = (Center - MinGridCell);
+	const FIntVector MaxOffset = (MaxGridCell - Center);
+	const int32 MaxRadius = FMath::Max3(
+		FMath::Max(FMath::Abs(MinOffset.X), FMath::Abs(MaxOffset.X)),
+		FMath::Max(FMath::Abs(MinOffset.Y), FMath::Abs(MaxOffset.Y)),
+		FMath::Max(FMath::Abs(MinOffset.Z), FMath::Abs(MaxOffset.Z)));
+
+	// Search in growing shells of grid cells around the location, until no closer checkpoint can follow:
+	for (int32 Radius = 0; Radius <= MaxRadius; ++Radius)
+	{
+		// (i) Every cell of this shell is at least (Radius - 1) cells away from the location.
+		if (FMath::Square(FMath::Max(Radius - 1, 0) * GridCellSize) > NearestDistanceSquared)
+			break;
+
+		const int64 ShellSize = (Radius == 0) ? 1 : (FMath::Cube<int64>(2 * Radius + 1) - FMath::Cube<int64>(2 * Radius - 1));
+		if (ShellSize > CheckpointsByGridCell.Num())
+		{
+			// Sparse grid: Visiting all remaining occupied cells is cheaper than visiting the remaining shells.
+			for (const auto& GridCell : CheckpointsByGridCell)
+			{
+				const FIntVector Offset = (GridCell.Key - Center);
+				if (FMath::Max3(FMath::Abs(Offset.X), FMath::Abs(Offset.Y), FMath::Abs(Offset.Z)) >= Radius)
+				{
+					VisitGridCell(GridCell.Value);
+				}
+			}
+			break;
+		}
+
+		for (int32 X = -Radius; X <= Radius; ++X)
+		{
+			for (int32 Y = -Radius; Y <= Radius; ++Y)
+			{
+				// Inside of the shell, only the cells at its top and bottom face belong to it:
+				const bool bIsOnSideFace = (FMath::Abs(X) == Radius || FMath::Abs(Y) == Radius);
+				const int32 StepZ = bIsOnSideFace ? 1 : (2 * Radius);
+				for (int32 Z = -Radius; Z <= Radius; Z += StepZ)
+				{
+					if (const auto* Checkpoints = CheckpointsByGridCell.Find(Center + FIntVector(X, Y, Z)))
+					{
+						VisitGridCell(*Checkpoints);
+					}
+				}
+			}
+		}
+	}
+
+	return NearestCheckpoint;
+}
+
+AAutosaveCheckpoint* UAutosaveCheckpointRegistry::FindCheckpointForPlayerStart(const USaveGameModule_PlayerStart* PlayerStartModule)
+{
+	if (!PlayerStartModule || PlayerStartModule->PlayerStartTag.IsEmpty())
+		return nullptr;
+
+	// (i) Only find existing names, since a tag that was never named can't belong to any checkpoint.
+	const FName PlayerStartTag = FName(*PlayerStartModule->PlayerStartTag, FNAME_Find);
+	if (!PlayerStartTag.IsNone())
 	{
-		return (IsValid(Checkpoint) && Checkpoint->PlayerStartTag == PlayerStartTag);
-	});
-	return FoundCheckpoint ? *FoundCheckpoint : nullptr;
+		if (AAutosaveCheckpoint* Checkpoint = FindCheckpoint(PlayerStartTag))
+			return Checkpoint;
+	}
+
+	return FindNearestCheckpoint(PlayerStartModule->WorldCoordinates.GetLocation());
 }
 
 void UAutosaveCheckpointRegistry::RegisterCheckpoint(AAutosaveCheckpoint& Checkpoint)
 {
-	ensureAlwaysMsgf(!RegisteredCheckpoints.Contains(&Checkpoint),
-			TEXT("Checkpoint %s is already registered"), *Checkpoint.GetHumanReadableName());
+	// (i) Spawned checkpoints register themselves through HandleActorSpawned(), so registering them again only updates the index.
+	if (IndexedCheckpoints.Contains(&Checkpoint))
+	{
+		UpdateCheckpoint(Checkpoint);
+		return;
+	}
 
-	RegisteredCheckpoints.AddUnique(&Checkpoint);
+	AddToIndex(Checkpoint);
 }
 
 void UAutosaveCheckpointRegistry::UnregisterCheckpoint(AAutosaveCheckpoint& Checkpoint)
 {
-	if (const int32 Index = RegisteredCheckpoints.IndexOfByKey(&Checkpoint); Index != INDEX_NONE)
+	RemoveFromIndex(&Checkpoint);
+}
+
+void UAutosaveCheckpointRegistry::UpdateCheckpoint(AAutosaveCheckpoint& Checkpoint)
+{
+	FIndexedCheckpoint* IndexedCheckpoint = IndexedCheckpoints.Find(&Checkpoint);
+	if (!IndexedCheckpoint)
+		return;
+
+	const TWeakObjectPtr<AAutosaveCheckpoint> WeakCheckpoint = &Checkpoint;
+	if (IndexedCheckpoint->PlayerStartTag != Checkpoint.PlayerStartTag)
 	{
-		RegisteredCheckpoints.RemoveAt(Index);
+		RemoveFromTag(WeakCheckpoint, IndexedCheckpoint->PlayerStartTag);
+		IndexedCheckpoint->PlayerStartTag = Checkpoint.PlayerStartTag;
+		CheckpointsByTag.FindOrAdd(Checkpoint.PlayerStartTag).Add(WeakCheckpoint);
+	}
+
+	const FIntVector GridCell = GetGridCell(Checkpoint.GetActorLocation());
+	if (IndexedCheckpoint->GridCell != GridCell)
+	{
+		RemoveFromGridCell(WeakCheckpoint, IndexedCheckpoint->GridCell);
+		IndexedCheckpoint->GridCell = GridCell;
+		AddToGridCell(WeakCheckpoint, GridCell);
 	}
 }
 
 void UAutosaveCheckpointRegistry::GatherCheckpointsInWorld()
 {
-	RegisteredCheckpoints.Empty();
+	ClearCheckpointIndex();
 	for (AAutosaveCheckpoint* Checkpoint : TActorRange<AAutosaveCheckpoint>(GetWorld()))
 	{
-		ensureAlwaysMsgf(!RegisteredCheckpoints.Contains(Checkpoint),
-			TEXT("Checkpoint \"%s\" is already registered"), *Checkpoint->GetHumanReadableName());
+		AddToIndex(*Checkpoint);
+	}
+}
+
+void UAutosaveCheckpointRegistry::ClearCheckpointIndex()
+{
+	for (const TPair<TWeakObjectPtr<AAutosaveCheckpoint>, FIndexedCheckpoint>& IndexedCheckpoint : IndexedCheckpoints)
+	{
+		UnbindTransformUpdated(IndexedCheckpoint.Key, IndexedCheckpoint.Value);
+	}
+	IndexedCheckpoints.Empty();
+	CheckpointsByTag.Empty();
+	CheckpointsByGridCell.Empty();
+	MinGridCell = FIntVector::ZeroValue;
+	MaxGridCell = FIntVector::ZeroValue;
+}
+
+void UAutosaveCheckpointRegistry::AddToIndex(AAutosaveCheckpoint& Checkpoint)
+{
+	const TWeakObjectPtr<AAutosaveCheckpoint> WeakCheckpoint = &Checkpoint;
+	const FIntVector GridCell = GetGridCell(Checkpoint.GetActorLocation());
+	FIndexedCheckpoint& IndexedCheckpoint = IndexedCheckpoints.Add(WeakCheckpoint, FIndexedCheckpoint{Checkpoint.PlayerStartTag, GridCell});
+	CheckpointsByTag.FindOrAdd(Checkpoint.PlayerStartTag).Add(WeakCheckpoint);
+	AddToGridCell(WeakCheckpoint, GridCell);
+
+	// Keep the grid cell of checkpoints up-to-date that move (e.g. when they are attached to a moving actor):
+	if (USceneComponent* RootComponent = Checkpoint.GetRootComponent())
+	{
+		IndexedCheckpoint.OnTransformUpdatedHandle = RootComponent->TransformUpdated.AddUObject(this, &ThisClass::HandleCheckpointTransformUpdated);
+	}
+}
+
+void UAutosaveCheckpointRegistry::RemoveFromIndex(const TWeakObjectPtr<AAutosaveCheckpoint>& Checkpoint)
+{
+	FIndexedCheckpoint IndexedCheckpoint;
+	if (!IndexedCheckpoints.RemoveAndCopyValue(Checkpoint, OUT IndexedCheckpoint))
+		return;
 
-		RegisteredCheckpoints.AddUnique(Checkpoint);
+	RemoveFromTag(Checkpoint, IndexedCheckpoint.PlayerStartTag);
+	RemoveFromGridCell(Checkpoint, IndexedCheckpoint.GridCell);
+	UnbindTransformUpdated(Checkpoint, IndexedCheckpoint);
+}
+
+void UAutosaveCheckpointRegistry::UnbindTransformUpdated(const TWeakObjectPtr<AAutosaveCheckpoint>& Checkpoint, const FIndexedCheckpoint& IndexedCheckpoint)
+{
+	USceneComponent* RootComponent = (Checkpoint.IsValid() ? Checkpoint->GetRootComponent() : nullptr);
+	if (RootComponent)
+	{
+		RootComponent->TransformUpdated.Remove(IndexedCheckpoint.OnTransformUpdatedHandle);
+	}
+}
+
+void UAutosaveCheckpointRegistry::AddToGridCell(const TWeakObjectPtr<AAutosaveCheckpoint>& Checkpoint, const FIntVector& GridCell)
+{
+	const bool bIsFirstGridCell = CheckpointsByGridCell.IsEmpty();
+	CheckpointsByGridCell.FindOrAdd(GridCell).Add(Checkpoint);
+
+	// (i) Bounds only grow (until the index is cleared), which keeps removals cheap and is still correct for queries.
+	if (bIsFirstGridCell)
+	{
+		MinGridCell = GridCell;
+		MaxGridCell = GridCell;
+	}
+	else
+	{
+		MinGridCell = FIntVector(FMath::Min(MinGridCell.X, GridCell.X), FMath::Min(MinGridCell.Y, GridCell.Y), FMath::Min(MinGridCell.Z, GridCell.Z));
+		MaxGridCell = FIntVector(FMath::Max(MaxGridCell.X, GridCell.X), FMath::Max(MaxGridCell.Y, GridCell.Y), FMath::Max(MaxGridCell.Z, GridCell.Z));
+	}
+}
+
+void UAutosaveCheckpointRegistry::RemoveFromGridCell(const TWeakObjectPtr<AAutosaveCheckpoint>& Checkpoint, const FIntVector& GridCell)
+{
+	if (auto* GridCellCheckpoints = CheckpointsByGridCell.Find(GridCell))
+	{
+		GridCellCheckpoints->RemoveSingleSwap(Checkpoint);
+		if (GridCellCheckpoints->IsEmpty())
+		{
+			CheckpointsByGridCell.Remove(GridCell);
+		}
+	}
+}
+
+void UAutosaveCheckpointRegistry::RemoveFromTag(const TWeakObjectPtr<AAutosaveCheckpoint>& Checkpoint, FName PlayerStartTag)
+{
+	if (auto* TaggedCheckpoints = CheckpointsByTag.Find(PlayerStartTag))
+	{
+		// (i) Keep the order of checkpoints with the same tag, so the first registered one keeps being found first.
+		TaggedCheckpoints->RemoveSingle(Checkpoint);
+		if (TaggedCheckpoints->IsEmpty())
+		{
+			CheckpointsByTag.Remove(PlayerStartTag);
+		}
+	}
+}
+
+FIntVector UAutosaveCheckpointRegistry::GetGridCell(const FVector& Location)
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / GridCellSize),
+		FMath::FloorToInt32(Location.Y / GridCellSize),
+		FMath::FloorToInt32(Location.Z / GridCellSize));
+}
+
+void UAutosaveCheckpointRegistry::HandleActorSpawned(AActor* Actor)
+{
+	if (AAutosaveCheckpoint* Checkpoint = Cast<AAutosaveCheckpoint>(Actor))
+	{
+		RegisterCheckpoint(*Checkpoint);
+	}
+}
+
+void UAutosaveCheckpointRegistry::HandleActorDestroyed(AActor* Actor)
+{
+	if (AAutosaveCheckpoint* Checkpoint = Cast<AAutosaveCheckpoint>(Actor))
+	{
+		UnregisterCheckpoint(*Checkpoint);
+	}
+}
+
+void UAutosaveCheckpointRegistry::HandleCheckpointTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	if (AAutosaveCheckpoint* Checkpoint = Cast<AAutosaveCheckpoint>(UpdatedComponent ? UpdatedComponent->GetOwner() : nullptr))
+	{
+		UpdateCheckpoint(*Checkpoint);
+	}
+}
+
+void UAutosaveCheckpointRegistry::HandleLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (!Level || World != GetWorld())
+		return;
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (AAutosaveCheckpoint* Checkpoint = Cast<AAutosaveCheckpoint>(Actor))
+		{
+			RegisterCheckpoint(*Checkpoint);
+		}
+	}
+}
+
+void UAutosaveCheckpointRegistry::HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld())
+		return;
+
+	// (i) A null level means that all levels of the world are removed.
+	if (!Level)
+	{
+		ClearCheckpointIndex();
+		return;
+	}
+
+	TArray<TWeakObjectPtr<AAutosaveCheckpoint>> CheckpointsToRemove;
+	for (const TPair<TWeakObjectPtr<AAutosaveCheckpoint>, FIndexedCheckpoint>& IndexedCheckpoint : IndexedCheckpoints)
+	{
+		const AAutosaveCheckpoint* Checkpoint = IndexedCheckpoint.Key.Get();
+		if (!IsValid(Checkpoint) || Checkpoint->GetLevel() == Level)
+		{
+			CheckpointsToRemove.Add(IndexedCheckpoint.Key);
+		}
+	}
+	for (const TWeakObjectPtr<AAutosaveCheckpoint>& Checkpoint : CheckpointsToRemove)
+	{
+		RemoveFromIndex(Checkpoint);
 	}
 }
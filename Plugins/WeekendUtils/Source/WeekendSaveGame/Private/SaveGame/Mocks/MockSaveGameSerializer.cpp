@@ -10,6 +10,8 @@
 #include "SaveGame/Mocks/MockSaveGameSerializer.h"
 
 #include "GameFramework/SaveGame.h"
+#include "SaveGame/ModularSaveGame.h"
+#include "StructUtils/InstancedStruct.h"
 
 bool UMockSaveGameSerializer::TrySerializeSaveGame(USaveGame& InSaveGameObject, TArray<uint8>& OutSaveData) const
 {
@@ -17,6 +19,13 @@ bool UMockSaveGameSerializer::TrySerializeSaveGame(USaveGame& InSaveGameObject,
 	USaveGame* CopyOfSaveGameObject =
 		DuplicateObject<USaveGame>(&InSaveGameObject, InSaveGameObject.GetOuter(), FName(InSaveGameObject.GetName() + "_Serialized"));
 
+	// Header data is not a property, so it has to be copied separately:
+	const UModularSaveGame* ModularSaveGame = Cast<UModularSaveGame>(&InSaveGameObject);
+	if (ModularSaveGame && ModularSaveGame->GetInstancedHeaderData().IsValid())
+	{
+		CastChecked<UModularSaveGame>(CopyOfSaveGameObject)->SetInstancedHeaderData(*ModularSaveGame->GetInstancedHeaderData());
+	}
+
 	// Give out the index of the "serialized" object as only entry of the output byte array:
 	const int32 Index = SerializedSaveGameObjects.AddUnique(CopyOfSaveGameObject);
 	OutSaveData = {static_cast<uint8>(Index)};
@@ -25,9 +34,21 @@ bool UMockSaveGameSerializer::TrySerializeSaveGame(USaveGame& InSaveGameObject,
 
 bool UMockSaveGameSerializer::TryDeserializeSaveGame(const TArray<uint8>& InSaveData, USaveGame*& OutSaveGameObject) const
 {
-	const int32 Index = (InSaveData.IsValidIndex(0) ? static_cast<int32>(InSaveData[0]) : INDEX_NONE);
-	OutSaveGameObject = (SerializedSaveGameObjects.IsValidIndex(Index) ? SerializedSaveGameObjects[Index] : nullptr);
-	return (OutSaveGameObject != nullptr);
+	// Like real deserialization, every call creates a new object, so the "serialized" version can never be mutated:
+	const USaveGame* SerializedSaveGameObject = FindSerializedSaveGameObject(InSaveData);
+	if (!SerializedSaveGameObject)
+	{
+		OutSaveGameObject = nullptr;
+		return false;
+	}
+
+	OutSaveGameObject = DuplicateObject<USaveGame>(SerializedSaveGameObject, GetOuter());
+	const UModularSaveGame* ModularSaveGame = Cast<UModularSaveGame>(SerializedSaveGameObject);
+	if (ModularSaveGame && ModularSaveGame->GetInstancedHeaderData().IsValid())
+	{
+		CastChecked<UModularSaveGame>(OutSaveGameObject)->SetInstancedHeaderData(*ModularSaveGame->GetInstancedHeaderData());
+	}
+	return true;
 }
 
 bool UMockSaveGameSerializer::DoesSaveGameExist(const FSlotName& SlotName, const int32 UserIndex) const
@@ -38,6 +59,7 @@ bool UMockSaveGameSerializer::DoesSaveGameExist(const FSlotName& SlotName, const
 bool UMockSaveGameSerializer::TrySaveDataToSlot(const TArray<uint8>& InSaveData, const FSlotName& SlotName, const int32 UserIndex)
 {
 	PretendedSaveGamesOnDisk.Add(SlotName, InSaveData);
+	PretendedTimestampsOnDisk.Add(SlotName, FDateTime::UtcNow());
 	return true;
 }
 
@@ -65,5 +87,81 @@ void UMockSaveGameSerializer::AsyncLoadGameFromSlot(const FSlotName& SlotName, c
 
 bool UMockSaveGameSerializer::TryDeleteGameInSlot(const FSlotName& SlotName, const int32 UserIndex, TOptional<FString> OptionalBackupFolder)
 {
+	PretendedTimestampsOnDisk.Remove(SlotName);
 	return (PretendedSaveGamesOnDisk.Remove(SlotName) > 0);
 }
+
+void UMockSaveGameSerializer::AsyncDeleteGameInSlot(const FSlotName& SlotName, const int32 UserIndex, TOptional<FString> OptionalBackupFolder, FOnAsyncDeleteCompleted Callback)
+{
+	const bool bSuccess = TryDeleteGameInSlot(SlotName, UserIndex, OptionalBackupFolder);
+	Callback.ExecuteIfBound(SlotName, UserIndex, bSuccess);
+}
+
+bool UMockSaveGameSerializer::UsesSlotIndex() const
+{
+	// Nothing is written to disk, so there is nothing to index:
+	return false;
+}
+
+bool UMockSaveGameSerializer::TryVerifySlot(const FSlotName& SlotName, const int32 UserIndex)
+{
+	return (FindSerializedSaveGameObject(PretendedSaveGamesOnDisk.FindRef(SlotName)) != nullptr);
+}
+
+void UMockSaveGameSerializer::AsyncVerifySlots(const TArray<FSlotName>& SlotNames, const int32 UserIndex, FOnAsyncVerifyCompleted Callback)
+{
+	TMap<FSlotName, bool> IsIntactBySlot;
+	for (const FSlotName& SlotName : SlotNames)
+	{
+		IsIntactBySlot.Add(SlotName, TryVerifySlot(SlotName, UserIndex));
+	}
+	Callback.ExecuteIfBound(UserIndex, IsIntactBySlot);
+}
+
+bool UMockSaveGameSerializer::TryDeserializeHeaderData(const TArray<uint8>& InSaveData, FInstancedStruct& OutHeaderData) const
+{
+	const UModularSaveGame* ModularSaveGame = Cast<UModularSaveGame>(FindSerializedSaveGameObject(InSaveData));
+	if (!ModularSaveGame || !ModularSaveGame->GetInstancedHeaderData().IsValid())
+		return false;
+
+	OutHeaderData = *ModularSaveGame->GetInstancedHeaderData();
+	return true;
+}
+
+bool UMockSaveGameSerializer::TryLoadHeaderDataFromSlot(const FSlotName& SlotName, const int32 UserIndex, FInstancedStruct& OutHeaderData)
+{
+	TArray<uint8> SaveData;
+	return (TryLoadDataFromSlot(SlotName, UserIndex, OUT SaveData) && TryDeserializeHeaderData(SaveData, OUT OutHeaderData));
+}
+
+void UMockSaveGameSerializer::AsyncLoadHeaderDataFromSlots(const TArray<FSlotName>& SlotNames, const int32 UserIndex, FOnAsyncHeaderScanCompleted Callback)
+{
+	TMap<FSlotName, FInstancedStruct> HeaderDataBySlot;
+	for (const FSlotName& SlotName : SlotNames)
+	{
+		if (FInstancedStruct HeaderData; TryLoadHeaderDataFromSlot(SlotName, UserIndex, OUT HeaderData))
+		{
+			HeaderDataBySlot.Add(SlotName, MoveTemp(HeaderData));
+		}
+	}
+	Callback.ExecuteIfBound(UserIndex, HeaderDataBySlot);
+}
+
+void UMockSaveGameSerializer::AsyncFindExistingSlots(const TArray<FSlotName>& SlotNames, const int32 UserIndex, FOnAsyncFindSlotsCompleted Callback)
+{
+	TMap<FSlotName, FDateTime> TimestampsOfExistingSlots;
+	for (const FSlotName& SlotName : SlotNames)
+	{
+		if (PretendedSaveGamesOnDisk.Contains(SlotName))
+		{
+			TimestampsOfExistingSlots.Add(SlotName, PretendedTimestampsOnDisk.FindRef(SlotName));
+		}
+	}
+	Callback.ExecuteIfBound(UserIndex, TimestampsOfExistingSlots);
+}
+
+USaveGame* UMockSaveGameSerializer::FindSerializedSaveGameObject(const TArray<uint8>& InSaveData) const
+{
+	const int32 Index = (InSaveData.IsValidIndex(0) ? static_cast<int32>(InSaveData[0]) : INDEX_NONE);
+	return (SerializedSaveGameObjects.IsValidIndex(Index) ? SerializedSaveGameObjects[Index].Get() : nullptr);
+}
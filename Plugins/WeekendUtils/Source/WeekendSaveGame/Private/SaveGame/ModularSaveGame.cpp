@@ -9,17 +9,25 @@
 
 #include "SaveGame/ModularSaveGame.h"
 
+#include "Algo/AllOf.h"
+#include "Algo/ForEach.h"
 #include "GameService/GameServiceLocator.h"
 #include "Logging/MessageLog.h"
+#include "Misc/Compression.h"
+#include "Misc/Crc.h"
 #include "Misc/EngineVersion.h"
 #include "Misc/UObjectToken.h"
 #include "SaveGame/SaveGameHeader.h"
 #include "SaveGame/SaveGameService.h"
 #include "SaveGame/SaveGameUtils.h"
+#include "SaveGame/Settings/SaveGameServiceSettings.h"
 #include "Serialization/CustomVersion.h"
 #include "Serialization/MemoryReader.h"
 #include "Serialization/MemoryWriter.h"
 #include "Templates/SubclassOf.h"
+#include "WeekendSaveGame.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogModularSaveGame, Log, All);
 
 ///////////////////////////////////////////////////////////////////////////////////////
 /// @UModularSaveGame
@@ -45,22 +53,57 @@ UModularSaveGame* UModularSaveGame::FindMutableCurrent(const UObject* WorldConte
 ///////////////////////////////////////////////////////////////////////////////////////
 /// SAVE GAME HEADER - Mostly copied from UE/GameplayStatic.cpp
 
+FName GetCompressionFormatName(ESaveGameCompressionFormat CompressionFormat)
+{
+	switch (CompressionFormat)
+	{
+		case ESaveGameCompressionFormat::Zlib: return NAME_Zlib;
+		case ESaveGameCompressionFormat::LZ4: return NAME_LZ4;
+		case ESaveGameCompressionFormat::Oodle: return NAME_Oodle;
+		default: return NAME_None;
+	}
+}
+
+namespace
+{
+	// Fixed-size beginning of the header since MODULAR_SAVEGAME_FILE_VERSION_COMPRESSION: FileTypeTag, SaveGameFileVersion, BodyOffset, CompressionFormat
+	// (and BodyChecksum since MODULAR_SAVEGAME_FILE_VERSION_CHECKSUMS)
+	constexpr int64 HeaderFileVersionPosition = sizeof(int32);
+	constexpr int64 HeaderBodyOffsetPosition = 2 * sizeof(int32);
+	constexpr int64 HeaderCompressionFormatPosition = HeaderBodyOffsetPosition + sizeof(int64);
+	constexpr int64 HeaderBodyInfoSize = HeaderCompressionFormatPosition + sizeof(uint8);
+	constexpr int64 HeaderBodyChecksumPosition = HeaderBodyInfoSize;
+
+	uint32 CalculateChecksum(const TArray<uint8>& InSaveData, int64 Offset, int64 Size)
+	{
+		return FCrc::MemCrc32(InSaveData.GetData() + Offset, static_cast<int32>(Size));
+	}
+}
+
 FModularSaveGameHeader::FModularSaveGameHeader() :
 	FileTypeTag(0),
 	SaveGameFileVersion(0),
-	CustomVersionFormat(static_cast<int32>(ECustomVersionSerializationFormat::Unknown))
+	BodyOffset(0),
+	CompressionFormat(ESaveGameCompressionFormat::None),
+	BodyChecksum(0),
+	CustomVersionFormat(static_cast<int32>(ECustomVersionSerializationFormat::Unknown)),
+	CustomHeaderDataOffset(0)
 {
 }
 
 FModularSaveGameHeader::FModularSaveGameHeader(TSubclassOf<UModularSaveGame> ObjectType, const FInstancedStruct& HeaderData) :
 	FileTypeTag(MODULAR_SAVEGAME_FILE_TYPE_TAG),
 	SaveGameFileVersion(MODULAR_SAVEGAME_FILE_VERSION),
+	BodyOffset(0),
+	CompressionFormat(ESaveGameCompressionFormat::None),
+	BodyChecksum(0),
 	PackageFileUEVersion(GPackageFileUEVersion),
 	SavedEngineVersion(FEngineVersion::Current()),
 	CustomVersionFormat(static_cast<int32>(ECustomVersionSerializationFormat::Latest)),
 	CustomVersions(FCurrentCustomVersions::GetAll()),
 	SaveGameClassName(ObjectType->GetPathName()),
-	CustomHeaderData(HeaderData)
+	CustomHeaderData(HeaderData),
+	CustomHeaderDataOffset(0)
 {
 }
 
@@ -68,15 +111,19 @@ void FModularSaveGameHeader::Clear()
 {
 	FileTypeTag = 0;
 	SaveGameFileVersion = 0;
+	BodyOffset = 0;
+	CompressionFormat = ESaveGameCompressionFormat::None;
+	BodyChecksum = 0;
 	PackageFileUEVersion.Reset();
 	SavedEngineVersion.Empty();
 	CustomVersionFormat = static_cast<int32>(ECustomVersionSerializationFormat::Unknown);
 	CustomVersions.Empty();
 	SaveGameClassName.Empty();
 	CustomHeaderData.Reset();
+	CustomHeaderDataOffset = 0;
 }
 
-bool FModularSaveGameHeader::TryRead(FMemoryReader& MemoryReader)
+bool FModularSaveGameHeader::TryRead(FMemoryReader& MemoryReader, bool bSkipCustomHeaderData)
 {
 	Clear();
 
@@ -90,29 +137,61 @@ bool FModularSaveGameHeader::TryRead(FMemoryReader& MemoryReader)
 
 	// Check incompatible save file version:
 	MemoryReader << SaveGameFileVersion;
-	if (SaveGameFileVersion < MODULAR_SAVEGAME_FILE_VERSION)
+	if (SaveGameFileVersion < MODULAR_SAVEGAME_FILE_VERSION_MIN || SaveGameFileVersion > MODULAR_SAVEGAME_FILE_VERSION)
 	{
 		MemoryReader.Seek(0);
 		return false;
 	}
 
+	// Read location and compression of the data after the header:
+	if (SaveGameFileVersion >= MODULAR_SAVEGAME_FILE_VERSION_COMPRESSION)
+	{
+		MemoryReader << BodyOffset;
+		MemoryReader << CompressionFormat;
+	}
+	if (SaveGameFileVersion >= MODULAR_SAVEGAME_FILE_VERSION_CHECKSUMS)
+	{
+		MemoryReader << BodyChecksum;
+	}
+
 	// Read engine and UE version information:
 	MemoryReader << PackageFileUEVersion;
 	MemoryReader << SavedEngineVersion;
-	MemoryReader.SetUEVer(PackageFileUEVersion);
-	MemoryReader.SetEngineVer(SavedEngineVersion);
 
 	// Read custom version data:
 	MemoryReader << CustomVersionFormat;
 	CustomVersions.Serialize(MemoryReader, static_cast<ECustomVersionSerializationFormat>(CustomVersionFormat));
-	MemoryReader.SetCustomVersions(CustomVersions);
+	ApplyVersions(MemoryReader);
 
-	// Read out custom header data:
+	// Read out custom header data, or skip it by continuing right after the header:
 	MemoryReader << SaveGameClassName;
+	CustomHeaderDataOffset = MemoryReader.Tell();
+	if (bSkipCustomHeaderData)
+	{
+		if (SaveGameFileVersion < MODULAR_SAVEGAME_FILE_VERSION_COMPRESSION)
+		{
+			MemoryReader.Seek(0);
+			return false;
+		}
+		MemoryReader.Seek(BodyOffset);
+		return !MemoryReader.IsError();
+	}
+	return TryReadCustomHeaderData(MemoryReader);
+}
+
+bool FModularSaveGameHeader::TryReadCustomHeaderData(FMemoryReader& MemoryReader)
+{
+	MemoryReader.Seek(CustomHeaderDataOffset);
 	FObjectAndNameAsStringProxyArchive ProxyArchive(MemoryReader, true);
 	CustomHeaderData.Serialize(ProxyArchive);
+	return !MemoryReader.IsError();
+}
 
-	return true;
+void FModularSaveGameHeader::ApplyVersions(FArchive& Archive) const
+{
+	Archive.SetUEVer(PackageFileUEVersion);
+	Archive.SetEngineVer(SavedEngineVersion);
+	Archive.SetCustomVersions(CustomVersions);
 }
 
 bool FModularSaveGameHeader::TryWrite(FMemoryWriter& MemoryWriter)
@@ -123,6 +202,12 @@ bool FModularSaveGameHeader::TryWrite(FMemoryWriter& MemoryWriter)
 	// Write version for this file format, for compatibility checks:
 	MemoryWriter << SaveGameFileVersion;
 
+	// Write placeholder location of the data after the header, which is updated below, its compression and its checksum:
+	const int64 BodyOffsetPosition = MemoryWriter.Tell();
+	MemoryWriter << BodyOffset;
+	MemoryWriter << CompressionFormat;
+	MemoryWriter << BodyChecksum;
+
 	// Write out engine and UE version information:
 	MemoryWriter << PackageFileUEVersion;
 	MemoryWriter << SavedEngineVersion;
@@ -136,9 +221,181 @@ bool FModularSaveGameHeader::TryWrite(FMemoryWriter& MemoryWriter)
 	FObjectAndNameAsStringProxyArchive ProxyArchive(MemoryWriter, true);
 	CustomHeaderData.Serialize(ProxyArchive);
 
+	// Update the location of the data after the header:
+	BodyOffset = MemoryWriter.Tell();
+	MemoryWriter.Seek(BodyOffsetPosition);
+	MemoryWriter << BodyOffset;
+	MemoryWriter.Seek(BodyOffset);
+
 	return true;
 }
 
+bool FModularSaveGameHeader::TryReadBodyInfo(const TArray<uint8>& InSaveData, int64& OutBodyOffset, ESaveGameCompressionFormat& OutCompressionFormat)
+{
+	OutBodyOffset = 0;
+	OutCompressionFormat = ESaveGameCompressionFormat::None;
+
+	FMemoryReader MemoryReader(InSaveData, true);
+	int32 ReadFileTypeTag = 0;
+	int32 ReadSaveGameFileVersion = 0;
+	MemoryReader << ReadFileTypeTag;
+	MemoryReader << ReadSaveGameFileVersion;
+	if (MemoryReader.IsError() || ReadFileTypeTag != MODULAR_SAVEGAME_FILE_TYPE_TAG ||
+		ReadSaveGameFileVersion < MODULAR_SAVEGAME_FILE_VERSION_MIN || ReadSaveGameFileVersion > MODULAR_SAVEGAME_FILE_VERSION)
+		return false;
+
+	if (ReadSaveGameFileVersion < MODULAR_SAVEGAME_FILE_VERSION_COMPRESSION)
+		return true;
+
+	MemoryReader << OutBodyOffset;
+	MemoryReader << OutCompressionFormat;
+	return (!MemoryReader.IsError() && OutBodyOffset >= HeaderBodyInfoSize && OutBodyOffset <= InSaveData.Num());
+}
+
+void FModularSaveGameHeader::WriteCompressionFormat(TArray<uint8>& InOutSaveData, ESaveGameCompressionFormat CompressionFormat)
+{
+	check(InOutSaveData.Num() >= HeaderBodyInfoSize);
+	InOutSaveData[HeaderCompressionFormatPosition] = static_cast<uint8>(CompressionFormat);
+}
+
+bool FModularSaveGameHeader::TryVerifyBodyChecksum(const TArray<uint8>& InSaveData)
+{
+	int64 ReadBodyOffset = 0;
+	ESaveGameCompressionFormat ReadCompressionFormat = ESaveGameCompressionFormat::None;
+	if (!TryReadBodyInfo(InSaveData, OUT ReadBodyOffset, OUT ReadCompressionFormat))
+		return false;
+
+	FMemoryReader MemoryReader(InSaveData, true);
+	int32 ReadSaveGameFileVersion = 0;
+	MemoryReader.Seek(HeaderFileVersionPosition);
+	MemoryReader << ReadSaveGameFileVersion;
+	if (ReadSaveGameFileVersion < MODULAR_SAVEGAME_FILE_VERSION_CHECKSUMS)
+		return true;
+
+	uint32 ReadBodyChecksum = 0;
+	MemoryReader.Seek(HeaderBodyChecksumPosition);
+	MemoryReader << ReadBodyChecksum;
+	return (!MemoryReader.IsError() && ReadBodyOffset > HeaderBodyChecksumPosition &&
+		ReadBodyChecksum == CalculateChecksum(InSaveData, ReadBodyOffset, InSaveData.Num() - ReadBodyOffset));
+}
+
+void FModularSaveGameHeader::WriteBodyChecksum(TArray<uint8>& InOutSaveData)
+{
+	int64 ReadBodyOffset = 0;
+	ESaveGameCompressionFormat ReadCompressionFormat = ESaveGameCompressionFormat::None;
+	verify(TryReadBodyInfo(InOutSaveData, OUT ReadBodyOffset, OUT ReadCompressionFormat));
+	check(ReadBodyOffset > HeaderBodyChecksumPosition);
+
+	uint32 NewBodyChecksum = CalculateChecksum(InOutSaveData, ReadBodyOffset, InOutSaveData.Num() - ReadBodyOffset);
+	FMemoryWriter MemoryWriter(InOutSaveData, true);
+	MemoryWriter.Seek(HeaderBodyChecksumPosition);
+	MemoryWriter << NewBodyChecksum;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// SAVE GAME TABLE OF CONTENTS
+
+FArchive& operator<<(FArchive& Ar, FModularSaveGameSection& Section)
+{
+	FString ModuleName = Section.ModuleName.ToString();
+	Ar << ModuleName;
+	Ar << Section.ModuleClassName;
+	Ar << Section.ModuleVersion;
+	Ar << Section.Offset;
+	Ar << Section.Size;
+	Section.ModuleName = FName(ModuleName);
+	return Ar;
+}
+
+bool FModularSaveGameSection::IsIntact(const TArray<uint8>& InSaveData, int32 SaveGameFileVersion) const
+{
+	return (SaveGameFileVersion < MODULAR_SAVEGAME_FILE_VERSION_CHECKSUMS || (Offset >= 0 && Size >= 0 && Offset + Size <= InSaveData.Num() &&
+		Checksum == CalculateChecksum(InSaveData, Offset, Size)));
+}
+
+bool FModularSaveGameTableOfContents::TryRead(FMemoryReader& MemoryReader, int32 SaveGameFileVersion)
+{
+	Clear();
+
+	int32 NumModuleSections = 0;
+	MemoryReader << SaveGameSection;
+	MemoryReader << NumModuleSections;
+	if (MemoryReader.IsError() || NumModuleSections < 0)
+		return false;
+
+	// (i) The table of contents is read before the checksums are verified, so a corrupted count must not cause a huge allocation:
+	const int64 NumRemainingBytes = (MemoryReader.TotalSize() - MemoryReader.Tell());
+	if (NumModuleSections > NumRemainingBytes / FModularSaveGameSection::MinSerializedSize)
+		return false;
+
+	ModuleSections.SetNum(NumModuleSections);
+	for (FModularSaveGameSection& Section : ModuleSections)
+	{
+		MemoryReader << Section;
+	}
+
+	if (SaveGameFileVersion >= MODULAR_SAVEGAME_FILE_VERSION_NAME_TABLE)
+	{
+		MemoryReader << NameTableSection;
+	}
+
+	// (i) Checksums are stored after all sections, so that the section layout of older file versions stays the same:
+	if (SaveGameFileVersion >= MODULAR_SAVEGAME_FILE_VERSION_CHECKSUMS)
+	{
+		MemoryReader << SaveGameSection.Checksum;
+		for (FModularSaveGameSection& Section : ModuleSections)
+		{
+			MemoryReader << Section.Checksum;
+		}
+		MemoryReader << NameTableSection.Checksum;
+	}
+
+	// Check for corrupted section locations:
+	const int64 TotalSize = MemoryReader.TotalSize();
+	auto IsValidSection = [TotalSize](const FModularSaveGameSection& Section)
+	{
+		return (Section.Offset >= 0 && Section.Size >= 0 && Section.Offset + Section.Size <= TotalSize);
+	};
+	return (!MemoryReader.IsError() && IsValidSection(SaveGameSection) && IsValidSection(NameTableSection) && Algo::AllOf(ModuleSections, IsValidSection));
+}
+
+bool FModularSaveGameTableOfContents::TryWrite(FMemoryWriter& MemoryWriter)
+{
+	int32 NumModuleSections = ModuleSections.Num();
+	MemoryWriter << SaveGameSection;
+	MemoryWriter << NumModuleSections;
+	for (FModularSaveGameSection& Section : ModuleSections)
+	{
+		MemoryWriter << Section;
+	}
+	MemoryWriter << NameTableSection;
+
+	MemoryWriter << SaveGameSection.Checksum;
+	for (FModularSaveGameSection& Section : ModuleSections)
+	{
+		MemoryWriter << Section.Checksum;
+	}
+	MemoryWriter << NameTableSection.Checksum;
+	return !MemoryWriter.IsError();
+}
+
+void FModularSaveGameTableOfContents::Clear()
+{
+	SaveGameSection = {};
+	ModuleSections.Empty();
+	NameTableSection = {};
+}
+
+const FModularSaveGameSection* FModularSaveGameTableOfContents::FindModuleSection(const FName& ModuleName) const
+{
+	return ModuleSections.FindByPredicate([&ModuleName](const FModularSaveGameSection& Section)
+	{
+		return (Section.ModuleName == ModuleName);
+	});
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+
 void UModularSaveGame::ForEachModule(const TFunction<void(const FName&, USaveGameModule&)>& Function)
 {
 	for (const TPair<FName, TObjectPtr<USaveGameModule>>& Itr : Modules)
@@ -227,10 +484,213 @@ void UModularSaveGame::PostEditChangeProperty(FPropertyChangedEvent& PropertyCha
 ///////////////////////////////////////////////////////////////////////////////////////
 /// @UModularSaveGameSerializer
 
-bool UModularSaveGameSerializer::TrySerializeSaveGame(USaveGame& InSaveGameObject, TArray<uint8>& OutSaveData) const
+namespace
+{
+	bool TryReadNameTable(FMemoryReader& MemoryReader, int32 SaveGameFileVersion, const FModularSaveGameTableOfContents& TableOfContents, FWeekendUtilsSaveGameNameTable& OutNameTable)
+	{
+		OutNameTable.Empty();
+		if (TableOfContents.NameTableSection.Size <= 0)
+			return true;
+
+		MemoryReader.Seek(TableOfContents.NameTableSection.Offset);
+		OutNameTable.Serialize(MemoryReader, (SaveGameFileVersion >= MODULAR_SAVEGAME_FILE_VERSION_PRELOAD_PATHS));
+		return !MemoryReader.IsError();
+	}
+
+	struct FModularSaveGameDeserialization : FSaveGameDeserialization
+	{
+		FModularSaveGameHeader SaveHeader;
+		FModularSaveGameTableOfContents TableOfContents;
+		FWeekendUtilsSaveGameNameTable NameTable;
+		bool bHasNameTable = false;
+	};
+
+	/** Thread-safe: Parses everything except the custom header data, which is read together with the save game object. */
+	TSharedPtr<FSaveGameDeserialization> TryPrepareDeserialization(const TSharedRef<TArray<uint8>>& SaveData)
+	{
+		FMemoryReader MemoryReader(*SaveData, true);
+		MemoryReader.ArIsSaveGame = true;
+
+		// (i) Older file versions without sections are not prepared, but deserialized at once as before.
+		const TSharedRef<FModularSaveGameDeserialization> Deserialization = MakeShared<FModularSaveGameDeserialization>();
+		FModularSaveGameHeader& SaveHeader = Deserialization->SaveHeader;
+		if (!SaveHeader.TryRead(MemoryReader, true) || (SaveHeader.SaveGameFileVersion < MODULAR_SAVEGAME_FILE_VERSION_SECTIONS) ||
+			(SaveHeader.CompressionFormat != ESaveGameCompressionFormat::None))
+			return nullptr;
+
+		if (!Deserialization->TableOfContents.TryRead(MemoryReader, SaveHeader.SaveGameFileVersion))
+			return nullptr;
+
+		Deserialization->bHasNameTable = (SaveHeader.SaveGameFileVersion >= MODULAR_SAVEGAME_FILE_VERSION_NAME_TABLE);
+		if (Deserialization->bHasNameTable &&
+			!TryReadNameTable(MemoryReader, SaveHeader.SaveGameFileVersion, Deserialization->TableOfContents, OUT Deserialization->NameTable))
+			return nullptr;
+
+		if (SaveHeader.SaveGameFileVersion >= MODULAR_SAVEGAME_FILE_VERSION_PRELOAD_PATHS)
+		{
+			Deserialization->LoadablePaths = Deserialization->NameTable.GetLoadablePaths();
+		}
+		Deserialization->SaveData = SaveData;
+		return Deserialization;
+	}
+}
+
+USaveGameSerializer::FSaveDataEncoder UModularSaveGameSerializer::MakeSaveDataEncoder() const
+{
+	const USaveGameServiceSettings& Settings = *GetDefault<USaveGameServiceSettings>();
+	const ESaveGameCompressionFormat CompressionFormat = Settings.CompressionFormat;
+	if (CompressionFormat == ESaveGameCompressionFormat::None)
+		return nullptr;
+
+	if (!FCompression::IsFormatValid(GetCompressionFormatName(CompressionFormat)))
+	{
+		UE_LOG(LogModularSaveGame, Warning, TEXT("SaveGame compression format %s is not available, SaveGames are written uncompressed."),
+			*GetCompressionFormatName(CompressionFormat).ToString());
+		return nullptr;
+	}
+
+	const ECompressionFlags CompressionFlags = (Settings.CompressionLevel == ESaveGameCompressionLevel::Fast) ? COMPRESS_BiasSpeed
+		: (Settings.CompressionLevel == ESaveGameCompressionLevel::Small) ? COMPRESS_BiasSize
+		: COMPRESS_NoFlags;
+	return [CompressionFormat, CompressionFlags](TArray<uint8>& InOutSaveData)
+	{
+		return TryCompressSaveData(IN OUT InOutSaveData, CompressionFormat, CompressionFlags);
+	};
+}
+
+USaveGameSerializer::FSaveDataVerifier UModularSaveGameSerializer::MakeSaveDataVerifier() const
+{
+	return [](const TArray<uint8>& InSaveData)
+	{
+		return FModularSaveGameHeader::TryVerifyBodyChecksum(InSaveData);
+	};
+}
+
+USaveGameSerializer::FSaveDataDecoder UModularSaveGameSerializer::MakeSaveDataDecoder() const
+{
+	return [](TArray<uint8>& InOutSaveData)
+	{
+		TArray<uint8> DecompressedSaveData;
+		const TArray<uint8>* UncompressedSaveData = FindUncompressedSaveData(InOutSaveData, OUT DecompressedSaveData);
+		if (UncompressedSaveData == &DecompressedSaveData)
+		{
+			InOutSaveData = MoveTemp(DecompressedSaveData);
+		}
+		return (UncompressedSaveData != nullptr);
+	};
+}
+
+bool UModularSaveGameSerializer::TryCompressSaveData(TArray<uint8>& InOutSaveData, ESaveGameCompressionFormat CompressionFormat, ECompressionFlags CompressionFlags)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UModularSaveGameSerializer.TryCompressSaveData"), STAT_ModularSaveGameSerializer_TryCompressSaveData, STATGROUP_SaveGame);
+
+	int64 BodyOffset = 0;
+	ESaveGameCompressionFormat CurrentCompressionFormat = ESaveGameCompressionFormat::None;
+	if (!FModularSaveGameHeader::TryReadBodyInfo(InOutSaveData, OUT BodyOffset, OUT CurrentCompressionFormat) ||
+		BodyOffset == 0 || CurrentCompressionFormat != ESaveGameCompressionFormat::None)
+		return false;
+
+	// Keep the header uncompressed, so it can still be read from the beginning of the file alone:
+	TArray<uint8> CompressedSaveData;
+	CompressedSaveData.Reserve(InOutSaveData.Num());
+	CompressedSaveData.Append(InOutSaveData.GetData(), BodyOffset);
+	FMemoryWriter MemoryWriter(CompressedSaveData);
+	MemoryWriter.Seek(BodyOffset);
+
+	// Compress the rest in blocks of CompressionBlockSize, each prefixed by its uncompressed and compressed size:
+	const FName CompressionFormatName = GetCompressionFormatName(CompressionFormat);
+	int64 UncompressedBodySize = (InOutSaveData.Num() - BodyOffset);
+	MemoryWriter << UncompressedBodySize;
+	TArray<uint8> CompressedBlock;
+	for (int64 BlockOffset = BodyOffset; BlockOffset < InOutSaveData.Num(); BlockOffset += CompressionBlockSize)
+	{
+		int32 UncompressedBlockSize = static_cast<int32>(FMath::Min<int64>(CompressionBlockSize, InOutSaveData.Num() - BlockOffset));
+		int32 CompressedBlockSize = FCompression::CompressMemoryBound(CompressionFormatName, UncompressedBlockSize);
+		CompressedBlock.SetNumUninitialized(CompressedBlockSize, EAllowShrinking::No);
+		if (!FCompression::CompressMemory(CompressionFormatName, CompressedBlock.GetData(), IN OUT CompressedBlockSize,
+			InOutSaveData.GetData() + BlockOffset, UncompressedBlockSize, CompressionFlags))
+			return false;
+
+		MemoryWriter << UncompressedBlockSize;
+		MemoryWriter << CompressedBlockSize;
+		MemoryWriter.Serialize(CompressedBlock.GetData(), CompressedBlockSize);
+	}
+
+	if (MemoryWriter.IsError())
+		return false;
+
+	FModularSaveGameHeader::WriteCompressionFormat(IN OUT CompressedSaveData, CompressionFormat);
+	FModularSaveGameHeader::WriteBodyChecksum(IN OUT CompressedSaveData);
+	InOutSaveData = MoveTemp(CompressedSaveData);
+	return true;
+}
+
+bool UModularSaveGameSerializer::TryDecompressSaveData(const TArray<uint8>& InSaveData, TArray<uint8>& OutSaveData)
 {
-	const UModularSaveGame* ModularSaveGame = Cast<UModularSaveGame>(&InSaveGameObject);
-	FMemoryWriter MemoryWriter(OutSaveData, true);
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UModularSaveGameSerializer.TryDecompressSaveData"), STAT_ModularSaveGameSerializer_TryDecompressSaveData, STATGROUP_SaveGame);
+
+	OutSaveData.Reset();
+	int64 BodyOffset = 0;
+	ESaveGameCompressionFormat CompressionFormat = ESaveGameCompressionFormat::None;
+	if (!FModularSaveGameHeader::TryReadBodyInfo(InSaveData, OUT BodyOffset, OUT CompressionFormat) || CompressionFormat == ESaveGameCompressionFormat::None)
+		return false;
+
+	// Don't even try to decompress corrupted data:
+	if (!FModularSaveGameHeader::TryVerifyBodyChecksum(InSaveData))
+		return false;
+
+	const FName CompressionFormatName = GetCompressionFormatName(CompressionFormat);
+	if (!FCompression::IsFormatValid(CompressionFormatName))
+		return false;
+
+	FMemoryReader MemoryReader(InSaveData, true);
+	MemoryReader.Seek(BodyOffset);
+	int64 UncompressedBodySize = 0;
+	MemoryReader << UncompressedBodySize;
+	if (MemoryReader.IsError() || UncompressedBodySize < 0 || BodyOffset + UncompressedBodySize > MAX_int32)
+		return false;
+
+	// Restore the header as is, then decompress the following data block by block:
+	OutSaveData.SetNumUninitialized(BodyOffset + UncompressedBodySize);
+	FMemory::Memcpy(OutSaveData.GetData(), InSaveData.GetData(), BodyOffset);
+	for (int64 UncompressedOffset = BodyOffset; UncompressedOffset < OutSaveData.Num();)
+	{
+		int32 UncompressedBlockSize = 0;
+		int32 CompressedBlockSize = 0;
+		MemoryReader << UncompressedBlockSize;
+		MemoryReader << CompressedBlockSize;
+		const int64 CompressedOffset = MemoryReader.Tell();
+		if (MemoryReader.IsError() || UncompressedBlockSize <= 0 || CompressedBlockSize <= 0 ||
+			UncompressedOffset + UncompressedBlockSize > OutSaveData.Num() || CompressedOffset + CompressedBlockSize > InSaveData.Num())
+			return false;
+
+		if (!FCompression::UncompressMemory(CompressionFormatName, OutSaveData.GetData() + UncompressedOffset, UncompressedBlockSize,
+			InSaveData.GetData() + CompressedOffset, CompressedBlockSize))
+			return false;
+
+		MemoryReader.Seek(CompressedOffset + CompressedBlockSize);
+		UncompressedOffset += UncompressedBlockSize;
+	}
+
+	FModularSaveGameHeader::WriteCompressionFormat(IN OUT OutSaveData, ESaveGameCompressionFormat::None);
+	FModularSaveGameHeader::WriteBodyChecksum(IN OUT OutSaveData);
+	return true;
+}
+
+const TArray<uint8>* UModularSaveGameSerializer::FindUncompressedSaveData(const TArray<uint8>& InSaveData, TArray<uint8>& OutDecompressedStorage)
+{
+	int64 BodyOffset = 0;
+	ESaveGameCompressionFormat CompressionFormat = ESaveGameCompressionFormat::None;
+	if (!FModularSaveGameHeader::TryReadBodyInfo(InSaveData, OUT BodyOffset, OUT CompressionFormat) || CompressionFormat == ESaveGameCompressionFormat::None)
+		return &InSaveData; // (i) Invalid data is passed through as well, so it fails where it is actually read.
+
+	return (TryDecompressSaveData(InSaveData, OUT OutDecompressedStorage) ? &OutDecompressedStorage : nullptr);
+}
+
+bool UModularSaveGameSerializer::TryCaptureSaveGameSnapshot(USaveGame& InSaveGameObject, TArray<uint8>& OutSnapshotData) const
+{
+	UModularSaveGame* ModularSaveGame = Cast<UModularSaveGame>(&InSaveGameObject);
+	FMemoryWriter MemoryWriter(OutSnapshotData, true);
 	MemoryWriter.ArIsSaveGame = true;
 	MemoryWriter.ArNoDelta = true;
 	MemoryWriter.ArNoIntraPropertyDelta = true;
@@ -243,10 +703,74 @@ bool UModularSaveGameSerializer::TrySerializeSaveGame(USaveGame& InSaveGameObjec
 	if (!SaveHeader.TryWrite(MemoryWriter))
 		return false;
 
-	// Serialize the save game object and all supported properties:
-	FWeekendUtilsSubobjectProxyArchive Archive(MemoryWriter, InSaveGameObject);
+	// Serialize the table of contents with placeholder locations, which are updated after all sections were written:
+	TArray<TPair<FName, USaveGameModule*>> ModulesToSerialize;
+	FModularSaveGameTableOfContents TableOfContents;
+	if (ModularSaveGame)
+	{
+		ModularSaveGame->ForEachModule([&](const FName& ModuleName, USaveGameModule& Module)
+		{
+			ModulesToSerialize.Emplace(ModuleName, &Module);
+			TableOfContents.ModuleSections.Add({ModuleName, Module.GetClass()->GetPathName()});
+		});
+	}
+	const int64 TableOfContentsOffset = MemoryWriter.Tell();
+	if (!TableOfContents.TryWrite(MemoryWriter))
+		return false;
+
+	// Serialize the save game object and all supported properties, except for the modules:
+	TMap<FName, TObjectPtr<USaveGameModule>> TemporarilyRemovedModules;
+	if (ModularSaveGame)
+	{
+		Swap(TemporarilyRemovedModules, ModularSaveGame->Modules);
+	}
+	FWeekendUtilsSaveGameNameTable NameTable;
+	TableOfContents.SaveGameSection.Offset = MemoryWriter.Tell();
+	FWeekendUtilsSubobjectProxyArchive Archive(MemoryWriter, InSaveGameObject, &NameTable);
 	InSaveGameObject.Serialize(Archive);
+	TableOfContents.SaveGameSection.Size = (MemoryWriter.Tell() - TableOfContents.SaveGameSection.Offset);
+	if (ModularSaveGame)
+	{
+		Swap(TemporarilyRemovedModules, ModularSaveGame->Modules);
+	}
+
+	// Serialize each module into its own section:
+	for (int32 i = 0; i < ModulesToSerialize.Num(); ++i)
+	{
+		USaveGameModule& Module = *ModulesToSerialize[i].Value;
+		FModularSaveGameSection& Section = TableOfContents.ModuleSections[i];
+		Section.Offset = MemoryWriter.Tell();
+		FWeekendUtilsNameTableProxyArchive ModuleArchive(MemoryWriter, &NameTable);
+		Module.Serialize(ModuleArchive);
+		Section.Size = (MemoryWriter.Tell() - Section.Offset);
+		Section.ModuleVersion = Module.ModuleVersion; // (i) Read after serialization, since modules may update it in PreSaveModule().
+	}
+
+	// Serialize all names and object paths that were referenced by the sections above:
+	TableOfContents.NameTableSection.Offset = MemoryWriter.Tell();
+	MemoryWriter << NameTable;
+	TableOfContents.NameTableSection.Size = (MemoryWriter.Tell() - TableOfContents.NameTableSection.Offset);
+
+	// Checksum each section, so that single sections can be verified when they are read on their own:
+	auto UpdateChecksum = [&OutSnapshotData](FModularSaveGameSection& Section)
+	{
+		Section.Checksum = CalculateChecksum(OutSnapshotData, Section.Offset, Section.Size);
+	};
+	UpdateChecksum(TableOfContents.SaveGameSection);
+	Algo::ForEach(TableOfContents.ModuleSections, UpdateChecksum);
+	UpdateChecksum(TableOfContents.NameTableSection);
+
+	// Update the table of contents with the actual section locations:
+	const int64 EndOffset = MemoryWriter.Tell();
+	MemoryWriter.Seek(TableOfContentsOffset);
+	if (!TableOfContents.TryWrite(MemoryWriter))
+		return false;
+
+	MemoryWriter.Seek(EndOffset);
+	if (MemoryWriter.IsError())
+		return false;
 
+	FModularSaveGameHeader::WriteBodyChecksum(IN OUT OutSnapshotData);
 	return true;
 }
 
@@ -256,7 +780,12 @@ bool UModularSaveGameSerializer::TryDeserializeSaveGame(const TArray<uint8>& InS
 	if (InSaveData.IsEmpty())
 		return false;
 
-	FMemoryReader MemoryReader(InSaveData, true);
+	TArray<uint8> DecompressedSaveData;
+	const TArray<uint8>* SaveData = FindUncompressedSaveData(InSaveData, OUT DecompressedSaveData);
+	if (!SaveData)
+		return false;
+
+	FMemoryReader MemoryReader(*SaveData, true);
 	MemoryReader.ArIsSaveGame = true;
 
 	// Restore header data:
@@ -264,25 +793,243 @@ bool UModularSaveGameSerializer::TryDeserializeSaveGame(const TArray<uint8>& InS
 	if (!SaveHeader.TryRead(MemoryReader))
 		return false;
 
-	// Restore the save game class info:
-	const UClass* SaveGameClass = UClass::TryFindTypeSlow<UClass>(SaveHeader.SaveGameClassName);
-	if (!SaveGameClass)
-	{
-		SaveGameClass = LoadObject<UClass>(nullptr, *SaveHeader.SaveGameClassName);
-	}
+	FModularSaveGameTableOfContents TableOfContents;
+	const bool bHasSections = (SaveHeader.SaveGameFileVersion >= MODULAR_SAVEGAME_FILE_VERSION_SECTIONS);
+	if (bHasSections && !TableOfContents.TryRead(MemoryReader, SaveHeader.SaveGameFileVersion))
+		return false;
+
+	// Older file versions don't have a name table and contain plain strings instead:
+	FWeekendUtilsSaveGameNameTable NameTable;
+	const bool bHasNameTable = (SaveHeader.SaveGameFileVersion >= MODULAR_SAVEGAME_FILE_VERSION_NAME_TABLE);
+	if (bHasNameTable && !TryReadNameTable(MemoryReader, SaveHeader.SaveGameFileVersion, TableOfContents, OUT NameTable))
+		return false;
 
+	// Restore the save game class info:
+	FWeekendUtilsResolvedObjectCache ResolvedObjectCache;
+	const UClass* SaveGameClass = ResolvedObjectCache.FindOrLoadClass(SaveHeader.SaveGameClassName, true);
 	if (!SaveGameClass)
 		return false;
 
 	// Create (empty) save game object and then restore all of its saved properties:
 	OutSaveGameObject = NewObject<USaveGame>(GetOuter(), SaveGameClass);
-	FWeekendUtilsSubobjectProxyArchive Archive(MemoryReader, *OutSaveGameObject);
+	if (bHasSections)
+	{
+		MemoryReader.Seek(TableOfContents.SaveGameSection.Offset);
+	}
+	FWeekendUtilsSubobjectProxyArchive Archive(MemoryReader, *OutSaveGameObject, (bHasNameTable ? &NameTable : nullptr));
+	Archive.ResolvedObjectCache = &ResolvedObjectCache;
 	OutSaveGameObject->Serialize(Archive);
 
-	if (UModularSaveGame* ModularSaveGame = Cast<UModularSaveGame>(OutSaveGameObject))
+	UModularSaveGame* ModularSaveGame = Cast<UModularSaveGame>(OutSaveGameObject);
+	if (!ModularSaveGame)
+		return true;
+
+	ModularSaveGame->SetInstancedHeaderData(SaveHeader.CustomHeaderData);
+
+	// Restore modules from their sections (older file versions serialized them together with the save game object):
+	for (const FModularSaveGameSection& Section : TableOfContents.ModuleSections)
+	{
+		if (USaveGameModule* Module = DeserializeModuleSection(MemoryReader, Section, *ModularSaveGame, (bHasNameTable ? &NameTable : nullptr), ResolvedObjectCache))
+		{
+			ModularSaveGame->Modules.Add(Section.ModuleName, Module);
+		}
+	}
+
+	return true;
+}
+
+USaveGameSerializer::FSaveDataPreparer UModularSaveGameSerializer::MakeSaveDataPreparer() const
+{
+	return [](const TSharedRef<TArray<uint8>>& SaveData)
+	{
+		return TryPrepareDeserialization(SaveData);
+	};
+}
+
+bool UModularSaveGameSerializer::TryDeserializeSaveGameStep(FSaveGameDeserialization& InOutDeserialization) const
+{
+	FModularSaveGameDeserialization& Deserialization = static_cast<FModularSaveGameDeserialization&>(InOutDeserialization);
+	if (Deserialization.bIsComplete || !Deserialization.SaveData.IsValid())
+		return false;
+
+	FMemoryReader MemoryReader(*Deserialization.SaveData, true);
+	MemoryReader.ArIsSaveGame = true;
+	Deserialization.SaveHeader.ApplyVersions(MemoryReader);
+	FWeekendUtilsSaveGameNameTable* NameTable = (Deserialization.bHasNameTable ? &Deserialization.NameTable : nullptr);
+	const TArray<FModularSaveGameSection>& ModuleSections = Deserialization.TableOfContents.ModuleSections;
+
+	// First step: Create (empty) save game object and then restore all of its saved properties:
+	if (Deserialization.NumStepsDone == 0)
 	{
-		ModularSaveGame->SetInstancedHeaderData(SaveHeader.CustomHeaderData);
+		const UClass* SaveGameClass = Deserialization.ResolvedObjectCache.FindOrLoadClass(Deserialization.SaveHeader.SaveGameClassName, true);
+		if (!SaveGameClass)
+			return false;
+
+		USaveGame* SaveGameObject = NewObject<USaveGame>(GetOuter(), SaveGameClass);
+		Deserialization.SaveGameObject.Reset(SaveGameObject);
+		MemoryReader.Seek(Deserialization.TableOfContents.SaveGameSection.Offset);
+		FWeekendUtilsSubobjectProxyArchive Archive(MemoryReader, *SaveGameObject, NameTable);
+		Archive.ResolvedObjectCache = &Deserialization.ResolvedObjectCache;
+		SaveGameObject->Serialize(Archive);
+
+		// (i) Custom header data is read here on the game thread, because it has to resolve its struct type.
+		UModularSaveGame* ModularSaveGame = Cast<UModularSaveGame>(SaveGameObject);
+		if (ModularSaveGame && Deserialization.SaveHeader.TryReadCustomHeaderData(MemoryReader))
+		{
+			ModularSaveGame->SetInstancedHeaderData(Deserialization.SaveHeader.CustomHeaderData);
+		}
+		Deserialization.NumStepsDone = 1;
+		Deserialization.bIsComplete = (!ModularSaveGame || ModuleSections.IsEmpty());
+		return true;
 	}
 
+	// Following steps: Restore one module from its section each:
+	UModularSaveGame* ModularSaveGame = Cast<UModularSaveGame>(Deserialization.SaveGameObject.Get());
+	const int32 SectionIndex = (Deserialization.NumStepsDone - 1);
+	if (!ModularSaveGame || !ModuleSections.IsValidIndex(SectionIndex))
+		return false;
+
+	const FModularSaveGameSection& Section = ModuleSections[SectionIndex];
+	if (USaveGameModule* Module = DeserializeModuleSection(MemoryReader, Section, *ModularSaveGame, NameTable, Deserialization.ResolvedObjectCache))
+	{
+		ModularSaveGame->Modules.Add(Section.ModuleName, Module);
+	}
+	Deserialization.NumStepsDone++;
+	Deserialization.bIsComplete = (SectionIndex == ModuleSections.Num() - 1);
 	return true;
 }
+
+bool UModularSaveGameSerializer::TryDeserializeHeaderData(const TArray<uint8>& InSaveData, FInstancedStruct& OutHeaderData) const
+{
+	FMemoryReader MemoryReader(InSaveData, true);
+	MemoryReader.ArIsSaveGame = true;
+
+	FModularSaveGameHeader SaveHeader;
+	if (!SaveHeader.TryRead(MemoryReader) || !SaveHeader.CustomHeaderData.IsValid())
+		return false;
+
+	OutHeaderData = MoveTemp(SaveHeader.CustomHeaderData);
+	return true;
+}
+
+void UModularSaveGameSerializer::GatherPathsToPreload(const TArray<uint8>& InSaveData, TArray<FSoftObjectPath>& OutPaths) const
+{
+	TArray<uint8> DecompressedSaveData;
+	const TArray<uint8>* SaveData = FindUncompressedSaveData(InSaveData, OUT DecompressedSaveData);
+	FModularSaveGameHeader SaveHeader;
+	FModularSaveGameTableOfContents TableOfContents;
+	if (!SaveData || !TryReadTableOfContents(*SaveData, OUT SaveHeader, OUT TableOfContents))
+		return;
+
+	// (i) Only file versions that mark their loadable paths can be preloaded, older ones are loaded synchronously as before.
+	if (SaveHeader.SaveGameFileVersion < MODULAR_SAVEGAME_FILE_VERSION_PRELOAD_PATHS)
+		return;
+
+	FMemoryReader MemoryReader(*SaveData, true);
+	MemoryReader.ArIsSaveGame = true;
+	FWeekendUtilsSaveGameNameTable NameTable;
+	if (!TryReadNameTable(MemoryReader, SaveHeader.SaveGameFileVersion, TableOfContents, OUT NameTable))
+		return;
+
+	for (const FSoftObjectPath& Path : NameTable.GetLoadablePaths())
+	{
+		if (Path.IsValid() && !Path.ResolveObject())
+		{
+			OutPaths.Add(Path);
+		}
+	}
+}
+
+bool UModularSaveGameSerializer::TryReadTableOfContents(const TArray<uint8>& InSaveData, FModularSaveGameHeader& OutHeader, FModularSaveGameTableOfContents& OutTableOfContents) const
+{
+	OutTableOfContents.Clear();
+	TArray<uint8> DecompressedSaveData;
+	const TArray<uint8>* SaveData = FindUncompressedSaveData(InSaveData, OUT DecompressedSaveData);
+	if (!SaveData)
+		return false;
+
+	FMemoryReader MemoryReader(*SaveData, true);
+	MemoryReader.ArIsSaveGame = true;
+
+	if (!OutHeader.TryRead(MemoryReader))
+		return false;
+
+	if (OutHeader.SaveGameFileVersion < MODULAR_SAVEGAME_FILE_VERSION_SECTIONS)
+		return false;
+
+	return OutTableOfContents.TryRead(MemoryReader, OutHeader.SaveGameFileVersion);
+}
+
+bool UModularSaveGameSerializer::TryDeserializeModule(const TArray<uint8>& InSaveData, const FName& ModuleName, UObject& Outer, USaveGameModule*& OutModule) const
+{
+	OutModule = nullptr;
+	TArray<uint8> DecompressedSaveData;
+	const TArray<uint8>* SaveData = FindUncompressedSaveData(InSaveData, OUT DecompressedSaveData);
+	if (!SaveData)
+		return false;
+
+	FMemoryReader MemoryReader(*SaveData, true);
+	MemoryReader.ArIsSaveGame = true;
+
+	FModularSaveGameHeader SaveHeader;
+	if (!SaveHeader.TryRead(MemoryReader))
+		return false;
+
+	if (SaveHeader.SaveGameFileVersion < MODULAR_SAVEGAME_FILE_VERSION_SECTIONS)
+	{
+		// Fallback for older file versions: Deserialize everything and then extract the module.
+		USaveGame* SaveGame = nullptr;
+		UModularSaveGame* ModularSaveGame = (TryDeserializeSaveGame(InSaveData, OUT SaveGame) ? Cast<UModularSaveGame>(SaveGame) : nullptr);
+		OutModule = (ModularSaveGame ? ModularSaveGame->Modules.FindRef(ModuleName).Get() : nullptr);
+		if (OutModule)
+		{
+			OutModule->Rename(nullptr, &Outer, REN_DontCreateRedirectors | REN_DoNotDirty);
+		}
+		return (OutModule != nullptr);
+	}
+
+	FModularSaveGameTableOfContents TableOfContents;
+	if (!TableOfContents.TryRead(MemoryReader, SaveHeader.SaveGameFileVersion))
+		return false;
+
+	const FModularSaveGameSection* Section = TableOfContents.FindModuleSection(ModuleName);
+	if (!Section)
+		return false;
+
+	// Only verify the sections that are actually read, instead of the whole data:
+	FWeekendUtilsSaveGameNameTable NameTable;
+	const bool bHasNameTable = (SaveHeader.SaveGameFileVersion >= MODULAR_SAVEGAME_FILE_VERSION_NAME_TABLE);
+	if (!Section->IsIntact(*SaveData, SaveHeader.SaveGameFileVersion) ||
+		(bHasNameTable && !TableOfContents.NameTableSection.IsIntact(*SaveData, SaveHeader.SaveGameFileVersion)))
+	{
+		UE_LOG(LogModularSaveGame, Warning, TEXT("SaveGame module %s can't be read, because its save data is corrupted."), *ModuleName.ToString());
+		return false;
+	}
+	if (bHasNameTable && !TryReadNameTable(MemoryReader, SaveHeader.SaveGameFileVersion, TableOfContents, OUT NameTable))
+		return false;
+
+	FWeekendUtilsResolvedObjectCache ResolvedObjectCache;
+	OutModule = DeserializeModuleSection(MemoryReader, *Section, Outer, (bHasNameTable ? &NameTable : nullptr), ResolvedObjectCache);
+	return (OutModule != nullptr);
+}
+
+USaveGameModule* UModularSaveGameSerializer::DeserializeModuleSection(FMemoryReader& MemoryReader, const FModularSaveGameSection& Section, UObject& Outer,
+	FWeekendUtilsSaveGameNameTable* NameTable, FWeekendUtilsResolvedObjectCache& ResolvedObjectCache) const
+{
+	const UClass* ModuleClass = ResolvedObjectCache.FindOrLoadClass(Section.ModuleClassName, true);
+	if (!ModuleClass || !ModuleClass->IsChildOf<USaveGameModule>())
+		return nullptr;
+
+	USaveGameModule* Module = NewObject<USaveGameModule>(&Outer, ModuleClass);
+	MemoryReader.Seek(Section.Offset);
+	FWeekendUtilsNameTableProxyArchive Archive(MemoryReader, NameTable);
+	Archive.ResolvedObjectCache = &ResolvedObjectCache;
+	Module->Serialize(Archive);
+
+	if (MemoryReader.Tell() != Section.Offset + Section.Size)
+	{
+		UE_LOG(LogModularSaveGame, Warning, TEXT("SaveGame module %s did not consume its section exactly (%lld of %lld bytes)."),
+			*Section.ModuleName.ToString(), MemoryReader.Tell() - Section.Offset, Section.Size);
+	}
+	return Module;
+}
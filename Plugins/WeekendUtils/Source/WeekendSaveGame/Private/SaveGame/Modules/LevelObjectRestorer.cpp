@@ -9,17 +9,30 @@
 
 #include "SaveGame/Modules/LevelObjectRestorer.h"
 
+#include "Algo/Sort.h"
 #include "Engine/Level.h"
 #include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Hash/CityHash.h"
 #include "Logging/MessageLog.h"
+#include "Misc/Compression.h"
+#include "Misc/Crc.h"
 #include "Misc/UObjectToken.h"
 #include "SaveGame/SaveGameUtils.h"
 #include "Serialization/MemoryReader.h"
 #include "Serialization/MemoryWriter.h"
 #include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "UObject/UnrealType.h"
+#include "WeekendSaveGame.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogLevelObjectRestorer, Log, All);
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("LevelObjectRestorer.ReusedObjectStates"), STAT_LevelObjectRestorer_ReusedObjectStates, STATGROUP_SaveGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LevelObjectRestorer.SerializedObjectStates"), STAT_LevelObjectRestorer_SerializedObjectStates, STATGROUP_SaveGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LevelObjectRestorer.PackedObjectStates"), STAT_LevelObjectRestorer_PackedObjectStates, STATGROUP_SaveGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LevelObjectRestorer.PendingRegistrations"), STAT_LevelObjectRestorer_PendingRegistrations, STATGROUP_SaveGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LevelObjectRestorer.PendingRestores"), STAT_LevelObjectRestorer_PendingRestores, STATGROUP_SaveGame);
+
 namespace
 {
 	void CheckLevelObject(const UObject& Object)
@@ -33,147 +46,330 @@ namespace
 		checkf(!Object.HasAnyFlags(RF_Standalone | RF_Transient),
 			TEXT("ULevelObjectRestorer: Persistent objects are not supported: %s"), *GetNameSafe(&Object));
 	}
-}
-
-void ULevelObjectRestorer::RegisterLevelObject(UObject& Object, TOptional<FString> CustomUniqueObjectId, bool bImmediatelyRestoreIfPossible)
-{
-	CheckLevelObject(Object);
-	const TWeakObjectPtr<> ObjectPtr = MakeWeakObjectPtr(&Object);
-	ensureMsgf(!SimpleRegisteredObjects.Contains(ObjectPtr), TEXT("%s is already registered"), *Object.GetName());
-	SimpleRegisteredObjects.Add(ObjectPtr);
 
-	const FString ObjectId = CustomUniqueObjectId.Get(MakeSafeUniqueObjectId(Object));
-	UniqueIdsOfRegisteredObjects.Add(ObjectPtr, ObjectId);
-	ClaimedUniqueObjectIds.Add(ObjectId);
+	void SerializeObjectStateKey(FArchive& Ar, FLevelObjectStateKey& Key)
+	{
+		Ar << Key.PrefixIndex;
+		Ar << Key.PathHash;
+	}
 
-	if (bImmediatelyRestoreIfPossible && ObjectStates.Contains(ObjectId))
+	void SerializeObjectState(FArchive& Ar, FLevelObjectStateKey& Key, FLevelObjectSaveGameState& State, bool bWithPartitionIndex)
 	{
-		FLevelObjectSaveGameState& State = ObjectStates[ObjectId];
-		State.bUsesCustomUniqueObjectId = CustomUniqueObjectId.IsSet();
-		RestoreObjectFromState(State, false, IN OUT Object);
-		UE_LOG(LogLevelObjectRestorer, VeryVerbose, TEXT("Registered LevelObject \"%s\" restored an existing state for ObjectId: \"%s\""), *Object.GetName(), *ObjectId)
+		SerializeObjectStateKey(Ar, Key);
+		Ar << State.ObjectIdChecksum;
+		if (bWithPartitionIndex)
+		{
+			Ar << State.PartitionIndex;
+		}
+		Ar << State.ByteData;
+		Ar << State.bUsesCustomUniqueObjectId;
+		State.ByteDataSize = FMath::Min(State.ByteData.Num(), INT32_MAX);
 	}
-	else
+
+	/** @returns how many object states fit into the rest of the archive at most, which bounds counts read from (possibly corrupt) data. */
+	int32 GetMaxNumObjectStatesLeftInArchive(FArchive& Ar, bool bWithPartitionIndex)
 	{
-		FLevelObjectSaveGameState& State = ObjectStates.FindOrAdd(ObjectId);
-		State.bUsesCustomUniqueObjectId = CustomUniqueObjectId.IsSet();
-		SaveObjectToState(Object, false, IN OUT State);
-		UE_LOG(LogLevelObjectRestorer, VeryVerbose, TEXT("Registered LevelObject \"%s\" did NOT restore an existing state for ObjectId: \"%s\""), *Object.GetName(), *ObjectId)
+		// (i) Even a state without byte data consists of its key, checksum, partition index, byte data count and custom id flag:
+		constexpr int64 MinObjectStateSize = sizeof(int32) + sizeof(uint64) + sizeof(uint32) + sizeof(int32) + sizeof(uint32);
+		constexpr int64 MinObjectStateSizeWithoutPartition = MinObjectStateSize - sizeof(int32);
+		const int64 TotalSize = Ar.TotalSize();
+		if (TotalSize < 0)
+			return 0;
+
+		const int64 NumBytesLeft = FMath::Max<int64>(TotalSize - Ar.Tell(), 0);
+		return static_cast<int32>(FMath::Min<int64>(NumBytesLeft / (bWithPartitionIndex ? MinObjectStateSize : MinObjectStateSizeWithoutPartition), MAX_int32));
 	}
-}
 
-void ULevelObjectRestorer::RegisterLevelObjectWithTransform(AActor& Actor, TOptional<FString> CustomUniqueObjectId, bool bImmediatelyRestoreIfPossible)
-{
-	CheckLevelObject(Actor);
-	const TWeakObjectPtr<> ObjectPtr = MakeWeakObjectPtr(&Actor);
-	ensureMsgf(!RegisteredObjectsWithTransform.Contains(ObjectPtr), TEXT("%s is already registered"), *Actor.GetName());
-	RegisteredObjectsWithTransform.Add(ObjectPtr);
+	bool TryRemapPrefixIndex(FLevelObjectStateKey& Key, const TArray<int32>& PrefixIndexRemap)
+	{
+		if (!PrefixIndexRemap.IsValidIndex(Key.PrefixIndex))
+			return false;
 
-	const FString ObjectId = CustomUniqueObjectId.Get(MakeSafeUniqueObjectId(Actor));
-	UniqueIdsOfRegisteredObjects.Add(ObjectPtr, ObjectId);
-	ClaimedUniqueObjectIds.Add(ObjectId);
+		Key.PrefixIndex = PrefixIndexRemap[Key.PrefixIndex];
+		return true;
+	}
 
-	if (bImmediatelyRestoreIfPossible && ObjectStates.Contains(ObjectId))
+	int32 RemapPartitionIndex(int32 PartitionIndex, const TArray<int32>& PartitionIndexRemap)
 	{
-		ObjectStates[ObjectId].bUsesCustomUniqueObjectId = CustomUniqueObjectId.IsSet();
-		RestoreObjectFromState(ObjectStates[ObjectId], true, IN OUT Actor);
-		UE_LOG(LogLevelObjectRestorer, VeryVerbose, TEXT("Registered LevelObject \"%s\" restored an existing state for ObjectId: \"%s\""), *Actor.GetName(), *ObjectId)
+		return PartitionIndexRemap.IsValidIndex(PartitionIndex) ? PartitionIndexRemap[PartitionIndex] : INDEX_NONE;
 	}
-	else
+
+	void SerializePackedLevelPartitions(FArchive& Ar, TMap<int32, FLevelObjectStatePartition>& Partitions)
 	{
-		FLevelObjectSaveGameState& State = ObjectStates.FindOrAdd(ObjectId);
-		State.bUsesCustomUniqueObjectId = CustomUniqueObjectId.IsSet();
-		SaveObjectToState(Actor, true, IN OUT State);
-		UE_LOG(LogLevelObjectRestorer, VeryVerbose, TEXT("Registered LevelObject \"%s\" did NOT restore an existing state for ObjectId: \"%s\""), *Actor.GetName(), *ObjectId)
+		int32 NumPartitions = Partitions.Num();
+		Ar << NumPartitions;
+		if (Ar.IsSaving())
+		{
+			for (TPair<int32, FLevelObjectStatePartition>& Partition : Partitions)
+			{
+				int32 PartitionIndex = Partition.Key;
+				uint8 CompressionFormat = static_cast<uint8>(Partition.Value.CompressionFormat);
+				Ar << PartitionIndex;
+				Ar << CompressionFormat;
+				Ar << Partition.Value.NumObjectStates;
+				Ar << Partition.Value.UncompressedSize;
+				Ar << Partition.Value.CompressedData;
+			}
+			return;
+		}
+
+		Partitions.Reset();
+		for (int32 i = 0; i < NumPartitions && !Ar.IsError(); ++i)
+		{
+			int32 PartitionIndex = INDEX_NONE;
+			uint8 CompressionFormat = 0;
+			FLevelObjectStatePartition Partition;
+			Ar << PartitionIndex;
+			Ar << CompressionFormat;
+			Ar << Partition.NumObjectStates;
+			Ar << Partition.UncompressedSize;
+			Ar << Partition.CompressedData;
+			Partition.CompressionFormat = static_cast<ESaveGameCompressionFormat>(CompressionFormat);
+			Partitions.Add(PartitionIndex, MoveTemp(Partition));
+		}
 	}
-}
 
-void ULevelObjectRestorer::RegisterLevelObjectWithTransform(USceneComponent& SceneComponent, TOptional<FString> CustomUniqueObjectId, bool bImmediatelyRestoreIfPossible)
-{
-	CheckLevelObject(SceneComponent);
-	const TWeakObjectPtr<> ObjectPtr = MakeWeakObjectPtr(&SceneComponent);
-	ensureMsgf(!RegisteredObjectsWithTransform.Contains(ObjectPtr), TEXT("%s is already registered"), *SceneComponent.GetName());
-	RegisteredObjectsWithTransform.Add(ObjectPtr);
+	/** Shared by the interned ObjectId prefixes and level partition names. */
+	int32 FindInternedString(const FString& String, const TArray<FString>& Strings, TMap<FString, int32>& InOutIndices)
+	{
+		if (InOutIndices.Num() != Strings.Num())
+		{
+			InOutIndices.Reset();
+			for (int32 i = 0; i < Strings.Num(); ++i)
+			{
+				InOutIndices.Add(Strings[i], i);
+			}
+		}
 
-	const FString ObjectId = CustomUniqueObjectId.Get(MakeSafeUniqueObjectId(SceneComponent));
-	UniqueIdsOfRegisteredObjects.Add(ObjectPtr, ObjectId);
-	ClaimedUniqueObjectIds.Add(ObjectId);
+		const int32* ExistingIndex = InOutIndices.Find(String);
+		return ExistingIndex ? *ExistingIndex : INDEX_NONE;
+	}
 
-	if (bImmediatelyRestoreIfPossible && ObjectStates.Contains(ObjectId))
+	int32 FindOrAddInternedString(const FString& String, TArray<FString>& InOutStrings, TMap<FString, int32>& InOutIndices)
 	{
-		ObjectStates[ObjectId].bUsesCustomUniqueObjectId = CustomUniqueObjectId.IsSet();
-		RestoreObjectFromState(ObjectStates[ObjectId], true, IN OUT SceneComponent);
-		UE_LOG(LogLevelObjectRestorer, VeryVerbose, TEXT("Registered LevelObject \"%s\" restored an existing state for ObjectId: \"%s\""), *SceneComponent.GetName(), *ObjectId)
+		const int32 ExistingIndex = FindInternedString(String, InOutStrings, InOutIndices);
+		if (ExistingIndex != INDEX_NONE)
+			return ExistingIndex;
+
+		const int32 NewIndex = InOutStrings.Add(String);
+		InOutIndices.Add(String, NewIndex);
+		return NewIndex;
 	}
-	else
+
+	/**
+	 * Upper bounds of the restored UncompressedSize of packed partitions, which is allocated before decompressing them.
+	 * None of the supported compression formats reaches this ratio for serialized object states.
+	 */
+	constexpr int64 MaxPackedPartitionCompressionRatio = 1024;
+	constexpr int64 MaxPackedPartitionUncompressedSize = 256 * 1024 * 1024;
+
+	bool IsPlausibleUncompressedSize(const FLevelObjectStatePartition& Partition)
 	{
-		FLevelObjectSaveGameState& State = ObjectStates.FindOrAdd(ObjectId);
-		State.bUsesCustomUniqueObjectId = CustomUniqueObjectId.IsSet();
-		SaveObjectToState(SceneComponent, true, IN OUT State);
-		UE_LOG(LogLevelObjectRestorer, VeryVerbose, TEXT("Registered LevelObject \"%s\" did NOT restore an existing state for ObjectId: \"%s\""), *SceneComponent.GetName(), *ObjectId)
+		const int64 MaxUncompressedSize = FMath::Min(Partition.CompressedData.Num() * MaxPackedPartitionCompressionRatio, MaxPackedPartitionUncompressedSize);
+		return (Partition.UncompressedSize >= 0 && Partition.UncompressedSize <= MaxUncompressedSize);
+	}
+
+	FString MakeLevelPartitionName(const ULevel& Level)
+	{
+		// (i) Without PIE prefix for the same reason as in ULevelObjectRestorer::MakeSafeUniqueObjectId().
+		return UWorld::RemovePIEPrefix(Level.GetOutermost()->GetName());
 	}
 }
 
-void ULevelObjectRestorer::UnregisterLevelObject(UObject& Object, TOptional<FString> CustomUniqueObjectId, bool bKeepObjectState)
+void ULevelObjectRestorer::RegisterLevelObject(UObject& Object, TOptional<FString> CustomUniqueObjectId, bool bImmediatelyRestoreIfPossible)
+{
+	RegisterObjectState(Object, false, CustomUniqueObjectId, bImmediatelyRestoreIfPossible);
+}
+
+void ULevelObjectRestorer::RegisterLevelObjectWithTransform(AActor& Actor, TOptional<FString> CustomUniqueObjectId, bool bImmediatelyRestoreIfPossible)
+{
+	RegisterObjectState(Actor, true, CustomUniqueObjectId, bImmediatelyRestoreIfPossible);
+}
+
+void ULevelObjectRestorer::RegisterLevelObjectWithTransform(USceneComponent& SceneComponent, TOptional<FString> CustomUniqueObjectId, bool bImmediatelyRestoreIfPossible)
+{
+	RegisterObjectState(SceneComponent, true, CustomUniqueObjectId, bImmediatelyRestoreIfPossible);
+}
+
+void ULevelObjectRestorer::RegisterObjectState(UObject& Object, bool bWithTransform, const TOptional<FString>& CustomUniqueObjectId, bool bImmediatelyRestoreIfPossible)
 {
 	CheckLevelObject(Object);
 	const TWeakObjectPtr<> ObjectPtr = MakeWeakObjectPtr(&Object);
-	ensureMsgf(SimpleRegisteredObjects.Contains(ObjectPtr), TEXT("%s is not registered"), *Object.GetName());
-	SimpleRegisteredObjects.Remove(ObjectPtr);
-	UniqueIdsOfRegisteredObjects.Remove(ObjectPtr);
+	TSet<TWeakObjectPtr<UObject>>& RegisteredObjects = (bWithTransform ? RegisteredObjectsWithTransform : SimpleRegisteredObjects);
+	ensureMsgf(!RegisteredObjects.Contains(ObjectPtr), TEXT("%s is already registered"), *Object.GetName());
+	RegisteredObjects.Add(ObjectPtr);
 
 	const FString ObjectId = CustomUniqueObjectId.Get(MakeSafeUniqueObjectId(Object));
-	if (bKeepObjectState)
+	uint32 ObjectIdChecksum = 0;
+	const FLevelObjectStateKey ObjectKey = MakeObjectStateKey(ObjectId, OUT ObjectIdChecksum);
+	KeysOfRegisteredObjects.Add(ObjectPtr, ObjectKey);
+	ClaimedObjectStateKeys.Add(ObjectKey);
+	const int32 PartitionIndex = FindOrAddLevelPartition(*Object.GetTypedOuter<ULevel>());
+	UnpackLevelPartition(PartitionIndex);
+
+	FLevelObjectSaveGameState* ExistingState = FindObjectState(ObjectKey, ObjectIdChecksum);
+	if (bImmediatelyRestoreIfPossible && ExistingState)
 	{
-		FLevelObjectSaveGameState& State = ObjectStates.FindOrAdd(ObjectId);
-		State.bUsesCustomUniqueObjectId = CustomUniqueObjectId.IsSet();
-		SaveObjectToState(Object, false, IN OUT State);
+		ExistingState->bUsesCustomUniqueObjectId = CustomUniqueObjectId.IsSet();
+		ExistingState->PartitionIndex = PartitionIndex;
+		RestoreObjectFromState(*ExistingState, bWithTransform, IN OUT Object);
+		UE_LOG(LogLevelObjectRestorer, VeryVerbose, TEXT("Registered LevelObject \"%s\" restored an existing state for ObjectId: \"%s\""), *Object.GetName(), *ObjectId)
 	}
 	else
 	{
-		ObjectStates.Remove(ObjectId);
+		FLevelObjectSaveGameState& State = FindOrAddObjectState(ObjectKey, ObjectIdChecksum, PartitionIndex);
+		State.bUsesCustomUniqueObjectId = CustomUniqueObjectId.IsSet();
+		SaveObjectToState(Object, bWithTransform, IN OUT State);
+		UE_LOG(LogLevelObjectRestorer, VeryVerbose, TEXT("Registered LevelObject \"%s\" did NOT restore an existing state for ObjectId: \"%s\""), *Object.GetName(), *ObjectId)
 	}
+	MarkObjectStateUpToDate(Object, ObjectKey, bWithTransform);
 }
 
-void ULevelObjectRestorer::UnregisterLevelObjectWithTransform(AActor& Actor, TOptional<FString> CustomUniqueObjectId, bool bKeepObjectState)
+void ULevelObjectRestorer::RegisterLevelObjects(TConstArrayView<FLevelObjectRegistration> Registrations)
 {
-	CheckLevelObject(Actor);
-	const TWeakObjectPtr<> ObjectPtr = MakeWeakObjectPtr(&Actor);
-	ensureMsgf(RegisteredObjectsWithTransform.Contains(ObjectPtr), TEXT("%s is not registered"), *Actor.GetName());
-	RegisteredObjectsWithTransform.Remove(ObjectPtr);
-	UniqueIdsOfRegisteredObjects.Remove(ObjectPtr);
+	if (RegistrationBudgetMs <= 0.0f)
+	{
+		for (const FLevelObjectRegistration& Registration : Registrations)
+		{
+			ProcessRegistration(Registration);
+		}
+		return;
+	}
 
-	const FString ObjectId = CustomUniqueObjectId.Get(MakeSafeUniqueObjectId(Actor));
-	if (bKeepObjectState)
+	PendingRegistrations.Reserve(PendingRegistrations.Num() + Registrations.Num());
+	for (const FLevelObjectRegistration& Registration : Registrations)
 	{
-		FLevelObjectSaveGameState& State = ObjectStates.FindOrAdd(ObjectId);
-		State.bUsesCustomUniqueObjectId = CustomUniqueObjectId.IsSet();
-		SaveObjectToState(Actor, true, IN OUT State);
+		bool bIsAlreadyPending = false;
+		PendingRegistrationObjects.Add(Registration.Object, &bIsAlreadyPending);
+		if (ensureMsgf(!bIsAlreadyPending, TEXT("%s is already registered"), *GetNameSafe(Registration.Object.Get())))
+		{
+			PendingRegistrations.Add(Registration);
+		}
 	}
-	else
+	SET_DWORD_STAT(STAT_LevelObjectRestorer_PendingRegistrations, GetNumPendingRegistrations());
+
+	if (PendingRegistrationsTickerHandle.IsSet())
+		return;
+
+	PendingRegistrationsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(TEXT("ULevelObjectRestorer::PendingRegistrations"), 0.0f,
+		[WeakThis = MakeWeakObjectPtr(this)](float)
+		{
+			ULevelObjectRestorer* StrongThis = WeakThis.Get();
+			if (!StrongThis)
+				return false;
+
+			StrongThis->ProcessPendingRegistrations(StrongThis->RegistrationBudgetMs / 1000.0);
+			if (StrongThis->PendingRegistrations.Num() > 0)
+				return true; // = Continue with the next frame.
+
+			StrongThis->PendingRegistrationsTickerHandle.Reset();
+			return false;
+		});
+}
+
+void ULevelObjectRestorer::FlushPendingRegistrations()
+{
+	ProcessPendingRegistrations(MAX_dbl);
+}
+
+void ULevelObjectRestorer::ProcessRegistration(const FLevelObjectRegistration& Registration)
+{
+	UObject* Object = Registration.Object.Get();
+	if (!IsValid(Object))
+		return;
+
+	const bool bCanRestoreTransform = (Object->IsA<AActor>() || Object->IsA<USceneComponent>());
+	ensureMsgf(!Registration.bWithTransform || bCanRestoreTransform, TEXT("Transforms of %s can't be restored"), *Object->GetName());
+	RegisterObjectState(*Object, (Registration.bWithTransform && bCanRestoreTransform), {}, true);
+}
+
+void ULevelObjectRestorer::ProcessPendingRegistrations(double BudgetSeconds)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("ULevelObjectRestorer.ProcessPendingRegistrations"), STAT_LevelObjectRestorer_ProcessPendingRegistrations, STATGROUP_SaveGame);
+	const double EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+	int32 NumProcessed = 0;
+	while (NumProcessed < PendingRegistrations.Num())
 	{
-		ObjectStates.Remove(ObjectId);
+		// (i) Always process at least one registration, so the queue can't stall with a budget that is too small.
+		if (NumProcessed > 0 && FPlatformTime::Seconds() >= EndTime)
+			break;
+
+		// (i) Copied, since restoring the object may register further objects.
+		const FLevelObjectRegistration Registration = PendingRegistrations[NumProcessed++];
+		if (PendingRegistrationObjects.Remove(Registration.Object) > 0)
+		{
+			ProcessRegistration(Registration);
+		}
 	}
+	PendingRegistrations.RemoveAt(0, NumProcessed, EAllowShrinking::No);
+	SET_DWORD_STAT(STAT_LevelObjectRestorer_PendingRegistrations, GetNumPendingRegistrations());
+	UE_LOG(LogLevelObjectRestorer, VeryVerbose, TEXT("%s processed %d registrations, %d pending"), *GetPathName(), NumProcessed, GetNumPendingRegistrations());
+}
+
+bool ULevelObjectRestorer::CancelPendingRegistration(const UObject& Object)
+{
+	// (i) The cancelled entry stays in the queue and is skipped once it is processed.
+	return (PendingRegistrationObjects.Remove(MakeWeakObjectPtr(const_cast<UObject*>(&Object))) > 0);
+}
+
+void ULevelObjectRestorer::UnregisterLevelObject(UObject& Object, TOptional<FString> CustomUniqueObjectId, bool bKeepObjectState)
+{
+	UnregisterObjectState(Object, false, CustomUniqueObjectId, bKeepObjectState);
+}
+
+void ULevelObjectRestorer::UnregisterLevelObjectWithTransform(AActor& Actor, TOptional<FString> CustomUniqueObjectId, bool bKeepObjectState)
+{
+	UnregisterObjectState(Actor, true, CustomUniqueObjectId, bKeepObjectState);
 }
 
 void ULevelObjectRestorer::UnregisterLevelObjectWithTransform(USceneComponent& SceneComponent, TOptional<FString> CustomUniqueObjectId, bool bKeepObjectState)
 {
-	CheckLevelObject(SceneComponent);
-	const TWeakObjectPtr<> ObjectPtr = MakeWeakObjectPtr(&SceneComponent);
-	ensureMsgf(RegisteredObjectsWithTransform.Contains(ObjectPtr), TEXT("%s is not registered"), *SceneComponent.GetName());
-	RegisteredObjectsWithTransform.Remove(ObjectPtr);
-	UniqueIdsOfRegisteredObjects.Remove(ObjectPtr);
+	UnregisterObjectState(SceneComponent, true, CustomUniqueObjectId, bKeepObjectState);
+}
+
+void ULevelObjectRestorer::UnregisterObjectState(UObject& Object, bool bWithTransform, const TOptional<FString>& CustomUniqueObjectId, bool bKeepObjectState)
+{
+	CheckLevelObject(Object);
+	if (CancelPendingRegistration(Object))
+		return;
+
+	const TWeakObjectPtr<> ObjectPtr = MakeWeakObjectPtr(&Object);
+	TSet<TWeakObjectPtr<UObject>>& RegisteredObjects = (bWithTransform ? RegisteredObjectsWithTransform : SimpleRegisteredObjects);
+	ensureMsgf(RegisteredObjects.Contains(ObjectPtr), TEXT("%s is not registered"), *Object.GetName());
+	RegisteredObjects.Remove(ObjectPtr);
+	KeysOfRegisteredObjects.Remove(ObjectPtr);
+
+	DirtyObjects.Remove(ObjectPtr);
+	const bool bIsRestorePending = (PendingRestoreObjects.Remove(ObjectPtr) > 0);
 
-	const FString ObjectId = CustomUniqueObjectId.Get(MakeSafeUniqueObjectId(SceneComponent));
+	const FString ObjectId = CustomUniqueObjectId.Get(MakeSafeUniqueObjectId(Object));
+	uint32 ObjectIdChecksum = 0;
+	const FLevelObjectStateKey ObjectKey = MakeObjectStateKey(ObjectId, OUT ObjectIdChecksum);
+	UpToDateObjectStateHashes.Remove(ObjectKey);
+	const int32 PartitionIndex = FindOrAddLevelPartition(*Object.GetTypedOuter<ULevel>());
+	UnpackLevelPartition(PartitionIndex);
 	if (bKeepObjectState)
 	{
-		FLevelObjectSaveGameState& State = ObjectStates.FindOrAdd(ObjectId);
+		FLevelObjectSaveGameState& State = FindOrAddObjectState(ObjectKey, ObjectIdChecksum, PartitionIndex);
 		State.bUsesCustomUniqueObjectId = CustomUniqueObjectId.IsSet();
-		SaveObjectToState(SceneComponent, true, IN OUT State);
+		// (i) Objects that were not restored yet would overwrite their restored state with outdated data.
+		if (!bIsRestorePending)
+		{
+			SaveObjectToState(Object, bWithTransform, IN OUT State);
+		}
 	}
 	else
 	{
-		ObjectStates.Remove(ObjectId);
+		KeyedObjectStates.Remove(ObjectKey);
+	}
+}
+
+void ULevelObjectRestorer::MarkLevelObjectDirty(const UObject& Object)
+{
+	const TWeakObjectPtr<> ObjectPtr = MakeWeakObjectPtr(const_cast<UObject*>(&Object));
+	if (KeysOfRegisteredObjects.Contains(ObjectPtr))
+	{
+		DirtyObjects.Add(ObjectPtr);
 	}
 }
 
@@ -188,24 +384,80 @@ FString ULevelObjectRestorer::MakeSafeUniqueObjectId(const UObject& Object)
 	return WorldName + ":" + LevelName + "." + ObjectPath;
 }
 
+FLevelObjectStateKey ULevelObjectRestorer::MakeObjectStateKey(const FString& ObjectId, uint32& OutObjectIdChecksum)
+{
+	// (i) Safe ObjectIds look like "WorldName:LevelName.ObjectPath", so everything up to the first '.' after the ':' is shared
+	// by all objects of a level. Custom ObjectIds usually have no such prefix and all share the empty prefix.
+	int32 PrefixLength = 0;
+	if (int32 IndexOfWorldSeparator = INDEX_NONE; ObjectId.FindChar(':', OUT IndexOfWorldSeparator))
+	{
+		const int32 IndexOfLevelSeparator = ObjectId.Find(TEXT("."), ESearchCase::CaseSensitive, ESearchDir::FromStart, IndexOfWorldSeparator);
+		PrefixLength = (IndexOfLevelSeparator != INDEX_NONE) ? (IndexOfLevelSeparator + 1) : 0;
+	}
+
+	// ObjectIds were compared case-insensitive as keys of the former TMap<FString, ...>, so the hashes must be as well:
+	FString ObjectPath = ObjectId.RightChop(PrefixLength);
+	ObjectPath.ToLowerInline();
+	OutObjectIdChecksum = FCrc::StrCrc32(*ObjectPath);
+
+	FLevelObjectStateKey Key;
+	Key.PrefixIndex = FindOrAddObjectIdPrefix(ObjectId.Left(PrefixLength));
+	Key.PathHash = CityHash64(reinterpret_cast<const char*>(*ObjectPath), ObjectPath.Len() * sizeof(TCHAR));
+	return Key;
+}
+
+FString ULevelObjectRestorer::DescribeObjectStateKey(const FLevelObjectStateKey& Key) const
+{
+	const FString Prefix = ObjectIdPrefixes.IsValidIndex(Key.PrefixIndex) ? ObjectIdPrefixes[Key.PrefixIndex] : FString("<invalid prefix>");
+	return FString::Printf(TEXT("%s#%016llx"), *Prefix, Key.PathHash);
+}
+
 void ULevelObjectRestorer::Serialize(FArchive& Ar)
 {
 	// Prepare serialization:
 	if (Ar.ArIsSaveGame && Ar.IsSaving())
 	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("ULevelObjectRestorer.SaveRegisteredObjects"), STAT_LevelObjectRestorer_SaveRegisteredObjects, STATGROUP_SaveGame);
 		PreSaveModule();
+		UpgradeLegacyObjectStates();
 
+		NumReusedObjectStatesOfLastSave = 0;
+		NumSerializedObjectStatesOfLastSave = 0;
 		for (TWeakObjectPtr<> RegisteredObject : SimpleRegisteredObjects.Union(RegisteredObjectsWithTransform))
 		{
 			if (!RegisteredObject.IsValid())
 				continue;
 
 			UObject* Object = RegisteredObject.Get();
-			const FString& ObjectId = UniqueIdsOfRegisteredObjects[RegisteredObject];
+			const FLevelObjectStateKey& ObjectKey = KeysOfRegisteredObjects[RegisteredObject];
 			const bool bHasTransform = RegisteredObjectsWithTransform.Contains(RegisteredObject);
-			FLevelObjectSaveGameState& State = ObjectStates.FindOrAdd(ObjectId);
-			SaveObjectToState(*Object, bHasTransform, IN OUT State);
+			const bool bIsRestorePending = PendingRestoreObjects.Contains(RegisteredObject);
+			if (bIsRestorePending || (!DirtyObjects.Contains(RegisteredObject) && KeyedObjectStates.Contains(ObjectKey) && IsObjectStateUpToDate(*Object, ObjectKey, bHasTransform)))
+			{
+				++NumReusedObjectStatesOfLastSave;
+				continue;
+			}
+
+			FLevelObjectSaveGameState* State = KeyedObjectStates.Find(ObjectKey);
+			if (!State)
+			{
+				// (i) Rare case: The state was removed (or packed) while the object stayed registered.
+				const int32 PartitionIndex = FindOrAddLevelPartition(*Object->GetTypedOuter<ULevel>());
+				UnpackLevelPartition(PartitionIndex);
+				State = &KeyedObjectStates.FindOrAdd(ObjectKey);
+				State->PartitionIndex = PartitionIndex;
+			}
+			SaveObjectToState(*Object, bHasTransform, IN OUT *State);
+			MarkObjectStateUpToDate(*Object, ObjectKey, bHasTransform);
+			++NumSerializedObjectStatesOfLastSave;
 		}
+		DirtyObjects.Reset();
+
+		SET_DWORD_STAT(STAT_LevelObjectRestorer_ReusedObjectStates, NumReusedObjectStatesOfLastSave);
+		SET_DWORD_STAT(STAT_LevelObjectRestorer_SerializedObjectStates, NumSerializedObjectStatesOfLastSave);
+		SET_DWORD_STAT(STAT_LevelObjectRestorer_PackedObjectStates, GetNumPackedObjectStates());
+		UE_LOG(LogLevelObjectRestorer, Verbose, TEXT("Saving %s reused %d and serialized %d object states (%d packed)"),
+			*GetPathName(), NumReusedObjectStatesOfLastSave, NumSerializedObjectStatesOfLastSave, GetNumPackedObjectStates());
 	}
 
 	// Prepare deserialization:
@@ -215,9 +467,18 @@ void ULevelObjectRestorer::Serialize(FArchive& Ar)
 		// when the savegame was created. Because that would cause the ModuleVersion to become "ModuleVersion_Current" although it might not be the case!
 		// The UObject::Serialize() will now either NOT modify the ModuleVersion (delta = false), or overwrite it with the serialized ModuleVersion (delta = true).
 		ModuleVersion = ModuleVersion_Initial;
+
+		// Restored states replace all existing states, regardless of whether they are restored as property or afterwards:
+		KeyedObjectStates.Reset();
+		PackedLevelPartitions.Reset();
 	}
 
+	// (i) Object states are written after all properties, see SerializeObjectStates().
 	UObject::Serialize(Ar);
+	if (Ar.ArIsSaveGame && ModuleVersion >= ModuleVersion_WithObjectStateKeys)
+	{
+		SerializeObjectStates(Ar);
+	}
 
 	// Finalize deserialization:
 	if (Ar.ArIsSaveGame && Ar.IsLoading())
@@ -225,36 +486,184 @@ void ULevelObjectRestorer::Serialize(FArchive& Ar)
 		UE_LOG(LogLevelObjectRestorer, Log, TEXT("Restoring %s with ModuleVersion %d"), *GetPathName(), ModuleVersion);
 		UpgradeSaveGameModule();
 
-		for (TWeakObjectPtr<> RegisteredObject : SimpleRegisteredObjects.Union(RegisteredObjectsWithTransform))
+		// Registered objects need the states of their levels, even if these were packed when saving:
+		if (!PackedLevelPartitions.IsEmpty())
 		{
-			if (!RegisteredObject.IsValid())
-				continue;
+			for (const int32 PartitionIndex : GetLevelPartitionsOfRegisteredObjects())
+			{
+				UnpackLevelPartition(PartitionIndex);
+			}
+		}
 
-			UObject* Object = RegisteredObject.Get();
-			const FString& ObjectId = UniqueIdsOfRegisteredObjects[RegisteredObject];
-			const bool bHasTransform = RegisteredObjectsWithTransform.Contains(RegisteredObject);
-			FLevelObjectSaveGameState& State = ObjectStates.FindOrAdd(ObjectId);
-			RestoreObjectFromState(State, bHasTransform, IN OUT *Object);
+		// Restored states replace whatever was known to be up-to-date before:
+		UpToDateObjectStateHashes.Reset();
+		DirtyObjects.Reset();
+		RestoreRegisteredObjects();
+
+		if (bPackStatesOfUnloadedLevels)
+		{
+			PackLevelPartitionsWithoutRegisteredObjects();
 		}
 
 		PostRestoreModule();
+		if (!IsRestoringObjects())
+		{
+			OnObjectRestoreCompleted.Broadcast();
+		}
 	}
 }
 
+float ULevelObjectRestorer::GetObjectRestoreProgress() const
+{
+	return (NumObjectsToRestore > 0) ? static_cast<float>(NumRestoredObjects) / NumObjectsToRestore : 1.0f;
+}
+
+void ULevelObjectRestorer::FlushPendingRestores()
+{
+	ProcessPendingRestores(MAX_dbl);
+}
+
+void ULevelObjectRestorer::RestoreRegisteredObjects()
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("ULevelObjectRestorer.RestoreRegisteredObjects"), STAT_LevelObjectRestorer_RestoreRegisteredObjects, STATGROUP_SaveGame);
+	ResetPendingRestores();
+	const bool bIsTimeSliced = (RestoreBudgetMs > 0.0f);
+	const TOptional<FVector> PlayerLocation = bIsTimeSliced ? FindPlayerViewLocation() : TOptional<FVector>();
+	for (TWeakObjectPtr<> RegisteredObject : SimpleRegisteredObjects.Union(RegisteredObjectsWithTransform))
+	{
+		if (!RegisteredObject.IsValid())
+			continue;
+
+		UObject* Object = RegisteredObject.Get();
+		const FLevelObjectStateKey& ObjectKey = KeysOfRegisteredObjects[RegisteredObject];
+		const bool bHasTransform = RegisteredObjectsWithTransform.Contains(RegisteredObject);
+		FLevelObjectSaveGameState& State = KeyedObjectStates.FindOrAdd(ObjectKey);
+		if (bIsTimeSliced)
+		{
+			PendingRestores.Add({RegisteredObject, ObjectKey, bHasTransform, CalculateRestoreOrder(State, bHasTransform, PlayerLocation)});
+			PendingRestoreObjects.Add(RegisteredObject);
+			continue;
+		}
+
+		RestoreObjectFromState(State, bHasTransform, IN OUT *Object);
+		MarkObjectStateUpToDate(*Object, ObjectKey, bHasTransform);
+	}
+
+	if (PendingRestores.IsEmpty())
+		return;
+
+	Algo::SortBy(PendingRestores, &FPendingObjectRestore::RestoreOrder);
+	NumObjectsToRestore = PendingRestores.Num();
+	SET_DWORD_STAT(STAT_LevelObjectRestorer_PendingRestores, PendingRestores.Num());
+	PendingRestoresTickerHandle = FTSTicker::GetCoreTicker().AddTicker(TEXT("ULevelObjectRestorer::PendingRestores"), 0.0f,
+		[WeakThis = MakeWeakObjectPtr(this)](float)
+		{
+			ULevelObjectRestorer* StrongThis = WeakThis.Get();
+			if (!StrongThis)
+				return false;
+
+			StrongThis->ProcessPendingRestores(StrongThis->RestoreBudgetMs / 1000.0);
+			return StrongThis->IsRestoringObjects(); // = Continue with the next frame.
+		});
+}
+
+void ULevelObjectRestorer::ProcessPendingRestores(double BudgetSeconds)
+{
+	if (PendingRestores.IsEmpty())
+		return;
+
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("ULevelObjectRestorer.ProcessPendingRestores"), STAT_LevelObjectRestorer_ProcessPendingRestores, STATGROUP_SaveGame);
+	const double EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+	int32 NumProcessed = 0;
+	while (NumProcessed < PendingRestores.Num())
+	{
+		// (i) Always restore at least one object, so the queue can't stall with a budget that is too small.
+		if (NumProcessed > 0 && FPlatformTime::Seconds() >= EndTime)
+			break;
+
+		const FPendingObjectRestore PendingRestore = PendingRestores[NumProcessed++];
+		UObject* Object = PendingRestore.Object.Get();
+		const FLevelObjectSaveGameState* State = KeyedObjectStates.Find(PendingRestore.ObjectKey);
+		if (PendingRestoreObjects.Remove(PendingRestore.Object) == 0 || !IsValid(Object) || !State)
+			continue;
+
+		RestoreObjectFromState(*State, PendingRestore.bHasTransform, IN OUT *Object);
+		MarkObjectStateUpToDate(*Object, PendingRestore.ObjectKey, PendingRestore.bHasTransform);
+	}
+	PendingRestores.RemoveAt(0, NumProcessed, EAllowShrinking::No);
+	NumRestoredObjects = (NumObjectsToRestore - PendingRestores.Num());
+	SET_DWORD_STAT(STAT_LevelObjectRestorer_PendingRestores, PendingRestores.Num());
+
+	OnObjectRestoreProgress.Broadcast(NumRestoredObjects, NumObjectsToRestore);
+	if (PendingRestores.IsEmpty())
+	{
+		UE_LOG(LogLevelObjectRestorer, Verbose, TEXT("%s restored %d registered objects"), *GetPathName(), NumObjectsToRestore);
+		ResetPendingRestores();
+		OnObjectRestoreCompleted.Broadcast();
+	}
+}
+
+void ULevelObjectRestorer::ResetPendingRestores()
+{
+	if (PendingRestoresTickerHandle.IsSet())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(*PendingRestoresTickerHandle);
+		PendingRestoresTickerHandle.Reset();
+	}
+
+	PendingRestores.Reset();
+	PendingRestoreObjects.Reset();
+	NumRestoredObjects = 0;
+	NumObjectsToRestore = 0;
+}
+
+void ULevelObjectRestorer::PostInitProperties()
+{
+	Super::PostInitProperties();
+	if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		OnLevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::HandleLevelAddedToWorld);
+		OnLevelRemovedFromWorldHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ThisClass::HandleLevelRemovedFromWorld);
+	}
+}
+
+void ULevelObjectRestorer::PostLoad()
+{
+	Super::PostLoad();
+	UpgradeLegacyObjectStates();
+}
+
+void ULevelObjectRestorer::PostDuplicate(bool bDuplicateForPIE)
+{
+	Super::PostDuplicate(bDuplicateForPIE);
+	UpgradeLegacyObjectStates();
+}
+
 void ULevelObjectRestorer::BeginDestroy()
 {
 	// Report only if there are any registered objects at all to avoid reports of temporary module instances:
-	if (bReportUnclaimedObjectStatesOnDestruction && ClaimedUniqueObjectIds.Num() > 0)
+	if (bReportUnclaimedObjectStatesOnDestruction && ClaimedObjectStateKeys.Num() > 0)
 	{
 		ReportUnclaimedObjectStates();
 	}
 
+	if (PendingRegistrationsTickerHandle.IsSet())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(*PendingRegistrationsTickerHandle);
+		PendingRegistrationsTickerHandle.Reset();
+	}
+
+	ResetPendingRestores();
+	FWorldDelegates::LevelAddedToWorld.Remove(OnLevelAddedToWorldHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(OnLevelRemovedFromWorldHandle);
 	Super::BeginDestroy();
 }
 
 void ULevelObjectRestorer::SaveObjectToState(UObject& Object, bool bSaveTransform, FLevelObjectSaveGameState& InOutState) const
 {
-	FMemoryWriter MemWriter(InOutState.ByteData);
+	// (i) Reset() keeps the allocation, so the scratch buffer only grows until it fits the largest object.
+	SaveObjectScratchBuffer.Reset();
+	FMemoryWriter MemWriter(SaveObjectScratchBuffer);
 	if (bSaveTransform)
 	{
 		FTransform Transform = GetObjectTransform(Object);
@@ -264,6 +673,15 @@ void ULevelObjectRestorer::SaveObjectToState(UObject& Object, bool bSaveTransfor
 	FObjectAndNameAsStringProxyArchive Archive(MemWriter, true);
 	Archive.ArIsSaveGame = true;
 	Object.Serialize(Archive);
+
+	// Writing directly into the ByteData would neither truncate data of larger previous states, nor avoid reallocations while growing:
+	const bool bIsUnchanged = (InOutState.ByteData.Num() == SaveObjectScratchBuffer.Num() &&
+		FMemory::Memcmp(InOutState.ByteData.GetData(), SaveObjectScratchBuffer.GetData(), SaveObjectScratchBuffer.Num()) == 0);
+	if (!bIsUnchanged)
+	{
+		InOutState.ByteData.Reset(SaveObjectScratchBuffer.Num());
+		InOutState.ByteData.Append(SaveObjectScratchBuffer);
+	}
 	InOutState.ByteDataSize = FMath::Min(InOutState.ByteData.Num(), INT32_MAX);
 }
 
@@ -305,6 +723,66 @@ void ULevelObjectRestorer::SetObjectTransform(UObject& Object, const FTransform&
 	}
 }
 
+TOptional<uint32> ULevelObjectRestorer::CalculateObjectStateHash(UObject& Object, bool bIncludeTransform) const
+{
+	uint32 Hash = 0;
+	if (bIncludeTransform)
+	{
+		const FTransform Transform = GetObjectTransform(Object);
+		Hash = HashCombine(Hash, GetTypeHash(Transform.GetTranslation()));
+		Hash = HashCombine(Hash, GetTypeHash(Transform.GetRotation()));
+		Hash = HashCombine(Hash, GetTypeHash(Transform.GetScale3D()));
+	}
+
+	for (TFieldIterator<FProperty> Itr(Object.GetClass()); Itr; ++Itr)
+	{
+		const FProperty* Property = *Itr;
+		if (!Property->HasAnyPropertyFlags(CPF_SaveGame))
+			continue;
+
+		if (!Property->HasAllPropertyFlags(CPF_HasGetValueTypeHash))
+			return {};
+
+		for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ++ArrayIndex)
+		{
+			Hash = HashCombine(Hash, Property->GetValueTypeHash(Property->ContainerPtrToValuePtr<void>(&Object, ArrayIndex)));
+		}
+	}
+	return Hash;
+}
+
+double ULevelObjectRestorer::CalculateRestoreOrder(const FLevelObjectSaveGameState& State, bool bHasTransform, const TOptional<FVector>& PlayerLocation) const
+{
+	if (!bHasTransform || !PlayerLocation.IsSet())
+		return MAX_dbl;
+
+	// (i) The restored transform is more relevant than the current one, and it is serialized first anyway (see SaveObjectToState()).
+	FMemoryReader MemReader(State.ByteData);
+	FTransform Transform = FTransform::Identity;
+	MemReader << Transform;
+	return MemReader.IsError() ? MAX_dbl : FVector::DistSquared(Transform.GetLocation(), PlayerLocation.GetValue());
+}
+
+TOptional<FVector> ULevelObjectRestorer::FindPlayerViewLocation() const
+{
+	for (const TPair<TWeakObjectPtr<>, FLevelObjectStateKey>& RegisteredObject : KeysOfRegisteredObjects)
+	{
+		const UWorld* World = RegisteredObject.Key.IsValid() ? RegisteredObject.Key->GetWorld() : nullptr;
+		if (!World)
+			continue;
+
+		const APlayerController* PlayerController = World->GetFirstPlayerController();
+		if (!PlayerController)
+			return {};
+
+		FVector Location = FVector::ZeroVector;
+		FRotator Rotation = FRotator::ZeroRotator;
+		PlayerController->GetPlayerViewPoint(OUT Location, OUT Rotation);
+		return Location;
+	}
+	return {};
+}
+
 void ULevelObjectRestorer::UpgradeSaveGameModule()
 {
 	// Convert old PathName-based ObjectIds to new safe ObjectIds that don't care about PIE or standalone level naming:
@@ -476,16 +954,446 @@ void ULevelObjectRestorer::UpgradeSaveGameModule()
 			}
 		}
 	}
+
+	// (i) Must be the last upgrade, since all upgrades above operate on the full ObjectIds.
+	if (ModuleVersion < ModuleVersion_WithObjectStateKeys)
+	{
+		UE_LOG(LogLevelObjectRestorer, Log, TEXT("%s needs to be upgraded to ModuleVersion_WithObjectStateKeys ..."), *GetPathName());
+		ConvertLegacyObjectStates();
+		ModuleVersion = ModuleVersion_WithObjectStateKeys;
+	}
+
+	if (ModuleVersion < ModuleVersion_WithLevelPartitions)
+	{
+		// Nothing to upgrade, the states of previous versions get their partition once their object registers again.
+		ModuleVersion = ModuleVersion_WithLevelPartitions;
+	}
+}
+
+bool ULevelObjectRestorer::IsObjectStateUpToDate(UObject& Object, const FLevelObjectStateKey& ObjectKey, bool bHasTransform) const
+{
+	const uint32* UpToDateHash = UpToDateObjectStateHashes.Find(ObjectKey);
+	if (!UpToDateHash)
+		return false;
+
+	switch (DirtyTrackingMode)
+	{
+	case ELevelObjectRestorerDirtyTrackingMode::ExplicitOnly:
+		return true;
+	case ELevelObjectRestorerDirtyTrackingMode::ExplicitAndPropertyHash:
+	{
+		const TOptional<uint32> CurrentHash = CalculateObjectStateHash(Object, bHasTransform);
+		return CurrentHash.IsSet() && (CurrentHash.GetValue() == *UpToDateHash);
+	}
+	case ELevelObjectRestorerDirtyTrackingMode::Disabled:
+	default:
+		return false;
+	}
+}
+
+void ULevelObjectRestorer::MarkObjectStateUpToDate(UObject& Object, const FLevelObjectStateKey& ObjectKey, bool bHasTransform)
+{
+	if (DirtyTrackingMode == ELevelObjectRestorerDirtyTrackingMode::Disabled)
+		return;
+
+	if (DirtyTrackingMode == ELevelObjectRestorerDirtyTrackingMode::ExplicitAndPropertyHash)
+	{
+		const TOptional<uint32> Hash = CalculateObjectStateHash(Object, bHasTransform);
+		if (!Hash.IsSet())
+		{
+			// Unhashable objects can never be detected as unchanged:
+			UpToDateObjectStateHashes.Remove(ObjectKey);
+			return;
+		}
+		UpToDateObjectStateHashes.Add(ObjectKey, Hash.GetValue());
+	}
+	else
+	{
+		UpToDateObjectStateHashes.Add(ObjectKey, 0);
+	}
+}
+
+int32 ULevelObjectRestorer::FindOrAddObjectIdPrefix(const FString& Prefix)
+{
+	return FindOrAddInternedString(Prefix, IN OUT ObjectIdPrefixes, IN OUT ObjectIdPrefixIndices);
+}
+
+int32 ULevelObjectRestorer::FindOrAddLevelPartition(const ULevel& Level)
+{
+	// (i) Partition names are only ever appended, so cached indices stay valid, and registrations don't build the name every time.
+	const TWeakObjectPtr<const ULevel> LevelPtr = MakeWeakObjectPtr(&Level);
+	if (const int32* CachedPartitionIndex = LevelPartitionIndicesByLevel.Find(LevelPtr))
+	{
+		if (LevelPartitionNames.IsValidIndex(*CachedPartitionIndex))
+			return *CachedPartitionIndex;
+	}
+
+	const int32 PartitionIndex = FindOrAddInternedString(MakeLevelPartitionName(Level), IN OUT LevelPartitionNames, IN OUT LevelPartitionIndices);
+	LevelPartitionIndicesByLevel.Add(LevelPtr, PartitionIndex);
+	return PartitionIndex;
+}
+
+int32 ULevelObjectRestorer::FindLevelPartition(const ULevel& Level)
+{
+	return FindInternedString(MakeLevelPartitionName(Level), LevelPartitionNames, IN OUT LevelPartitionIndices);
+}
+
+TSet<int32> ULevelObjectRestorer::GetLevelPartitionsOfRegisteredObjects()
+{
+	TSet<int32> PartitionIndices;
+	TSet<const ULevel*> VisitedLevels;
+	for (const TPair<TWeakObjectPtr<>, FLevelObjectStateKey>& RegisteredObject : KeysOfRegisteredObjects)
+	{
+		const ULevel* Level = RegisteredObject.Key.IsValid() ? RegisteredObject.Key->GetTypedOuter<ULevel>() : nullptr;
+		if (!Level || VisitedLevels.Contains(Level))
+			continue;
+
+		VisitedLevels.Add(Level);
+		PartitionIndices.Add(FindOrAddLevelPartition(*Level));
+	}
+	return PartitionIndices;
+}
+
+int32 ULevelObjectRestorer::GetNumPackedObjectStates() const
+{
+	int32 NumPackedObjectStates = 0;
+	for (const TPair<int32, FLevelObjectStatePartition>& Partition : PackedLevelPartitions)
+	{
+		NumPackedObjectStates += Partition.Value.NumObjectStates;
+	}
+	return NumPackedObjectStates;
+}
+
+void ULevelObjectRestorer::UnpackLevelPartition(int32 PartitionIndex, const TArray<int32>* PrefixIndexRemap)
+{
+	// (i) The partition stays packed until all of its states were decoded, so a failure doesn't lose them with the next save.
+	const FLevelObjectStatePartition* Partition = PackedLevelPartitions.Find(PartitionIndex);
+	if (!Partition)
+		return;
+
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("ULevelObjectRestorer.UnpackLevelPartition"), STAT_LevelObjectRestorer_UnpackLevelPartition, STATGROUP_SaveGame);
+	const FString PartitionName = LevelPartitionNames.IsValidIndex(PartitionIndex) ? LevelPartitionNames[PartitionIndex] : FString("<invalid partition>");
+	TArray<uint8> UncompressedData;
+	if (Partition->CompressionFormat != ESaveGameCompressionFormat::None)
+	{
+		const FName CompressionFormatName = GetCompressionFormatName(Partition->CompressionFormat);
+		if (!FCompression::IsFormatValid(CompressionFormatName))
+		{
+			UE_LOG(LogLevelObjectRestorer, Error, TEXT("%s can't unpack %d object states of level %s"), *GetPathName(), Partition->NumObjectStates, *PartitionName);
+			return;
+		}
+
+		// Don't even try to allocate the uncompressed size of corrupted data:
+		if (!IsPlausibleUncompressedSize(*Partition))
+		{
+			UE_LOG(LogLevelObjectRestorer, Error, TEXT("%s can't unpack %d object states of level %s with implausible size of %d bytes (%d bytes compressed)"),
+				*GetPathName(), Partition->NumObjectStates, *PartitionName, Partition->UncompressedSize, Partition->CompressedData.Num());
+			return;
+		}
+
+		UncompressedData.SetNumUninitialized(Partition->UncompressedSize);
+		if (!FCompression::UncompressMemory(CompressionFormatName, UncompressedData.GetData(), Partition->UncompressedSize,
+			Partition->CompressedData.GetData(), Partition->CompressedData.Num()))
+		{
+			UE_LOG(LogLevelObjectRestorer, Error, TEXT("%s failed to decompress %d object states of level %s"), *GetPathName(), Partition->NumObjectStates, *PartitionName);
+			return;
+		}
+	}
+
+	const bool bIsUncompressed = (Partition->CompressionFormat == ESaveGameCompressionFormat::None);
+	FMemoryReader MemReader(bIsUncompressed ? Partition->CompressedData : UncompressedData);
+	int32 NumObjectStates = 0;
+	MemReader << NumObjectStates;
+	TArray<TPair<FLevelObjectStateKey, FLevelObjectSaveGameState>> UnpackedObjectStates;
+	UnpackedObjectStates.Reserve(FMath::Clamp(NumObjectStates, 0, GetMaxNumObjectStatesLeftInArchive(MemReader, true)));
+	for (int32 i = 0; i < NumObjectStates && !MemReader.IsError(); ++i)
+	{
+		TPair<FLevelObjectStateKey, FLevelObjectSaveGameState>& UnpackedObjectState = UnpackedObjectStates.AddDefaulted_GetRef();
+		SerializeObjectState(MemReader, UnpackedObjectState.Key, UnpackedObjectState.Value, true);
+	}
+
+	if (MemReader.IsError())
+	{
+		UE_LOG(LogLevelObjectRestorer, Error, TEXT("%s failed to unpack object states of level %s"), *GetPathName(), *PartitionName);
+		return;
+	}
+
+	// (i) Decoding is done, so the partition (and the data the reader points to) can be released:
+	PackedLevelPartitions.Remove(PartitionIndex);
+	KeyedObjectStates.Reserve(KeyedObjectStates.Num() + UnpackedObjectStates.Num());
+	for (TPair<FLevelObjectStateKey, FLevelObjectSaveGameState>& UnpackedObjectState : UnpackedObjectStates)
+	{
+		FLevelObjectStateKey ObjectKey = UnpackedObjectState.Key;
+		if (PrefixIndexRemap && !TryRemapPrefixIndex(ObjectKey, *PrefixIndexRemap))
+			continue;
+
+		// (i) States that were added while the partition was packed are newer:
+		if (KeyedObjectStates.Contains(ObjectKey))
+			continue;
+
+		UnpackedObjectState.Value.PartitionIndex = PartitionIndex;
+		KeyedObjectStates.Add(ObjectKey, MoveTemp(UnpackedObjectState.Value));
+	}
+
+	UE_LOG(LogLevelObjectRestorer, Verbose, TEXT("%s unpacked %d object states of level %s"), *GetPathName(), NumObjectStates, *PartitionName);
+}
+
+void ULevelObjectRestorer::PackLevelPartition(int32 PartitionIndex, const TArray<FLevelObjectStateKey>& ObjectKeys)
+{
+	if (ObjectKeys.IsEmpty() || !ensure(!PackedLevelPartitions.Contains(PartitionIndex)))
+		return;
+
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("ULevelObjectRestorer.PackLevelPartition"), STAT_LevelObjectRestorer_PackLevelPartition, STATGROUP_SaveGame);
+	TArray<uint8> UncompressedData;
+	FMemoryWriter MemWriter(UncompressedData);
+	int32 NumObjectStates = ObjectKeys.Num();
+	MemWriter << NumObjectStates;
+	for (FLevelObjectStateKey ObjectKey : ObjectKeys)
+	{
+		SerializeObjectState(MemWriter, ObjectKey, KeyedObjectStates.FindChecked(ObjectKey), true);
+	}
+
+	FLevelObjectStatePartition Partition;
+	Partition.NumObjectStates = NumObjectStates;
+	Partition.UncompressedSize = UncompressedData.Num();
+	const FName CompressionFormatName = GetCompressionFormatName(PackedStatesCompressionFormat);
+	int32 CompressedSize = FCompression::IsFormatValid(CompressionFormatName) ? FCompression::CompressMemoryBound(CompressionFormatName, Partition.UncompressedSize) : 0;
+	Partition.CompressedData.SetNumUninitialized(CompressedSize);
+	if (CompressedSize > 0 && FCompression::CompressMemory(CompressionFormatName, Partition.CompressedData.GetData(), IN OUT CompressedSize,
+		UncompressedData.GetData(), Partition.UncompressedSize))
+	{
+		Partition.CompressionFormat = PackedStatesCompressionFormat;
+		Partition.CompressedData.SetNum(CompressedSize);
+	}
+	else
+	{
+		// Still worth packing, since the states don't need to be serialized again until their level is loaded:
+		Partition.CompressionFormat = ESaveGameCompressionFormat::None;
+		Partition.CompressedData = MoveTemp(UncompressedData);
+	}
+
+	for (const FLevelObjectStateKey& ObjectKey : ObjectKeys)
+	{
+		KeyedObjectStates.Remove(ObjectKey);
+	}
+
+	UE_LOG(LogLevelObjectRestorer, Verbose, TEXT("%s packed %d object states of level %s into %d bytes"), *GetPathName(), NumObjectStates,
+		LevelPartitionNames.IsValidIndex(PartitionIndex) ? *LevelPartitionNames[PartitionIndex] : TEXT("<invalid partition>"), Partition.CompressedData.Num());
+	PackedLevelPartitions.Add(PartitionIndex, MoveTemp(Partition));
+}
+
+void ULevelObjectRestorer::PackLevelPartitionsWithoutRegisteredObjects()
+{
+	const TSet<int32> PartitionsInUse = GetLevelPartitionsOfRegisteredObjects();
+	TMap<int32, TArray<FLevelObjectStateKey>> ObjectKeysByPartition;
+	for (const TPair<FLevelObjectStateKey, FLevelObjectSaveGameState>& ObjectState : KeyedObjectStates)
+	{
+		const int32 PartitionIndex = ObjectState.Value.PartitionIndex;
+		if (PartitionIndex != INDEX_NONE && !PartitionsInUse.Contains(PartitionIndex))
+		{
+			ObjectKeysByPartition.FindOrAdd(PartitionIndex).Add(ObjectState.Key);
+		}
+	}
+
+	for (const TPair<int32, TArray<FLevelObjectStateKey>>& Partition : ObjectKeysByPartition)
+	{
+		PackLevelPartition(Partition.Key, Partition.Value);
+	}
+}
+
+void ULevelObjectRestorer::HandleLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (!Level || !World || !World->IsGameWorld() || PackedLevelPartitions.IsEmpty())
+		return;
+
+	const int32 PartitionIndex = FindLevelPartition(*Level);
+	if (PartitionIndex != INDEX_NONE)
+	{
+		UnpackLevelPartition(PartitionIndex);
+	}
+}
+
+void ULevelObjectRestorer::HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+	if (Level)
+	{
+		LevelPartitionIndicesByLevel.Remove(MakeWeakObjectPtr<const ULevel>(Level));
+	}
+
+	// (i) A null level means that all levels of the world are removed, which leaves nothing to be saved or restored anyway.
+	if (!bPackStatesOfUnloadedLevels || !Level || !World || !World->IsGameWorld())
+		return;
+
+	// Objects of the level unregistered themselves (and updated their states) when the level was removed:
+	const int32 PartitionIndex = FindLevelPartition(*Level);
+	if (PartitionIndex == INDEX_NONE || PackedLevelPartitions.Contains(PartitionIndex) || GetLevelPartitionsOfRegisteredObjects().Contains(PartitionIndex))
+		return;
+
+	TArray<FLevelObjectStateKey> ObjectKeys;
+	for (const TPair<FLevelObjectStateKey, FLevelObjectSaveGameState>& ObjectState : KeyedObjectStates)
+	{
+		if (ObjectState.Value.PartitionIndex == PartitionIndex)
+		{
+			ObjectKeys.Add(ObjectState.Key);
+		}
+	}
+	PackLevelPartition(PartitionIndex, ObjectKeys);
+}
+
+FLevelObjectSaveGameState* ULevelObjectRestorer::FindObjectState(const FLevelObjectStateKey& ObjectKey, uint32 ObjectIdChecksum)
+{
+	FLevelObjectSaveGameState* State = KeyedObjectStates.Find(ObjectKey);
+	if (State && State->ObjectIdChecksum != 0 && State->ObjectIdChecksum != ObjectIdChecksum)
+	{
+		UE_LOG(LogLevelObjectRestorer, Error, TEXT("%s: Different ObjectIds have the same key %s. The existing state will be overwritten."),
+			*GetPathName(), *DescribeObjectStateKey(ObjectKey));
+		return nullptr;
+	}
+	return State;
+}
+
+FLevelObjectSaveGameState& ULevelObjectRestorer::FindOrAddObjectState(const FLevelObjectStateKey& ObjectKey, uint32 ObjectIdChecksum, int32 PartitionIndex)
+{
+	FLevelObjectSaveGameState& State = KeyedObjectStates.FindOrAdd(ObjectKey);
+	State.ObjectIdChecksum = ObjectIdChecksum;
+	State.PartitionIndex = PartitionIndex;
+	return State;
+}
+
+void ULevelObjectRestorer::UpgradeLegacyObjectStates()
+{
+	// (i) Modules that were not restored from a SaveGame (e.g. presets or their duplicates) are not upgraded on restore,
+	// but may still contain states of older module versions. Their ModuleVersion may even be current, if it was never changed.
+	if (ModuleVersion < ModuleVersion_Current)
+	{
+		UpgradeSaveGameModule();
+	}
+	ConvertLegacyObjectStates();
+}
+
+void ULevelObjectRestorer::ConvertLegacyObjectStates()
+{
+	if (ObjectStates.IsEmpty())
+		return;
+
+	int32 NumCollisions = 0;
+	KeyedObjectStates.Reserve(KeyedObjectStates.Num() + ObjectStates.Num());
+	for (TPair<FString, FLevelObjectSaveGameState>& ObjectState : ObjectStates)
+	{
+		uint32 ObjectIdChecksum = 0;
+		const FLevelObjectStateKey ObjectKey = MakeObjectStateKey(ObjectState.Key, OUT ObjectIdChecksum);
+		if (const FLevelObjectSaveGameState* ExistingState = KeyedObjectStates.Find(ObjectKey))
+		{
+			UE_CLOG(ExistingState->ObjectIdChecksum != ObjectIdChecksum, LogLevelObjectRestorer, Error,
+				TEXT("%s: ObjectId \"%s\" has the same key as another ObjectId and is discarded."), *GetPathName(), *ObjectState.Key);
+			++NumCollisions;
+			continue;
+		}
+
+		ObjectState.Value.ObjectIdChecksum = ObjectIdChecksum;
+		KeyedObjectStates.Add(ObjectKey, MoveTemp(ObjectState.Value));
+	}
+
+	UE_LOG(LogLevelObjectRestorer, Log, TEXT("%s converted %d ObjectIds to keys with %d prefixes (%d discarded)"),
+		*GetPathName(), ObjectStates.Num() - NumCollisions, ObjectIdPrefixes.Num(), NumCollisions);
+	ObjectStates.Empty();
+}
+
+void ULevelObjectRestorer::SerializeObjectStates(FArchive& Ar)
+{
+	// Prefixes and level partitions are interned once, all keys and states reference them by index:
+	const bool bWithLevelPartitions = (ModuleVersion >= ModuleVersion_WithLevelPartitions);
+	TArray<FString> SerializedObjectIdPrefixes = (Ar.IsSaving() ? ObjectIdPrefixes : TArray<FString>());
+	Ar << SerializedObjectIdPrefixes;
+	TArray<FString> SerializedLevelPartitionNames = (Ar.IsSaving() ? LevelPartitionNames : TArray<FString>());
+	TMap<int32, FLevelObjectStatePartition> RestoredPackedLevelPartitions;
+	if (bWithLevelPartitions)
+	{
+		Ar << SerializedLevelPartitionNames;
+		SerializePackedLevelPartitions(Ar, Ar.IsSaving() ? PackedLevelPartitions : RestoredPackedLevelPartitions);
+	}
+
+	if (Ar.IsSaving())
+	{
+		int32 NumObjectStates = KeyedObjectStates.Num();
+		Ar << NumObjectStates;
+		for (TPair<FLevelObjectStateKey, FLevelObjectSaveGameState>& ObjectState : KeyedObjectStates)
+		{
+			SerializeObjectState(Ar, ObjectState.Key, ObjectState.Value, bWithLevelPartitions);
+		}
+		return;
+	}
+
+	// Prefix indices of the restored data are only the same if this module had no other prefixes before (which is the usual case):
+	TArray<int32> PrefixIndexRemap;
+	bool bHasSamePrefixIndices = true;
+	for (int32 i = 0; i < SerializedObjectIdPrefixes.Num(); ++i)
+	{
+		PrefixIndexRemap.Add(FindOrAddObjectIdPrefix(SerializedObjectIdPrefixes[i]));
+		bHasSamePrefixIndices &= (PrefixIndexRemap.Last() == i);
+	}
+	TArray<int32> PartitionIndexRemap;
+	for (const FString& LevelPartitionName : SerializedLevelPartitionNames)
+	{
+		PartitionIndexRemap.Add(FindOrAddInternedString(LevelPartitionName, IN OUT LevelPartitionNames, IN OUT LevelPartitionIndices));
+	}
+
+	KeyedObjectStates.Reset();
+	ReadKeyedObjectStates(Ar, PrefixIndexRemap, PartitionIndexRemap);
+	UE_CLOG(Ar.IsError(), LogLevelObjectRestorer, Error, TEXT("%s failed to restore object states"), *GetPathName());
+
+	for (TPair<int32, FLevelObjectStatePartition>& RestoredPartition : RestoredPackedLevelPartitions)
+	{
+		const int32 PartitionIndex = RemapPartitionIndex(RestoredPartition.Key, PartitionIndexRemap);
+		UE_CLOG(PartitionIndex == INDEX_NONE, LogLevelObjectRestorer, Error, TEXT("%s: Restored packed object states reference an invalid level partition %d"), *GetPathName(), RestoredPartition.Key);
+		if (PartitionIndex != INDEX_NONE)
+		{
+			PackedLevelPartitions.Add(PartitionIndex, MoveTemp(RestoredPartition.Value));
+		}
+	}
+
+	if (!bHasSamePrefixIndices)
+	{
+		// (i) Packed states reference prefixes by their restored indices as well, so they have to be unpacked right away.
+		TArray<int32> PackedPartitionIndices;
+		PackedLevelPartitions.GenerateKeyArray(OUT PackedPartitionIndices);
+		for (const int32 PartitionIndex : PackedPartitionIndices)
+		{
+			UnpackLevelPartition(PartitionIndex, &PrefixIndexRemap);
+		}
+	}
+}
+
+void ULevelObjectRestorer::ReadKeyedObjectStates(FArchive& Ar, const TArray<int32>& PrefixIndexRemap, const TArray<int32>& PartitionIndexRemap)
+{
+	const bool bWithLevelPartitions = (ModuleVersion >= ModuleVersion_WithLevelPartitions);
+	int32 NumObjectStates = 0;
+	Ar << NumObjectStates;
+	KeyedObjectStates.Reserve(KeyedObjectStates.Num() + FMath::Clamp(NumObjectStates, 0, GetMaxNumObjectStatesLeftInArchive(Ar, bWithLevelPartitions)));
+	for (int32 i = 0; i < NumObjectStates && !Ar.IsError(); ++i)
+	{
+		FLevelObjectStateKey ObjectKey;
+		FLevelObjectSaveGameState State;
+		SerializeObjectState(Ar, ObjectKey, State, bWithLevelPartitions);
+		if (!TryRemapPrefixIndex(ObjectKey, PrefixIndexRemap))
+		{
+			UE_LOG(LogLevelObjectRestorer, Error, TEXT("%s: Restored object state references an invalid prefix %d"), *GetPathName(), ObjectKey.PrefixIndex);
+			continue;
+		}
+
+		State.PartitionIndex = RemapPartitionIndex(State.PartitionIndex, PartitionIndexRemap);
+		KeyedObjectStates.Add(ObjectKey, MoveTemp(State));
+	}
 }
 
 void ULevelObjectRestorer::ReportUnclaimedObjectStates() const
 {
-	for (const TPair<FString, FLevelObjectSaveGameState>& ObjectState : ObjectStates)
+	for (const TPair<FLevelObjectStateKey, FLevelObjectSaveGameState>& ObjectState : KeyedObjectStates)
 	{
-		if (ClaimedUniqueObjectIds.Contains(ObjectState.Key))
+		if (ClaimedObjectStateKeys.Contains(ObjectState.Key))
 			continue;
 
-		UE_LOG(LogLevelObjectRestorer, Log, TEXT("%s reports unclaimed ObjectState for UniqueObjectId: %s"), *GetPathName(), *ObjectState.Key);
+		UE_LOG(LogLevelObjectRestorer, Log, TEXT("%s reports unclaimed ObjectState for key: %s"), *GetPathName(), *DescribeObjectStateKey(ObjectState.Key));
 	}
 }
 
@@ -502,7 +1410,7 @@ void ULevelObjectRestorer::AnalyzeAndReportModuleComposition(FMessageLog& Messag
 	int32 NumEntriesBelowThreshold = 0;
 	constexpr double PctThreshold = 0.1;
 	TMap<int64, FString> SortedAnalysisEntries;
-	for (const TPair<FString, FLevelObjectSaveGameState>& Itr : ObjectStates)
+	for (const TPair<FLevelObjectStateKey, FLevelObjectSaveGameState>& Itr : KeyedObjectStates)
 	{
 		const int64 ObjectSize = Itr.Value.ByteDataSize;
 		const int64 ObjectSizeKb = FUnitConversion::Convert(ObjectSize, EUnit::Bytes, EUnit::Kilobytes);
@@ -521,7 +1429,7 @@ void ULevelObjectRestorer::AnalyzeAndReportModuleComposition(FMessageLog& Messag
 
 		const FString PctString = FString::Printf(TEXT("%05.2f%%"), Pct);
 		const FString SizeString = ObjectSize < 10000 ? FString::Printf(TEXT("%lld bytes"), ObjectSize) : FString::Printf(TEXT("%lld KB"), ObjectSizeKb);
-		SortedAnalysisEntries.Add(SortIndex, FString::Printf(TEXT("- [%s] State: %s (~%s)"), *PctString, *Itr.Key, *SizeString));
+		SortedAnalysisEntries.Add(SortIndex, FString::Printf(TEXT("- [%s] State: %s (~%s)"), *PctString, *DescribeObjectStateKey(Itr.Key), *SizeString));
 	}
 	SortedAnalysisEntries.KeySort(TGreater<int64>());
 
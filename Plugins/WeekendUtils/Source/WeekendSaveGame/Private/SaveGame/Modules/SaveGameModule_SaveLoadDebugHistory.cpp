@@ -22,6 +22,36 @@ void USaveGameModule_SaveLoadDebugHistory::PreSaveModule()
 	}
 	if (SaveGameService)
 	{
-		DebugHistory = SaveGameService->GetDebugHistory();
+		// (i) The ring buffer of the service keeps changing, so it is copied in order before any of it is serialized.
+		DebugHistory.Reset();
+		DebugHistoryEntries.Reset(SaveGameService->GetNumDebugHistoryEntries());
+		SaveGameService->ForEachDebugHistoryEntry([this](const FSaveGameDebugHistoryEntry& Entry)
+		{
+			DebugHistoryEntries.Add(Entry);
+		});
 	}
+	ModuleVersion = ModuleVersion_Current;
+}
+
+TArray<FString> USaveGameModule_SaveLoadDebugHistory::GetFormattedDebugHistory() const
+{
+	TArray<FString> Result = DebugHistory;
+	Result.Reserve(DebugHistory.Num() + DebugHistoryEntries.Num());
+	for (const FSaveGameDebugHistoryEntry& Entry : DebugHistoryEntries)
+	{
+		Result.Add(FString::Printf(TEXT("(%s UTC)\t %s"), *Entry.Timestamp.ToString(), *LexToString(Entry)));
+	}
+	return Result;
+}
+
+void USaveGameModule_SaveLoadDebugHistory::Serialize(FArchive& Ar)
+{
+	if (Ar.ArIsSaveGame && Ar.IsLoading())
+	{
+		// Keep older SaveGames (that may not have serialized their version) from being read as the current version:
+		ModuleVersion = ModuleVersion_Initial;
+		DebugHistoryEntries.Reset();
+	}
+
+	Super::Serialize(Ar);
 }
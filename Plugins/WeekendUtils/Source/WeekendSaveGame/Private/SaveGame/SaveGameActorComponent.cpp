@@ -21,6 +21,18 @@ USaveGameActorComponent::USaveGameActorComponent()
 	PrimaryComponentTick.bCanEverTick = false;
 }
 
+void USaveGameActorComponent::MarkDirtyForSaveGame()
+{
+	if (!IsValid(LevelObjectRestorer))
+		return;
+
+	LevelObjectRestorer->MarkLevelObjectDirty(*GetOwner());
+	GetOwner()->ForEachComponent<UActorComponent>(false, [this](const UActorComponent* Component)
+	{
+		LevelObjectRestorer->MarkLevelObjectDirty(*Component);
+	});
+}
+
 void USaveGameActorComponent::InitializeComponent()
 {
 	Super::InitializeComponent();
@@ -49,21 +61,20 @@ void USaveGameActorComponent::UninitializeComponent()
 
 void USaveGameActorComponent::RegisterWithSaveGame()
 {
+	// (i) Registered as one batch, which the LevelObjectRestorer may spread over multiple frames.
+	TArray<FLevelObjectRegistration, TInlineAllocator<8>> Registrations;
+
 	// Owning Actor:
-	if (bRestoreActorTransform)
-	{
-		LevelObjectRestorer->RegisterLevelObjectWithTransform(*GetOwner());
-	}
-	else
-	{
-		LevelObjectRestorer->RegisterLevelObject(*GetOwner());
-	}
+	Registrations.Add({GetOwner(), bRestoreActorTransform});
 
 	if (!bRestoreActorComponents)
+	{
+		LevelObjectRestorer->RegisterLevelObjects(Registrations);
 		return;
+	}
 
 	// Components of Owning Actor:
-	GetOwner()->ForEachComponent<UActorComponent>(false, [this](UActorComponent* Component)
+	GetOwner()->ForEachComponent<UActorComponent>(false, [this, &Registrations](UActorComponent* Component)
 	{
 		if (bOnlyRestoreActorComponentsWithTag && !Component->ComponentTags.Contains(RestorableComponentTag))
 			return;
@@ -76,15 +87,9 @@ void USaveGameActorComponent::RegisterWithSaveGame()
 			bRestoreTransform = false;
 		}
 
-		if (bRestoreTransform)
-		{
-			LevelObjectRestorer->RegisterLevelObjectWithTransform(*SceneComponent);
-		}
-		else
-		{
-			LevelObjectRestorer->RegisterLevelObject(*Component);
-		}
+		Registrations.Add({Component, bRestoreTransform});
 	});
+	LevelObjectRestorer->RegisterLevelObjects(Registrations);
 }
 
 void USaveGameActorComponent::UnregisterFromSaveGame()
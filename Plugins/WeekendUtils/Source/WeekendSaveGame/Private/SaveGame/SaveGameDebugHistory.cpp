@@ -0,0 +1,48 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#include "SaveGame/SaveGameDebugHistory.h"
+
+FString LexToString(const FSaveGameDebugHistoryEntry& Entry)
+{
+	FString Result = FString::Printf(TEXT("[%s]"), *StaticEnum<ESaveGameDebugEvent>()->GetNameStringByValue(static_cast<int64>(Entry.Event)));
+	if (Entry.Duration >= 0.0)
+	{
+		Result += FString::Printf(TEXT(" %s (took %.3f sec)"), (Entry.bSuccess ? TEXT("succeeded") : TEXT("failed")), Entry.Duration);
+	}
+	else if (!Entry.bSuccess)
+	{
+		Result += TEXT(" failed");
+	}
+	if (Entry.NumBytes >= 0)
+	{
+		Result += FString::Printf(TEXT(" %lld bytes"), Entry.NumBytes);
+	}
+	if (!Entry.SlotName.IsEmpty())
+	{
+		Result += FString::Printf(TEXT(" (for %s)"), *Entry.SlotName);
+	}
+	if (Entry.NumExistingSlots >= 0 || Entry.NumChangedSlots >= 0)
+	{
+		Result += FString::Printf(TEXT(" %d existing, %d changed slots"), Entry.NumExistingSlots, Entry.NumChangedSlots);
+	}
+	if (!Entry.KeyHolder.IsNone())
+	{
+		Result += FString::Printf(TEXT(" KeyHolder: %s"), *Entry.KeyHolder.ToString());
+	}
+	if (Entry.LockKey.IsValid())
+	{
+		Result += FString::Printf(TEXT(" Key: %s"), *Entry.LockKey.ToString());
+	}
+	if (!Entry.Context.IsEmpty())
+	{
+		Result += TEXT(": ") + Entry.Context;
+	}
+	return Result;
+}
@@ -121,7 +121,7 @@ void USaveGameEditor::EditSaveGameFromFile()
 	const bool bSuccess = DesktopPlatform->OpenFileDialog(
 		FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
 		"Select file to load",
-		FPaths::ProjectSavedDir() / "SaveGames", TEXT(""), TEXT("SaveGame files|*.sav"),
+		USaveGameSerializer::GetLocalSaveGamesDir(), TEXT(""), TEXT("SaveGame files|*.sav"),
 		EFileDialogFlags::None, OUT FileNames);
 	if (!bSuccess || FileNames.IsEmpty() || !FPaths::FileExists(FileNames[0]))
 		return;
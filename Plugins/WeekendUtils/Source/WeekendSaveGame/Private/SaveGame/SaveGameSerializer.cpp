@@ -11,13 +11,254 @@
 
 #include "PlatformFeatures.h"
 #include "SaveGameSystem.h"
+#include "WeekendSaveGame.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "Engine/AssetManager.h"
 #include "GameFramework/SaveGame.h"
 #include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "SaveGame/Settings/SaveGameServiceSettings.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "StructUtils/InstancedStruct.h"
+#include "Tasks/Pipe.h"
+#include "Tasks/Task.h"
+#include "UObject/GarbageCollection.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSaveGameSerializer, Log, All);
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("SaveGameSerializer.LoadLatencyP50 (ms)"), STAT_SaveGameSerializer_LoadLatencyP50, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("SaveGameSerializer.LoadLatencyP90 (ms)"), STAT_SaveGameSerializer_LoadLatencyP90, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("SaveGameSerializer.LoadLatencyP99 (ms)"), STAT_SaveGameSerializer_LoadLatencyP99, STATGROUP_SaveGame);
+
+namespace
+{
+	/** All updates of the slot index file run through this pipe, so they are applied in the order they were issued. */
+	UE::Tasks::FPipe SlotIndexPipe(TEXT("SaveGameSlotIndex"));
+
+	/**
+	 * Whether the given save system is the engine's generic one, which only reads and writes local files and is therefore safe
+	 * to call from worker threads. Platform save systems may have to be called from the game thread instead.
+	 */
+	bool IsGenericSaveGameSystem(const ISaveGameSystem* SaveSystem)
+	{
+		// (i) The base implementation returns the static FGenericSaveGameSystem, which platforms without their own save system use:
+		IPlatformFeaturesModule& PlatformFeatures = IPlatformFeaturesModule::Get();
+		return (SaveSystem == PlatformFeatures.IPlatformFeaturesModule::GetSaveGameSystem());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+int32 FWeekendUtilsSaveGameNameTable::FindOrAdd(const FString& String, bool bIsLoadablePath)
+{
+	int32 Index = INDEX_NONE;
+	if (const int32* ExistingIndex = IndicesByString.Find(String))
+	{
+		Index = *ExistingIndex;
+	}
+	else
+	{
+		Index = Strings.Add(String);
+		IndicesByString.Add(String, Index);
+	}
+
+	if (bIsLoadablePath)
+	{
+		LoadablePathIndices.Add(Index);
+	}
+	return Index;
+}
+
+const FString* FWeekendUtilsSaveGameNameTable::Find(int32 Index) const
+{
+	return (Strings.IsValidIndex(Index) ? &Strings[Index] : nullptr);
+}
+
+void FWeekendUtilsSaveGameNameTable::Empty()
+{
+	Strings.Empty();
+	IndicesByString.Empty();
+	LoadablePathIndices.Empty();
+}
+
+TArray<FSoftObjectPath> FWeekendUtilsSaveGameNameTable::GetLoadablePaths() const
+{
+	TArray<FSoftObjectPath> Result;
+	Result.Reserve(LoadablePathIndices.Num());
+	for (const int32 Index : LoadablePathIndices)
+	{
+		if (Strings.IsValidIndex(Index))
+		{
+			Result.Emplace(Strings[Index]);
+		}
+	}
+	return Result;
+}
+
+void FWeekendUtilsSaveGameNameTable::Serialize(FArchive& Ar, bool bWithLoadablePaths)
+{
+	Ar << Strings;
+	if (bWithLoadablePaths)
+	{
+		Ar << LoadablePathIndices;
+	}
+
+	if (Ar.IsLoading())
+	{
+		// (i) Loaded tables are only used for lookups by index, so there is no need to restore the reverse lookup.
+		IndicesByString.Empty();
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FWeekendUtilsSaveGameNameTable& NameTable)
+{
+	NameTable.Serialize(Ar);
+	return Ar;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+UObject* FWeekendUtilsResolvedObjectCache::FindOrLoadObject(const FString& ObjectPath, bool bLoadIfFindFails)
+{
+	if (UObject** CachedObject = ObjectsByPath.Find(ObjectPath))
+	{
+		++NumHits;
+		return *CachedObject;
+	}
+
+	++NumMisses;
+	UObject* Object = FindObject<UObject>(nullptr, *ObjectPath, EFindObjectFlags::None);
+	if (!Object && bLoadIfFindFails)
+	{
+		Object = LoadObject<UObject>(nullptr, *ObjectPath);
+	}
+	ObjectsByPath.Add(ObjectPath, Object);
+	return Object;
+}
+
+UClass* FWeekendUtilsResolvedObjectCache::FindOrLoadClass(const FString& ClassPath, bool bLoadIfFindFails)
+{
+	if (UClass** CachedClass = ClassesByPath.Find(ClassPath))
+	{
+		++NumHits;
+		return *CachedClass;
+	}
+
+	++NumMisses;
+	UClass* Class = UClass::TryFindTypeSlow<UClass>(ClassPath);
+	if (!Class && bLoadIfFindFails)
+	{
+		Class = LoadObject<UClass>(nullptr, *ClassPath);
+	}
+	ClassesByPath.Add(ClassPath, Class);
+	return Class;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+FWeekendUtilsNameTableProxyArchive::FWeekendUtilsNameTableProxyArchive(FArchive& InInnerArchive, FWeekendUtilsSaveGameNameTable* InNameTable, bool bInLoadIfFindFails) :
+	FObjectAndNameAsStringProxyArchive(InInnerArchive, bInLoadIfFindFails), NameTable(InNameTable)
+{
+}
+
+FArchive& FWeekendUtilsNameTableProxyArchive::operator<<(FName& Name)
+{
+	if (!NameTable)
+		return FObjectAndNameAsStringProxyArchive::operator<<(Name);
+
+	FString NameString = (IsLoading() ? FString() : Name.ToString());
+	SerializeString(NameString);
+	if (IsLoading())
+	{
+		Name = FName(*NameString);
+	}
+	return *this;
+}
+
+FArchive& FWeekendUtilsNameTableProxyArchive::operator<<(UObject*& Obj)
+{
+	if (!NameTable)
+		return FObjectAndNameAsStringProxyArchive::operator<<(Obj);
+
+	FString ObjectPath = (IsLoading() ? FString() : GetPathNameSafe(Obj));
+	SerializeString(ObjectPath, IsLoadableReference(Obj));
+	if (IsLoading())
+	{
+		Obj = ResolveObject(ObjectPath);
+	}
+	return *this;
+}
+
+void FWeekendUtilsNameTableProxyArchive::SerializeString(FString& String, bool bIsLoadablePath)
+{
+	if (!NameTable)
+	{
+		InnerArchive << String;
+		return;
+	}
+
+	uint32 Index = (IsLoading() ? 0 : static_cast<uint32>(NameTable->FindOrAdd(String, bIsLoadablePath)));
+	InnerArchive.SerializeIntPacked(Index);
+	if (IsLoading())
+	{
+		const FString* TableString = NameTable->Find(static_cast<int32>(Index));
+		if (!TableString)
+		{
+			SetError();
+			String.Reset();
+			return;
+		}
+		String = *TableString;
+	}
+}
+
+UObject* FWeekendUtilsNameTableProxyArchive::ResolveObject(const FString& ObjectPath)
+{
+	if (ResolvedObjectCache)
+		return ResolvedObjectCache->FindOrLoadObject(ObjectPath, bLoadIfFindFails);
+
+	UObject* Object = FindObject<UObject>(nullptr, *ObjectPath, EFindObjectFlags::None);
+	if (!Object && bLoadIfFindFails)
+	{
+		Object = LoadObject<UObject>(nullptr, *ObjectPath);
+	}
+	return Object;
+}
+
+UClass* FWeekendUtilsNameTableProxyArchive::ResolveClass(const FString& ClassPath)
+{
+	if (ResolvedObjectCache)
+		return ResolvedObjectCache->FindOrLoadClass(ClassPath, bLoadIfFindFails);
+
+	UClass* Class = UClass::TryFindTypeSlow<UClass>(ClassPath);
+	if (!Class && bLoadIfFindFails)
+	{
+		Class = LoadObject<UClass>(nullptr, *ClassPath);
+	}
+	return Class;
+}
+
+bool FWeekendUtilsNameTableProxyArchive::IsLoadableReference(const UObject* Object)
+{
+	if (!Object || !(Object->IsAsset() || Object->IsA<UClass>()))
+		return false;
+
+	// Native classes and objects are always loaded, levels (and their objects) must never be loaded as a side effect:
+	const UPackage* Package = Object->GetPackage();
+	return (Package && !Package->HasAnyPackageFlags(PKG_CompiledIn | PKG_PlayInEditor) && !Package->ContainsMap());
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
 FWeekendUtilsSubobjectProxyArchive::FWeekendUtilsSubobjectProxyArchive(FArchive& InInnerArchive, UObject& InSubobjectOwner, bool bInLoadIfFindFails) :
-	FObjectAndNameAsStringProxyArchive(InInnerArchive, bInLoadIfFindFails), SubobjectOwner(InSubobjectOwner)
+	FWeekendUtilsSubobjectProxyArchive(InInnerArchive, InSubobjectOwner, nullptr, bInLoadIfFindFails)
+{
+}
+
+FWeekendUtilsSubobjectProxyArchive::FWeekendUtilsSubobjectProxyArchive(FArchive& InInnerArchive, UObject& InSubobjectOwner, FWeekendUtilsSaveGameNameTable* InNameTable, bool bInLoadIfFindFails) :
+	FWeekendUtilsNameTableProxyArchive(InInnerArchive, InNameTable, bInLoadIfFindFails), SubobjectOwner(InSubobjectOwner)
 {
 	ArIsSaveGame = true;
 	ArNoDelta = true;
@@ -29,31 +270,33 @@ FArchive& FWeekendUtilsSubobjectProxyArchive::operator<<(UObject*& Obj)
 	if (IsLoading())
 	{
 		FString ObjectPath, ClassPath, IsSubObjectOfOwner;
-		InnerArchive << ObjectPath;
-		InnerArchive << ClassPath;
-		InnerArchive << IsSubObjectOfOwner;
+		SerializeString(ObjectPath);
+		SerializeString(ClassPath);
+		if (NameTable)
+		{
+			uint8 bIsSubObjectOfOwner = 0;
+			InnerArchive << bIsSubObjectOfOwner;
+			IsSubObjectOfOwner = (bIsSubObjectOfOwner ? "1" : "0");
+		}
+		else
+		{
+			InnerArchive << IsSubObjectOfOwner;
+		}
 
 		if (IsSubObjectOfOwner != "1")
 		{
 			// Find/load objects from the asset registry (= asset pointers):
-			Obj = FindObject<UObject>(nullptr, *ObjectPath, EFindObjectFlags::None);
-			if (!Obj && bLoadIfFindFails)
-			{
-				Obj = LoadObject<UObject>(nullptr, *ObjectPath);
-			}
+			Obj = ResolveObject(ObjectPath);
 		}
 		else
 		{
 			// Reconstruct subobjects that were part of the owner hierarchy:
-			const UClass* Class = UClass::TryFindTypeSlow<UClass>(ClassPath);
-			if (!Class && bLoadIfFindFails)
-			{
-				Class = LoadObject<UClass>(nullptr, *ClassPath);
-			}
+			const UClass* Class = ResolveClass(ClassPath);
 			if (Class)
 			{
 				Obj = NewObject<UObject>(&SubobjectOwner, Class);
-				FObjectAndNameAsStringProxyArchive SubobjectArchive(InnerArchive, bLoadIfFindFails);
+				FWeekendUtilsNameTableProxyArchive SubobjectArchive(InnerArchive, NameTable, bLoadIfFindFails);
+				SubobjectArchive.ResolvedObjectCache = ResolvedObjectCache;
 				Obj->Serialize(SubobjectArchive);
 			}
 		}
@@ -63,12 +306,20 @@ FArchive& FWeekendUtilsSubobjectProxyArchive::operator<<(UObject*& Obj)
 		FString ObjectPath(GetPathNameSafe(Obj));
 		FString ClassPath (GetPathNameSafe(Obj ? Obj->GetClass() : nullptr));
 		FString IsSubObjectOfOwner = Obj->IsInOuter(&SubobjectOwner) ? "1" : "0";
-		InnerArchive << ObjectPath;
-		InnerArchive << ClassPath;
-		InnerArchive << IsSubObjectOfOwner;
+		SerializeString(ObjectPath, (IsSubObjectOfOwner != "1") && IsLoadableReference(Obj));
+		SerializeString(ClassPath, IsLoadableReference(Obj ? Obj->GetClass() : nullptr));
+		if (NameTable)
+		{
+			uint8 bIsSubObjectOfOwner = (IsSubObjectOfOwner == "1");
+			InnerArchive << bIsSubObjectOfOwner;
+		}
+		else
+		{
+			InnerArchive << IsSubObjectOfOwner;
+		}
 		if (Obj->IsInOuter(&SubobjectOwner))
 		{
-			FObjectAndNameAsStringProxyArchive SubobjectArchive(InnerArchive, bLoadIfFindFails);
+			FWeekendUtilsNameTableProxyArchive SubobjectArchive(InnerArchive, NameTable, bLoadIfFindFails);
 			Obj->Serialize(SubobjectArchive);
 		}
 	}
@@ -77,11 +328,170 @@ FArchive& FWeekendUtilsSubobjectProxyArchive::operator<<(UObject*& Obj)
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
+FCriticalSection FSaveGameSlotIndex::IndexFileLock;
+
+FArchive& operator<<(FArchive& Ar, FSaveGameSlotIndexEntry& Entry)
+{
+	Ar << Entry.SlotName;
+	Ar << Entry.UserIndex;
+	Ar << Entry.NumBytes;
+	Ar << Entry.Timestamp;
+	Ar << Entry.Checksum;
+	Ar << Entry.EncodedHeaderData;
+	return Ar;
+}
+
+FString FSaveGameSlotIndex::GetIndexFilePath()
+{
+	// (i) Not using the .sav extension, so the index is never mistaken for a slot (see USaveGameUtils::FindAllLocalSaveGameSlotNames):
+	return USaveGameSerializer::GetLocalSaveGamesDir() / "SlotIndex.idx";
+}
+
+bool FSaveGameSlotIndex::TryReadEntries(TMap<FEntryKey, FSaveGameSlotIndexEntry>& OutEntriesByKey)
+{
+	FScopeLock Lock(&IndexFileLock);
+	return TryReadEntriesLocked(OUT OutEntriesByKey);
+}
+
+bool FSaveGameSlotIndex::TryUpdateEntries(TArray<FSaveGameSlotIndexEntry>&& Entries)
+{
+	if (Entries.Num() == 0)
+		return true;
+
+	FScopeLock Lock(&IndexFileLock);
+	TMap<FEntryKey, FSaveGameSlotIndexEntry> EntriesByKey;
+	TryReadEntriesLocked(OUT EntriesByKey);
+	for (FSaveGameSlotIndexEntry& Entry : Entries)
+	{
+		EntriesByKey.Add(MakeEntryKey(Entry.SlotName, Entry.UserIndex), MoveTemp(Entry));
+	}
+	return TryWriteEntriesLocked(EntriesByKey);
+}
+
+bool FSaveGameSlotIndex::TryRemoveEntry(const FSlotName& SlotName, int32 UserIndex)
+{
+	FScopeLock Lock(&IndexFileLock);
+	TMap<FEntryKey, FSaveGameSlotIndexEntry> EntriesByKey;
+	if (!TryReadEntriesLocked(OUT EntriesByKey) || (EntriesByKey.Remove(MakeEntryKey(SlotName, UserIndex)) == 0))
+		return true;
+
+	return TryWriteEntriesLocked(EntriesByKey);
+}
+
+TArray<uint8> FSaveGameSlotIndex::EncodeHeaderData(const FInstancedStruct& HeaderData)
+{
+	TArray<uint8> EncodedHeaderData;
+	if (HeaderData.IsValid())
+	{
+		// (i) Keeps the struct type from being garbage collected while its path is written on another thread:
+		FGCScopeGuard GCScopeGuard;
+		FInstancedStruct HeaderDataToWrite = HeaderData;
+		FMemoryWriter MemoryWriter(EncodedHeaderData);
+		FObjectAndNameAsStringProxyArchive ProxyArchive(MemoryWriter, false);
+		HeaderDataToWrite.Serialize(ProxyArchive);
+	}
+	return EncodedHeaderData;
+}
+
+bool FSaveGameSlotIndex::TryDecodeHeaderData(const TArray<uint8>& EncodedHeaderData, FInstancedStruct& OutHeaderData)
+{
+	OutHeaderData.Reset();
+	if (EncodedHeaderData.Num() == 0)
+		return false;
+
+	// (i) Struct types are only found on other threads, since loading them is restricted to the game thread:
+	FGCScopeGuard GCScopeGuard;
+	FMemoryReader MemoryReader(EncodedHeaderData);
+	FObjectAndNameAsStringProxyArchive ProxyArchive(MemoryReader, IsInGameThread());
+	OutHeaderData.Serialize(ProxyArchive);
+	return (!MemoryReader.IsError() && OutHeaderData.IsValid());
+}
+
+bool FSaveGameSlotIndex::TryReadEntriesLocked(TMap<FEntryKey, FSaveGameSlotIndexEntry>& OutEntriesByKey)
+{
+	OutEntriesByKey.Reset();
+
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(OUT FileData, *GetIndexFilePath(), FILEREAD_Silent) || (FileData.Num() < static_cast<int32>(sizeof(uint32))))
+		return false;
+
+	// A torn or outdated index file is ignored, so that it is rebuilt from the slot files:
+	const int32 NumBytesToCheck = FileData.Num() - static_cast<int32>(sizeof(uint32));
+	FMemoryReader MemoryReader(FileData);
+	uint32 Checksum = 0;
+	MemoryReader.Seek(NumBytesToCheck);
+	MemoryReader << Checksum;
+	if (Checksum != FCrc::MemCrc32(FileData.GetData(), NumBytesToCheck))
+		return false;
+
+	uint32 FileTypeTag = 0;
+	int32 FileVersion = 0;
+	FPackageFileVersion PackageFileUEVersion;
+	MemoryReader.Seek(0);
+	MemoryReader << FileTypeTag;
+	MemoryReader << FileVersion;
+	MemoryReader << PackageFileUEVersion;
+	if (FileTypeTag != FileTypeTagValue || FileVersion != FileVersionValue || PackageFileUEVersion != GPackageFileUEVersion)
+		return false;
+
+	TArray<FSaveGameSlotIndexEntry> Entries;
+	MemoryReader << Entries;
+	if (MemoryReader.IsError())
+		return false;
+
+	OutEntriesByKey.Reserve(Entries.Num());
+	for (FSaveGameSlotIndexEntry& Entry : Entries)
+	{
+		OutEntriesByKey.Add(MakeEntryKey(Entry.SlotName, Entry.UserIndex), MoveTemp(Entry));
+	}
+	return true;
+}
+
+bool FSaveGameSlotIndex::TryWriteEntriesLocked(const TMap<FEntryKey, FSaveGameSlotIndexEntry>& EntriesByKey)
+{
+	uint32 FileTypeTag = FileTypeTagValue;
+	int32 FileVersion = FileVersionValue;
+	FPackageFileVersion PackageFileUEVersion = GPackageFileUEVersion;
+	TArray<FSaveGameSlotIndexEntry> Entries;
+	EntriesByKey.GenerateValueArray(OUT Entries);
+
+	TArray<uint8> FileData;
+	FMemoryWriter MemoryWriter(FileData);
+	MemoryWriter << FileTypeTag;
+	MemoryWriter << FileVersion;
+	MemoryWriter << PackageFileUEVersion;
+	MemoryWriter << Entries;
+	uint32 Checksum = FCrc::MemCrc32(FileData.GetData(), FileData.Num());
+	MemoryWriter << Checksum;
+
+	// Same as atomic slot writes: The index file is only replaced once the new one is complete.
+	const FString FilePath = GetIndexFilePath();
+	const FString TempFilePath = FilePath + ".tmp";
+	if (!FFileHelper::SaveArrayToFile(FileData, *TempFilePath))
+	{
+		IFileManager::Get().Delete(*TempFilePath, false, false, true);
+		UE_LOG(LogSaveGameSerializer, Warning, TEXT("Could not write SaveGame slot index %s."), *FilePath);
+		return false;
+	}
+	return IFileManager::Get().Move(*FilePath, *TempFilePath, true);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+
 bool USaveGameSerializer::TrySerializeSaveGame(USaveGame& InSaveGameObject, TArray<uint8>& OutSaveData) const
+{
+	if (!TryCaptureSaveGameSnapshot(InSaveGameObject, OUT OutSaveData))
+		return false;
+
+	const FSaveDataEncoder Encoder = MakeSaveDataEncoder();
+	return (!Encoder || Encoder(IN OUT OutSaveData));
+}
+
+bool USaveGameSerializer::TryCaptureSaveGameSnapshot(USaveGame& InSaveGameObject, TArray<uint8>& OutSnapshotData) const
 {
 	// (i) FWeekendUtilsSaveGameProxyArchive is not used here, because the base implementation of the USaveGameSerializer
 	// will just forward all calls to the default UE UGameplayStatics implementation. But see UModularSaveGameSerializer.
-	return UGameplayStatics::SaveGameToMemory(&InSaveGameObject, OUT OutSaveData);
+	return UGameplayStatics::SaveGameToMemory(&InSaveGameObject, OUT OutSnapshotData);
 }
 
 bool USaveGameSerializer::TryDeserializeSaveGame(const TArray<uint8>& InSaveData, USaveGame*& OutSaveGameObject) const
@@ -94,52 +504,105 @@ bool USaveGameSerializer::TryDeserializeSaveGame(const TArray<uint8>& InSaveData
 
 bool USaveGameSerializer::DoesSaveGameExist(const FSlotName& SlotName, const int32 UserIndex) const
 {
-	return UGameplayStatics::DoesSaveGameExist(SlotName, UserIndex);
+	// (i) An interrupted atomic write may leave only the backup slot behind, which is then loaded instead:
+	return UGameplayStatics::DoesSaveGameExist(SlotName, UserIndex) ||
+		(UsesAtomicSlotWrites() && !SlotName.IsEmpty() && UGameplayStatics::DoesSaveGameExist(GetBackupSlotName(SlotName), UserIndex));
 }
 
 bool USaveGameSerializer::TrySaveDataToSlot(const TArray<uint8>& InSaveData, const FSlotName& SlotName, const int32 UserIndex)
 {
-	return UGameplayStatics::SaveDataToSlot(InSaveData, SlotName, UserIndex);
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(UserIndex);
+	return (SaveSystem && TryWriteDataToSlot(*SaveSystem, InSaveData, SlotName, PlatformUserId, UsesAtomicSlotWrites()));
 }
 
 bool USaveGameSerializer::TrySaveGameToSlot(USaveGame& SaveGameObject, const FSlotName& SlotName, const int32 UserIndex)
 {
-	if (TArray<uint8> ObjectBytes; TrySerializeSaveGame(SaveGameObject, ObjectBytes))
+	TSharedRef<TArray<uint8>> ObjectBytes = MakeShared<TArray<uint8>>();
+	if (TrySerializeSaveGame(SaveGameObject, OUT *ObjectBytes) && TrySaveDataToSlot(*ObjectBytes, SlotName, UserIndex))
 	{
-		return TrySaveDataToSlot(ObjectBytes, SlotName, UserIndex);
+		LastSavedData = ObjectBytes;
+		if (UsesSlotIndex())
+		{
+			UpdateSlotIndexAsync(SlotName, UserIndex, ObjectBytes);
+		}
+		return true;
 	}
 	return false;
 }
 
 void USaveGameSerializer::AsyncSaveGameToSlot(USaveGame& SaveGameObject, const FSlotName& SlotName, const int32 UserIndex, FOnAsyncSaveCompleted Callback)
 {
-	// (i) Mostly copied from UGameplayStatics::AsyncSaveGameToSlot,
-	// but using this serializers internal methods.
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("USaveGameSerializer.AsyncSaveGameToSlot"), STAT_SaveGameSerializer_AsyncSaveGameToSlot, STATGROUP_SaveGame);
+	check(IsInGameThread());
+
+	// (i) The pipeline works similar to UGameplayStatics::AsyncSaveGameToSlot, but only the snapshot is captured on the game thread.
+	// Encoding the data is done on a worker thread afterward, which also writes it, if the generic save system is used.
 
 	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
-	TSharedRef<TArray<uint8>> ObjectBytes(new TArray<uint8>());
+	TSharedRef<TArray<uint8>> SaveData = MakeShared<TArray<uint8>>();
 
-	if (SaveSystem && (SlotName.Len() > 0) && 
-		TrySerializeSaveGame(SaveGameObject, OUT *ObjectBytes) && (ObjectBytes->Num() > 0) )
-	{
-		const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(UserIndex);
-		SaveSystem->SaveGameAsync(false, *SlotName, PlatformUserId, ObjectBytes, 
-			[Callback, UserIndex](const FString& ResultSlotName, FPlatformUserId, bool bSuccess)
-			{
-				check(IsInGameThread());
-				Callback.ExecuteIfBound(ResultSlotName, UserIndex, bSuccess);
-			}
-		);
-	}
-	else
+	// Game thread: Capture a snapshot of the SaveGame object, which can then be modified right away again:
+	const double GameThreadStartTime = FPlatformTime::Seconds();
+	if (!SaveSystem || (SlotName.Len() == 0) ||
+		!TryCaptureSaveGameSnapshot(SaveGameObject, OUT *SaveData) || (SaveData->Num() == 0))
 	{
 		Callback.ExecuteIfBound(SlotName, UserIndex, false);
+		return;
 	}
+	const double GameThreadSeconds = (FPlatformTime::Seconds() - GameThreadStartTime);
+
+	// Worker thread: Encode the snapshot and write it to the slot (if the save system allows that), then report back to the game thread:
+	const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(UserIndex);
+	UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[WeakThis = MakeWeakObjectPtr(this), Encoder = MakeSaveDataEncoder(), SaveSystem, SaveData, SlotName, PlatformUserId, UserIndex, Callback, GameThreadSeconds,
+			bAtomicSlotWrite = UsesAtomicSlotWrites(), bWriteOnWorker = IsGenericSaveGameSystem(SaveSystem)]()
+		{
+			const double WorkerStartTime = FPlatformTime::Seconds();
+			const bool bEncoded = (!Encoder || Encoder(IN OUT *SaveData));
+			const bool bWritten = (bWriteOnWorker && bEncoded && TryWriteDataToSlot(*SaveSystem, *SaveData, SlotName, PlatformUserId, bAtomicSlotWrite));
+			const FSaveGamePipelineStats Stats = { GameThreadSeconds, (FPlatformTime::Seconds() - WorkerStartTime), SaveData->Num() };
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, SaveSystem, SaveData, SlotName, PlatformUserId, UserIndex, Callback, bAtomicSlotWrite, bWriteOnWorker, bEncoded, bWritten, Stats]()
+			{
+				auto CompleteSave = [WeakThis, SaveData, SlotName, UserIndex, Callback, Stats](bool bSuccess)
+				{
+					if (USaveGameSerializer* StrongThis = WeakThis.Get())
+					{
+						StrongThis->LastSaveStats = Stats;
+						if (bSuccess)
+						{
+							StrongThis->LastSavedData = SaveData;
+							if (StrongThis->UsesSlotIndex())
+							{
+								StrongThis->UpdateSlotIndexAsync(SlotName, UserIndex, SaveData);
+							}
+						}
+					}
+					Callback.ExecuteIfBound(SlotName, UserIndex, bSuccess);
+				};
+
+				if (bWriteOnWorker || !bEncoded)
+				{
+					CompleteSave(bWritten);
+					return;
+				}
+
+				// Game thread: Platform save systems may not be called from worker threads, so the encoded data is handed to their async API:
+				WriteDataToSlotAsync(*SaveSystem, SaveData, SlotName, PlatformUserId, bAtomicSlotWrite, MoveTemp(CompleteSave));
+			});
+		}
+	);
 }
 
 bool USaveGameSerializer::TryLoadDataFromSlot(const FSlotName& SlotName, const int32 UserIndex, TArray<uint8>& OutSaveData)
 {
-	return UGameplayStatics::LoadDataFromSlot(OUT OutSaveData, SlotName, UserIndex);
+	const FSaveDataVerifier Verifier = MakeSaveDataVerifier();
+	if (UGameplayStatics::LoadDataFromSlot(OUT OutSaveData, SlotName, UserIndex) && (!Verifier || Verifier(OutSaveData)))
+		return true;
+
+	const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(UserIndex);
+	return (UsesAtomicSlotWrites() && TryLoadBackupDataFromSlot(SlotName, PlatformUserId, Verifier, OUT OutSaveData));
 }
 
 bool USaveGameSerializer::TryLoadGameFromSlot(const FSlotName& SlotName, const int32 UserIndex, USaveGame*& OutSaveGameObject)
@@ -151,51 +614,836 @@ bool USaveGameSerializer::TryLoadGameFromSlot(const FSlotName& SlotName, const i
 	return false;
 }
 
+struct USaveGameSerializer::FAsyncLoad
+{
+	FSlotName SlotName;
+	int32 UserIndex = 0;
+	FOnAsyncLoadCompleted Callback;
+
+	/** Loaded bytes, which are verified, decoded and prepared in place. */
+	TSharedRef<TArray<uint8>> SaveData = MakeShared<TArray<uint8>>();
+	TSharedPtr<FSaveGameDeserialization> Deserialization = nullptr;
+
+	/** Keeps the preloaded assets alive, while the construction of the SaveGame is spread across frames. */
+	TSharedPtr<FStreamableHandle> PreloadHandle = nullptr;
+
+	/** Set while a slot loaded through the async API of a platform save system may still fall back to its backup slot. */
+	bool bMayLoadBackupSlot = false;
+
+	double StartTime = FPlatformTime::Seconds();
+	FSaveGamePipelineStats Stats;
+
+	/** Game thread only: Releases the SaveGame under construction and reports the failed load. */
+	void Abort()
+	{
+		check(IsInGameThread());
+		Deserialization.Reset();
+		PreloadHandle.Reset();
+		Callback.ExecuteIfBound(SlotName, UserIndex, nullptr);
+	}
+};
+
 void USaveGameSerializer::AsyncLoadGameFromSlot(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncLoadCompleted Callback)
 {
-	// (i) Mostly copied from UGameplayStatics::AsyncLoadGameFromSlot,
-	// but using this serializers internal methods.
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("USaveGameSerializer.AsyncLoadGameFromSlot"), STAT_SaveGameSerializer_AsyncLoadGameFromSlot, STATGROUP_SaveGame);
+	check(IsInGameThread());
+
+	const TSharedRef<FAsyncLoad> AsyncLoad = MakeShared<FAsyncLoad>();
+	AsyncLoad->SlotName = SlotName;
+	AsyncLoad->UserIndex = UserIndex;
+	AsyncLoad->Callback = MoveTemp(Callback);
 
 	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
-	if (SaveSystem && (SlotName.Len() > 0))
+	if (!SaveSystem || (SlotName.Len() == 0))
+	{
+		CompleteAsyncLoad(AsyncLoad, nullptr);
+		return;
+	}
+
+	// The generic save system is read on a worker thread, straight into the buffer that is then passed through the whole pipeline:
+	if (IsGenericSaveGameSystem(SaveSystem))
 	{
-		const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(UserIndex);
-		SaveSystem->LoadGameAsync(false, *SlotName, PlatformUserId,
-			[WeakThis = MakeWeakObjectPtr(this), this, Callback, UserIndex](const FString& ResultSlotName, FPlatformUserId, bool bSuccess, const TArray<uint8>& Data)
+		LaunchAsyncLoadWorkerStage(AsyncLoad, true, false);
+		return;
+	}
+
+	// (i) Platform save systems can't be read on a worker thread, so the loaded bytes are copied from their async API instead, similar to
+	// UGameplayStatics::AsyncLoadGameFromSlot. A missing or corrupted slot then falls back to its backup slot the same way.
+	AsyncLoad->bMayLoadBackupSlot = UsesAtomicSlotWrites();
+	LoadSlotAsync(*SaveSystem, AsyncLoad, SlotName);
+}
+
+void USaveGameSerializer::LoadSlotAsync(ISaveGameSystem& SaveSystem, const TSharedRef<FAsyncLoad>& AsyncLoad, const FSlotName& SlotNameToLoad)
+{
+	check(IsInGameThread());
+
+	const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(AsyncLoad->UserIndex);
+	SaveSystem.LoadGameAsync(false, *SlotNameToLoad, PlatformUserId,
+		[WeakThis = MakeWeakObjectPtr(this), AsyncLoad](const FString&, FPlatformUserId, bool bSuccess, const TArray<uint8>& Data)
+		{
+			check(IsInGameThread());
+
+			USaveGameSerializer* StrongThis = WeakThis.Get();
+			if (!StrongThis)
+			{
+				AsyncLoad->Abort();
+				return;
+			}
+			if (!bSuccess && !AsyncLoad->bMayLoadBackupSlot)
 			{
-				check(IsInGameThread());
+				StrongThis->CompleteAsyncLoad(AsyncLoad, nullptr);
+				return;
+			}
+
+			*AsyncLoad->SaveData = (bSuccess ? Data : TArray<uint8>());
+			StrongThis->LaunchAsyncLoadWorkerStage(AsyncLoad, false, bSuccess);
+		}
+	);
+}
+
+void USaveGameSerializer::LoadBackupSlotAsync(const TSharedRef<FAsyncLoad>& AsyncLoad)
+{
+	check(IsInGameThread());
+
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	if (!SaveSystem)
+	{
+		CompleteAsyncLoad(AsyncLoad, nullptr);
+		return;
+	}
+
+	UE_LOG(LogSaveGameSerializer, Warning, TEXT("SaveGame slot %s is missing or corrupted, its backup slot from the last save is loaded instead."), *AsyncLoad->SlotName);
+	AsyncLoad->bMayLoadBackupSlot = false;
+	LoadSlotAsync(*SaveSystem, AsyncLoad, GetBackupSlotName(AsyncLoad->SlotName));
+}
 
-				if (!WeakThis.IsValid())
+void USaveGameSerializer::LaunchAsyncLoadWorkerStage(const TSharedRef<FAsyncLoad>& AsyncLoad, bool bReadSlot, bool bLoadedSuccessfully)
+{
+	check(IsInGameThread());
+
+	FSaveDataVerifier Verifier = MakeSaveDataVerifier();
+	FSaveDataDecoder Decoder = MakeSaveDataDecoder();
+	FSaveDataPreparer Preparer = MakeSaveDataPreparer();
+	if (!bReadSlot && bLoadedSuccessfully && !Verifier && !Decoder && !Preparer)
+	{
+		FinishAsyncLoad(AsyncLoad);
+		return;
+	}
+
+	// (i) Only slots read by the worker itself fall back to their backup slot here, the others were loaded including that fallback already.
+	ISaveGameSystem* SaveSystem = (bReadSlot ? IPlatformFeaturesModule::Get().GetSaveGameSystem() : nullptr);
+	const bool bWithBackupSlot = (bReadSlot && UsesAtomicSlotWrites());
+
+	// Worker thread: Read the slot if needed, verify the data (or fall back to its backup), decode and prepare it, then continue on the game thread:
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis = MakeWeakObjectPtr(this), AsyncLoad, Verifier = MoveTemp(Verifier), Decoder = MoveTemp(Decoder),
+		Preparer = MoveTemp(Preparer), SaveSystem, bLoadedSuccessfully, bWithBackupSlot]()
+	{
+		const double WorkerStartTime = FPlatformTime::Seconds();
+		TArray<uint8>& SaveData = *AsyncLoad->SaveData;
+		const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(AsyncLoad->UserIndex);
+		const bool bLoaded = SaveSystem
+			? (SaveSystem->DoesSaveGameExist(*AsyncLoad->SlotName, PlatformUserId) && SaveSystem->LoadGame(false, *AsyncLoad->SlotName, PlatformUserId, OUT SaveData))
+			: bLoadedSuccessfully;
+
+		bool bIsValid = (bLoaded && (!Verifier || Verifier(SaveData)));
+		if (!bIsValid && bWithBackupSlot)
+		{
+			bIsValid = TryLoadBackupDataFromSlot(AsyncLoad->SlotName, PlatformUserId, Verifier, OUT SaveData);
+		}
+		const bool bLoadBackupSlotAsync = (!bIsValid && AsyncLoad->bMayLoadBackupSlot);
+		const bool bDecoded = (bIsValid && (!Decoder || Decoder(IN OUT SaveData)));
+		if (bDecoded && Preparer)
+		{
+			AsyncLoad->Deserialization = Preparer(AsyncLoad->SaveData);
+		}
+		AsyncLoad->Stats.WorkerSeconds += (FPlatformTime::Seconds() - WorkerStartTime);
+		AsyncLoad->Stats.NumBytes = SaveData.Num();
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, AsyncLoad, bDecoded, bLoadBackupSlotAsync]()
+		{
+			USaveGameSerializer* StrongThis = WeakThis.Get();
+			if (!StrongThis)
+			{
+				AsyncLoad->Abort();
+				return;
+			}
+			if (bLoadBackupSlotAsync)
+			{
+				// Game thread: The backup slot of a platform save system is loaded through its async API as well, then passes this stage again:
+				StrongThis->LoadBackupSlotAsync(AsyncLoad);
+				return;
+			}
+			if (!bDecoded)
+			{
+				StrongThis->CompleteAsyncLoad(AsyncLoad, nullptr);
+				return;
+			}
+			StrongThis->FinishAsyncLoad(AsyncLoad);
+		});
+	});
+}
+
+void USaveGameSerializer::UpdateSlotIndexAsync(const FSlotName& SlotName, const int32 UserIndex, const TSharedRef<const TArray<uint8>>& SaveData) const
+{
+	if (!IsInGameThread())
+	{
+		// Synchronous saves may run on any thread, but deserializing the header data may need to load its struct type:
+		AsyncTask(ENamedThreads::GameThread, [WeakThis = MakeWeakObjectPtr(this), SlotName, UserIndex, SaveData]()
+		{
+			if (const USaveGameSerializer* StrongThis = WeakThis.Get())
+			{
+				StrongThis->UpdateSlotIndexAsync(SlotName, UserIndex, SaveData);
+			}
+		});
+		return;
+	}
+
+	// Game thread: Deserialize the header data, which may need to load its struct type:
+	FInstancedStruct HeaderData;
+	TryDeserializeHeaderData(*SaveData, OUT HeaderData);
+
+	// Worker thread: Describe the slot file as it was written, which is how the entry is validated when it is read again:
+	SlotIndexPipe.Launch(UE_SOURCE_LOCATION, [SlotName, UserIndex, SaveData, HeaderData = MoveTemp(HeaderData)]()
+	{
+		const FString FilePath = GetLocalSaveGameFilePath(SlotName);
+		const int64 FileSize = IFileManager::Get().FileSize(*FilePath);
+		if (FileSize != SaveData->Num())
+			return; // Not stored as local file, or already written again. Outdated entries are rebuilt by the next header scan anyway.
+
+		TArray<FSaveGameSlotIndexEntry> Entries;
+		FSaveGameSlotIndexEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.SlotName = SlotName;
+		Entry.UserIndex = UserIndex;
+		Entry.NumBytes = FileSize;
+		Entry.Timestamp = IFileManager::Get().GetTimeStamp(*FilePath);
+		Entry.Checksum = FCrc::MemCrc32(SaveData->GetData(), SaveData->Num());
+		Entry.EncodedHeaderData = FSaveGameSlotIndex::EncodeHeaderData(HeaderData);
+		FSaveGameSlotIndex::TryUpdateEntries(MoveTemp(Entries));
+	});
+}
+
+void USaveGameSerializer::FinishAsyncLoad(const TSharedRef<FAsyncLoad>& AsyncLoad)
+{
+	check(IsInGameThread());
+
+	TArray<FSoftObjectPath> PathsToPreload;
+	if (AsyncLoad->Deserialization.IsValid())
+	{
+		// (i) Loadable paths were already gathered on the worker thread, only whether they are loaded needs to be checked here.
+		PathsToPreload = AsyncLoad->Deserialization->LoadablePaths.FilterByPredicate([](const FSoftObjectPath& Path)
+		{
+			return (Path.IsValid() && !Path.ResolveObject());
+		});
+	}
+	else
+	{
+		GatherPathsToPreload(*AsyncLoad->SaveData, OUT PathsToPreload);
+	}
+
+	if (PathsToPreload.Num() == 0)
+	{
+		ConstructSaveGameAsync(AsyncLoad);
+		return;
+	}
+
+	// Stream in referenced assets first, so that deserialization does not have to load them synchronously:
+	AsyncLoad->PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(PathsToPreload), FStreamableDelegate::CreateLambda(
+		[WeakThis = MakeWeakObjectPtr(this), AsyncLoad]()
+		{
+			if (USaveGameSerializer* StrongThis = WeakThis.Get())
+			{
+				StrongThis->ConstructSaveGameAsync(AsyncLoad);
+			}
+			else
+			{
+				AsyncLoad->Abort();
+			}
+		}
+	));
+}
+
+void USaveGameSerializer::ConstructSaveGameAsync(const TSharedRef<FAsyncLoad>& AsyncLoad)
+{
+	check(IsInGameThread());
+
+	if (!AsyncLoad->Deserialization.IsValid())
+	{
+		// The data could not be prepared, so the SaveGame can only be deserialized at once:
+		const double GameThreadStartTime = FPlatformTime::Seconds();
+		USaveGame* LoadedGame = nullptr;
+		TryDeserializeSaveGame(*AsyncLoad->SaveData, OUT LoadedGame);
+		AsyncLoad->Stats.GameThreadSeconds += (FPlatformTime::Seconds() - GameThreadStartTime);
+		CompleteAsyncLoad(AsyncLoad, LoadedGame);
+		return;
+	}
+
+	const double BudgetSeconds = (GetDefault<USaveGameServiceSettings>()->AsyncLoadBudgetMs / 1000.0);
+	if (!ContinueSaveGameConstruction(AsyncLoad, BudgetSeconds))
+		return;
+
+	FTSTicker::GetCoreTicker().AddTicker(TEXT("USaveGameSerializer::SaveGameConstruction"), 0.0f,
+		[WeakThis = MakeWeakObjectPtr(this), AsyncLoad, BudgetSeconds](float)
+		{
+			USaveGameSerializer* StrongThis = WeakThis.Get();
+			if (!StrongThis)
+			{
+				AsyncLoad->Abort();
+				return false;
+			}
+			return StrongThis->ContinueSaveGameConstruction(AsyncLoad, BudgetSeconds); // = Continue with the next frame.
+		});
+}
+
+bool USaveGameSerializer::ContinueSaveGameConstruction(const TSharedRef<FAsyncLoad>& AsyncLoad, double BudgetSeconds)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("USaveGameSerializer.ContinueSaveGameConstruction"), STAT_SaveGameSerializer_ContinueSaveGameConstruction, STATGROUP_SaveGame);
+	check(IsInGameThread());
+
+	FSaveGameDeserialization& Deserialization = *AsyncLoad->Deserialization;
+	Deserialization.ResolvedObjectCache = {};
+
+	// (i) At least one step is performed per time slice, so that the construction always progresses:
+	const double StartTime = FPlatformTime::Seconds();
+	bool bSuccess = true;
+	do
+	{
+		bSuccess = TryDeserializeSaveGameStep(IN OUT Deserialization);
+	}
+	while (bSuccess && !Deserialization.bIsComplete && (BudgetSeconds <= 0.0 || (FPlatformTime::Seconds() - StartTime) < BudgetSeconds));
+	AsyncLoad->Stats.GameThreadSeconds += (FPlatformTime::Seconds() - StartTime);
+
+	if (bSuccess && !Deserialization.bIsComplete)
+		return true;
+
+	CompleteAsyncLoad(AsyncLoad, (bSuccess ? Deserialization.SaveGameObject.Get() : nullptr));
+	return false;
+}
+
+void USaveGameSerializer::CompleteAsyncLoad(const TSharedRef<FAsyncLoad>& AsyncLoad, USaveGame* LoadedGame)
+{
+	check(IsInGameThread());
+
+	AsyncLoad->Stats.LatencySeconds = (FPlatformTime::Seconds() - AsyncLoad->StartTime);
+	LastLoadStats = AsyncLoad->Stats;
+	if (RecentLoadLatencies.Num() < NumRecentLoadLatencies)
+	{
+		RecentLoadLatencies.Add(LastLoadStats.LatencySeconds);
+	}
+	else
+	{
+		RecentLoadLatencies[RecentLoadLatenciesHead] = LastLoadStats.LatencySeconds;
+		RecentLoadLatenciesHead = (RecentLoadLatenciesHead + 1) % NumRecentLoadLatencies;
+	}
+	SET_FLOAT_STAT(STAT_SaveGameSerializer_LoadLatencyP50, GetLoadLatencyPercentile(0.5) * 1000.0);
+	SET_FLOAT_STAT(STAT_SaveGameSerializer_LoadLatencyP90, GetLoadLatencyPercentile(0.9) * 1000.0);
+	SET_FLOAT_STAT(STAT_SaveGameSerializer_LoadLatencyP99, GetLoadLatencyPercentile(0.99) * 1000.0);
+
+	// (i) The loaded game is not released before the callback, but the callback has to keep it alive from now on.
+	AsyncLoad->Callback.ExecuteIfBound(AsyncLoad->SlotName, AsyncLoad->UserIndex, LoadedGame);
+	AsyncLoad->Deserialization.Reset();
+	AsyncLoad->PreloadHandle.Reset();
+}
+
+double USaveGameSerializer::GetLoadLatencyPercentile(double Percentile) const
+{
+	if (RecentLoadLatencies.Num() == 0)
+		return 0.0;
+
+	// (i) Nearest-rank method, so the result is always one of the recorded latencies:
+	TArray<double> SortedLatencies = RecentLoadLatencies;
+	SortedLatencies.Sort();
+	const int32 Rank = FMath::CeilToInt32(FMath::Clamp(Percentile, 0.0, 1.0) * SortedLatencies.Num());
+	return SortedLatencies[FMath::Clamp(Rank - 1, 0, SortedLatencies.Num() - 1)];
+}
+
+bool USaveGameSerializer::TryDeleteGameInSlot(const FSlotName& SlotName, const int32 UserIndex, TOptional<FString> OptionalBackupFolder)
+{
+	const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(UserIndex);
+	const bool bDeleted = TryDeleteDataInSlot(SlotName, PlatformUserId, OptionalBackupFolder, MakeBackupRotationPolicy());
+	if (bDeleted && UsesSlotIndex())
+	{
+		SlotIndexPipe.Launch(UE_SOURCE_LOCATION, [SlotName, UserIndex]()
+		{
+			FSaveGameSlotIndex::TryRemoveEntry(SlotName, UserIndex);
+		});
+	}
+	return bDeleted;
+}
+
+void USaveGameSerializer::AsyncDeleteGameInSlot(const FSlotName& SlotName, const int32 UserIndex, TOptional<FString> OptionalBackupFolder, FOnAsyncDeleteCompleted Callback)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("USaveGameSerializer.AsyncDeleteGameInSlot"), STAT_SaveGameSerializer_AsyncDeleteGameInSlot, STATGROUP_SaveGame);
+	check(IsInGameThread());
+
+	// Platform save systems may not be called from worker threads, and don't store local files that could be moved into a backup folder:
+	if (!IsGenericSaveGameSystem(IPlatformFeaturesModule::Get().GetSaveGameSystem()))
+	{
+		const bool bDeleted = TryDeleteGameInSlot(SlotName, UserIndex, {});
+		Callback.ExecuteIfBound(SlotName, UserIndex, bDeleted);
+		return;
+	}
+
+	const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(UserIndex);
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [SlotName, UserIndex, PlatformUserId, OptionalBackupFolder = MoveTemp(OptionalBackupFolder),
+		BackupRotation = MakeBackupRotationPolicy(), bUseSlotIndex = UsesSlotIndex(), Callback]()
+	{
+		// Worker thread: Delete the slot (or move it into its backup folder) and rotate its backups, then report back to the game thread:
+		const bool bDeleted = TryDeleteDataInSlot(SlotName, PlatformUserId, OptionalBackupFolder, BackupRotation);
+		if (bDeleted && bUseSlotIndex)
+		{
+			SlotIndexPipe.Launch(UE_SOURCE_LOCATION, [SlotName, UserIndex]()
+			{
+				FSaveGameSlotIndex::TryRemoveEntry(SlotName, UserIndex);
+			});
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [SlotName, UserIndex, Callback, bDeleted]()
+		{
+			Callback.ExecuteIfBound(SlotName, UserIndex, bDeleted);
+		});
+	});
+}
+
+FString USaveGameSerializer::MakeBackupFolderName()
+{
+	return FString(BackupFolderPrefix) + FDateTime::Now().ToString();
+}
+
+FSaveGameBackupRotationPolicy USaveGameSerializer::MakeBackupRotationPolicy() const
+{
+	const USaveGameServiceSettings& Settings = *GetDefault<USaveGameServiceSettings>();
+	FSaveGameBackupRotationPolicy BackupRotation;
+	BackupRotation.MaxBackupsPerSlot = Settings.MaxBackupsPerSlot;
+	BackupRotation.MaxBackupBytesPerSlot = static_cast<int64>(Settings.MaxBackupMegabytesPerSlot) * 1024 * 1024;
+	return BackupRotation;
+}
+
+bool USaveGameSerializer::UsesSlotIndex() const
+{
+	return GetDefault<USaveGameServiceSettings>()->bUseSlotIndexFile;
+}
+
+bool USaveGameSerializer::UsesAtomicSlotWrites() const
+{
+	return GetDefault<USaveGameServiceSettings>()->bUseAtomicSlotWrites;
+}
+
+bool USaveGameSerializer::TryVerifySlot(const FSlotName& SlotName, const int32 UserIndex)
+{
+	TArray<uint8> SaveData;
+	const FSaveDataVerifier Verifier = MakeSaveDataVerifier();
+	return (UGameplayStatics::LoadDataFromSlot(OUT SaveData, SlotName, UserIndex) && (!Verifier || Verifier(SaveData)));
+}
+
+void USaveGameSerializer::AsyncVerifySlots(const TArray<FSlotName>& SlotNames, const int32 UserIndex, FOnAsyncVerifyCompleted Callback)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("USaveGameSerializer.AsyncVerifySlots"), STAT_SaveGameSerializer_AsyncVerifySlots, STATGROUP_SaveGame);
+	check(IsInGameThread());
+
+	// Platform save systems may not be called from worker threads, so their slots are verified on the game thread:
+	if (!IsGenericSaveGameSystem(IPlatformFeaturesModule::Get().GetSaveGameSystem()))
+	{
+		TMap<FSlotName, bool> IsIntactBySlot;
+		for (const FSlotName& SlotName : SlotNames)
+		{
+			IsIntactBySlot.Add(SlotName, TryVerifySlot(SlotName, UserIndex));
+		}
+		Callback.ExecuteIfBound(UserIndex, IsIntactBySlot);
+		return;
+	}
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Verifier = MakeSaveDataVerifier(), SlotNames, UserIndex, Callback]()
+	{
+		// Worker thread: Read and verify each slot, without deserializing anything:
+		TMap<FSlotName, bool> IsIntactBySlot;
+		for (const FSlotName& SlotName : SlotNames)
+		{
+			TArray<uint8> SaveData;
+			TryLoadDataPrefixFromSlot(SlotName, UserIndex, MAX_int64, OUT SaveData);
+			IsIntactBySlot.Add(SlotName, (SaveData.Num() > 0 && (!Verifier || Verifier(SaveData))));
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [IsIntactBySlot = MoveTemp(IsIntactBySlot), UserIndex, Callback]()
+		{
+			Callback.ExecuteIfBound(UserIndex, IsIntactBySlot);
+		});
+	});
+}
+
+bool USaveGameSerializer::TryLoadHeaderDataFromSlot(const FSlotName& SlotName, const int32 UserIndex, FInstancedStruct& OutHeaderData)
+{
+	TArray<uint8> Data;
+	const bool bReadWholeSlot = TryLoadDataPrefixFromSlot(SlotName, UserIndex, HeaderScanReadSize, OUT Data);
+	if (TryDeserializeHeaderData(Data, OUT OutHeaderData))
+		return true;
+
+	// The header might not have fit into the prefix, so try again with the whole slot:
+	return (!bReadWholeSlot && TryLoadDataFromSlot(SlotName, UserIndex, OUT Data) && TryDeserializeHeaderData(Data, OUT OutHeaderData));
+}
+
+void USaveGameSerializer::AsyncLoadHeaderDataFromSlots(const TArray<FSlotName>& SlotNames, const int32 UserIndex, FOnAsyncHeaderScanCompleted Callback)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("USaveGameSerializer.AsyncLoadHeaderDataFromSlots"), STAT_SaveGameSerializer_AsyncLoadHeaderDataFromSlots, STATGROUP_SaveGame);
+	check(IsInGameThread());
+
+	struct FScannedSlot
+	{
+		FSlotName SlotName;
+		TArray<uint8> Data = {}; // Beginning of the slot, or the encoded header data from the slot index.
+		bool bWasWholeSlotRead = false;
+		bool bIsFromSlotIndex = false;
+		TOptional<FSaveGameSlotIndexEntry> RebuiltIndexEntry = {};
+	};
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis = MakeWeakObjectPtr(this), SlotNames, UserIndex, Callback, bUseSlotIndex = UsesSlotIndex()]()
+	{
+		// Worker thread: Take the header data of unchanged slots from the slot index, and only read the beginning of other slots:
+		TMap<FSaveGameSlotIndex::FEntryKey, FSaveGameSlotIndexEntry> IndexEntriesByKey;
+		if (bUseSlotIndex)
+		{
+			FSaveGameSlotIndex::TryReadEntries(OUT IndexEntriesByKey);
+		}
+
+		TArray<FScannedSlot> ScannedSlots;
+		ScannedSlots.Reserve(SlotNames.Num());
+		for (const FSlotName& SlotName : SlotNames)
+		{
+			FScannedSlot& ScannedSlot = ScannedSlots.Add_GetRef({ SlotName });
+			const FString FilePath = GetLocalSaveGameFilePath(SlotName);
+			const int64 FileSize = bUseSlotIndex ? IFileManager::Get().FileSize(*FilePath) : INDEX_NONE;
+			if (FileSize < 0)
+			{
+				ScannedSlot.bWasWholeSlotRead = TryLoadDataPrefixFromSlot(SlotName, UserIndex, HeaderScanReadSize, OUT ScannedSlot.Data);
+				continue;
+			}
+
+			const FDateTime FileTimestamp = IFileManager::Get().GetTimeStamp(*FilePath);
+			FSaveGameSlotIndexEntry* IndexEntry = IndexEntriesByKey.Find(FSaveGameSlotIndex::MakeEntryKey(SlotName, UserIndex));
+			if (IndexEntry && IndexEntry->IsUpToDate(FileSize, FileTimestamp))
+			{
+				ScannedSlot.Data = MoveTemp(IndexEntry->EncodedHeaderData);
+				ScannedSlot.bIsFromSlotIndex = true;
+				continue;
+			}
+
+			// The index entry is missing or outdated, so it is rebuilt from the whole slot (which is needed for its checksum):
+			ScannedSlot.bWasWholeSlotRead = TryLoadDataPrefixFromSlot(SlotName, UserIndex, MAX_int64, OUT ScannedSlot.Data);
+			if (ScannedSlot.Data.Num() != FileSize)
+				continue;
+
+			FSaveGameSlotIndexEntry& RebuiltIndexEntry = ScannedSlot.RebuiltIndexEntry.Emplace();
+			RebuiltIndexEntry.SlotName = SlotName;
+			RebuiltIndexEntry.UserIndex = UserIndex;
+			RebuiltIndexEntry.NumBytes = FileSize;
+			RebuiltIndexEntry.Timestamp = FileTimestamp;
+			RebuiltIndexEntry.Checksum = FCrc::MemCrc32(ScannedSlot.Data.GetData(), ScannedSlot.Data.Num());
+
+			// (i) A slot file that was only touched (e.g. copied or synced) still has the same content, so its header data is kept:
+			if (IndexEntry && IndexEntry->HasSameContent(FileSize, RebuiltIndexEntry.Checksum))
+			{
+				RebuiltIndexEntry.EncodedHeaderData = IndexEntry->EncodedHeaderData;
+				ScannedSlot.Data = MoveTemp(IndexEntry->EncodedHeaderData);
+				ScannedSlot.bIsFromSlotIndex = true;
+			}
+		}
+
+		// Game thread: Decode header data, which may need to resolve struct types:
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, ScannedSlots = MoveTemp(ScannedSlots), UserIndex, Callback]() mutable
+		{
+			TMap<FSlotName, FInstancedStruct> HeaderDataBySlot;
+			TArray<FSaveGameSlotIndexEntry> RebuiltIndexEntries;
+			USaveGameSerializer* StrongThis = WeakThis.Get();
+			for (int32 i = 0; StrongThis && i < ScannedSlots.Num(); ++i)
+			{
+				FScannedSlot& ScannedSlot = ScannedSlots[i];
+				FInstancedStruct HeaderData;
+				// (i) Header data that can't be decoded from the slot index anymore (e.g. after its struct type was renamed) is read from the slot again.
+				const bool bHasHeaderData = ScannedSlot.bIsFromSlotIndex
+					? (FSaveGameSlotIndex::TryDecodeHeaderData(ScannedSlot.Data, OUT HeaderData) ||
+						StrongThis->TryLoadHeaderDataFromSlot(ScannedSlot.SlotName, UserIndex, OUT HeaderData))
+					: (StrongThis->TryDeserializeHeaderData(ScannedSlot.Data, OUT HeaderData) ||
+						(!ScannedSlot.bWasWholeSlotRead && StrongThis->TryLoadHeaderDataFromSlot(ScannedSlot.SlotName, UserIndex, OUT HeaderData)));
+
+				if (ScannedSlot.RebuiltIndexEntry.IsSet())
 				{
-					Callback.ExecuteIfBound(ResultSlotName, UserIndex, nullptr);
-					return;
+					if (!ScannedSlot.bIsFromSlotIndex)
+					{
+						ScannedSlot.RebuiltIndexEntry->EncodedHeaderData = FSaveGameSlotIndex::EncodeHeaderData(HeaderData);
+					}
+					RebuiltIndexEntries.Add(MoveTemp(*ScannedSlot.RebuiltIndexEntry));
 				}
-
-				USaveGame* LoadedGame = nullptr;
-				if (bSuccess)
+				if (bHasHeaderData)
 				{
-					TryDeserializeSaveGame(Data, OUT LoadedGame);
+					HeaderDataBySlot.Add(ScannedSlot.SlotName, MoveTemp(HeaderData));
 				}
+			}
 
-				Callback.ExecuteIfBound(ResultSlotName, UserIndex, LoadedGame);
+			// Worker thread: Write the rebuilt entries back, so the next scan can take them from the slot index:
+			if (RebuiltIndexEntries.Num() > 0)
+			{
+				SlotIndexPipe.Launch(UE_SOURCE_LOCATION, [RebuiltIndexEntries = MoveTemp(RebuiltIndexEntries)]() mutable
+				{
+					FSaveGameSlotIndex::TryUpdateEntries(MoveTemp(RebuiltIndexEntries));
+				});
 			}
-		);
+			Callback.ExecuteIfBound(UserIndex, HeaderDataBySlot);
+		});
+	});
+}
+
+void USaveGameSerializer::AsyncFindExistingSlots(const TArray<FSlotName>& SlotNames, const int32 UserIndex, FOnAsyncFindSlotsCompleted Callback)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("USaveGameSerializer.AsyncFindExistingSlots"), STAT_SaveGameSerializer_AsyncFindExistingSlots, STATGROUP_SaveGame);
+	check(IsInGameThread());
+
+	auto FindExistingSlots = [bWithBackupSlot = UsesAtomicSlotWrites(), SlotNames, UserIndex]()
+	{
+		TMap<FSlotName, FDateTime> TimestampsOfExistingSlots;
+		for (const FSlotName& SlotName : SlotNames)
+		{
+			FDateTime Timestamp;
+			if (TryFindSlotTimestamp(SlotName, UserIndex, bWithBackupSlot, OUT Timestamp))
+			{
+				TimestampsOfExistingSlots.Add(SlotName, Timestamp);
+			}
+		}
+		return TimestampsOfExistingSlots;
+	};
+
+	// Platform save systems may not be called from worker threads, so their slots are checked on the game thread:
+	if (!IsGenericSaveGameSystem(IPlatformFeaturesModule::Get().GetSaveGameSystem()))
+	{
+		Callback.ExecuteIfBound(UserIndex, FindExistingSlots());
+		return;
 	}
-	else
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [FindExistingSlots = MoveTemp(FindExistingSlots), UserIndex, Callback]()
 	{
-		Callback.ExecuteIfBound(SlotName, UserIndex, nullptr);
+		// Worker thread: Only query the file system, without reading any slot:
+		TMap<FSlotName, FDateTime> TimestampsOfExistingSlots = FindExistingSlots();
+
+		AsyncTask(ENamedThreads::GameThread, [TimestampsOfExistingSlots = MoveTemp(TimestampsOfExistingSlots), UserIndex, Callback]()
+		{
+			Callback.ExecuteIfBound(UserIndex, TimestampsOfExistingSlots);
+		});
+	});
+}
+
+bool USaveGameSerializer::TryFindSlotTimestamp(const FSlotName& SlotName, const int32 UserIndex, bool bWithBackupSlot, FDateTime& OutTimestamp)
+{
+	OutTimestamp = FDateTime::MinValue();
+	if (SlotName.IsEmpty())
+		return false;
+
+	// (i) An interrupted atomic write may leave only the backup slot behind, which is then loaded instead (see DoesSaveGameExist):
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	if (IsGenericSaveGameSystem(SaveSystem))
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		FDateTime Timestamp = FileManager.GetTimeStamp(*GetLocalSaveGameFilePath(SlotName));
+		if (Timestamp == FDateTime::MinValue() && bWithBackupSlot)
+		{
+			Timestamp = FileManager.GetTimeStamp(*GetLocalSaveGameFilePath(GetBackupSlotName(SlotName)));
+		}
+		OutTimestamp = Timestamp;
+		return (Timestamp != FDateTime::MinValue());
 	}
+
+	// SaveGames are not stored as local files (e.g. on consoles), so only the existence can be checked (on the game thread):
+	check(IsInGameThread());
+	const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(UserIndex);
+	return (SaveSystem && (SaveSystem->DoesSaveGameExist(*SlotName, PlatformUserId) ||
+		(bWithBackupSlot && SaveSystem->DoesSaveGameExist(*GetBackupSlotName(SlotName), PlatformUserId))));
 }
 
-bool USaveGameSerializer::TryDeleteGameInSlot(const FSlotName& SlotName, const int32 UserIndex, TOptional<FString> OptionalBackupFolder)
+bool USaveGameSerializer::TryLoadDataPrefixFromSlot(const FSlotName& SlotName, const int32 UserIndex, const int64 MaxBytesToRead, TArray<uint8>& OutData)
 {
-	if (OptionalBackupFolder.IsSet())
+	OutData.Reset();
+	if (SlotName.IsEmpty())
+		return true;
+
+	const FString FilePath = GetLocalSaveGameFilePath(SlotName);
+	if (const TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*FilePath, FILEREAD_Silent)); FileReader.IsValid())
+	{
+		const int64 TotalSize = FileReader->TotalSize();
+		const int64 BytesToRead = FMath::Min(TotalSize, MaxBytesToRead);
+		OutData.SetNumUninitialized(BytesToRead);
+		FileReader->Serialize(OutData.GetData(), BytesToRead);
+		return (BytesToRead == TotalSize);
+	}
+
+	// (i) The generic save system stores all slots as local files, so the slot doesn't exist:
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	if (!SaveSystem || IsGenericSaveGameSystem(SaveSystem))
+		return true;
+
+	// SaveGames are not stored as local files (e.g. on consoles), so we have to read the whole slot, but only on the game thread:
+	if (!IsInGameThread())
+		return false;
+
+	const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(UserIndex);
+	if (SaveSystem->DoesSaveGameExist(*SlotName, PlatformUserId))
 	{
-		const FString SourceFilePath = FString(FPaths::ProjectSavedDir() / "SaveGames" / SlotName + ".sav");
-		const FString BackupFilePath = FString(FPaths::ProjectSavedDir() / "SaveGames" / *OptionalBackupFolder / SlotName + ".sav");
-		if (IFileManager::Get().Move(*BackupFilePath, *SourceFilePath, true))
+		SaveSystem->LoadGame(false, *SlotName, PlatformUserId, OUT OutData);
+	}
+	return true;
+}
+
+bool USaveGameSerializer::TryWriteDataToSlot(ISaveGameSystem& SaveSystem, const TArray<uint8>& InSaveData, const FSlotName& SlotName, const FPlatformUserId PlatformUserId, bool bAtomicSlotWrite)
+{
+	if (SlotName.IsEmpty())
+		return false;
+
+	// (i) The ISaveGameSystem can't rename slots, so the data is written twice instead: While the backup slot is written, the slot
+	// still holds the previous SaveGame. While the slot is written, the backup slot already holds the new one. Either is loaded
+	// instead whenever the other one turns out to be missing or corrupted (see TryLoadBackupDataFromSlot).
+	if (bAtomicSlotWrite && !SaveSystem.SaveGame(false, *GetBackupSlotName(SlotName), PlatformUserId, InSaveData))
+	{
+		UE_LOG(LogSaveGameSerializer, Warning, TEXT("Could not write the backup slot of SaveGame slot %s."), *SlotName);
+		return false;
+	}
+	return SaveSystem.SaveGame(false, *SlotName, PlatformUserId, InSaveData);
+}
+
+void USaveGameSerializer::WriteDataToSlotAsync(ISaveGameSystem& SaveSystem, const TSharedRef<const TArray<uint8>>& SaveData, const FSlotName& SlotName,
+	const FPlatformUserId PlatformUserId, bool bAtomicSlotWrite, TFunction<void(bool)> OnCompleted)
+{
+	check(IsInGameThread());
+	if (SlotName.IsEmpty())
+	{
+		OnCompleted(false);
+		return;
+	}
+
+	auto WriteSlot = [SaveSystem = &SaveSystem, SaveData, SlotName, PlatformUserId, OnCompleted]()
+	{
+		SaveSystem->SaveGameAsync(false, *SlotName, PlatformUserId, SaveData, [OnCompleted](const FString&, FPlatformUserId, bool bSuccess)
+		{
+			OnCompleted(bSuccess);
+		});
+	};
+	if (!bAtomicSlotWrite)
+	{
+		WriteSlot();
+		return;
+	}
+
+	// (i) Same order as in TryWriteDataToSlot: The slot is only overwritten once its backup slot holds the new SaveGame.
+	SaveSystem.SaveGameAsync(false, *GetBackupSlotName(SlotName), PlatformUserId, SaveData, [SlotName, OnCompleted, WriteSlot](const FString&, FPlatformUserId, bool bSuccess)
+	{
+		if (!bSuccess)
+		{
+			UE_LOG(LogSaveGameSerializer, Warning, TEXT("Could not write the backup slot of SaveGame slot %s."), *SlotName);
+			OnCompleted(false);
+			return;
+		}
+		WriteSlot();
+	});
+}
+
+bool USaveGameSerializer::TryDeleteDataInSlot(const FSlotName& SlotName, const FPlatformUserId PlatformUserId, const TOptional<FString>& OptionalBackupFolder, const FSaveGameBackupRotationPolicy& BackupRotation)
+{
+	if (SlotName.IsEmpty())
+		return false;
+
+	// The backup slot of the last atomic write must not outlive its slot, or the slot would be restored from it:
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	const FSlotName BackupSlotName = GetBackupSlotName(SlotName);
+	if (SaveSystem && SaveSystem->DoesSaveGameExist(*BackupSlotName, PlatformUserId))
+	{
+		SaveSystem->DeleteGame(false, *BackupSlotName, PlatformUserId);
+	}
+
+	// (i) Only the generic save system stores slots as local files at GetLocalSaveGameFilePath() (for all users), which can be moved:
+	IFileManager& FileManager = IFileManager::Get();
+	if (OptionalBackupFolder.IsSet() && IsGenericSaveGameSystem(SaveSystem))
+	{
+		const FString SourceFilePath = GetLocalSaveGameFilePath(SlotName);
+		const FString BackupFilePath = GetLocalSaveGameFilePath(SlotName, OptionalBackupFolder);
+		if (FileManager.Move(*BackupFilePath, *SourceFilePath, true))
+		{
+			RotateBackupsOfSlot(SlotName, BackupRotation);
 			return true;
+		}
+	}
+	return (SaveSystem && SaveSystem->DeleteGame(false, *SlotName, PlatformUserId));
+}
+
+void USaveGameSerializer::RotateBackupsOfSlot(const FSlotName& SlotName, const FSaveGameBackupRotationPolicy& BackupRotation)
+{
+	if (BackupRotation.IsUnlimited())
+		return;
+
+	struct FBackupFile
+	{
+		FString FolderName;
+		FString FilePath;
+		int64 NumBytes = 0;
+	};
+
+	IFileManager& FileManager = IFileManager::Get();
+	TArray<FString> BackupFolderNames;
+	FileManager.FindFiles(OUT BackupFolderNames, *(GetLocalSaveGamesDir() / BackupFolderPrefix + TEXT("*")), false, true);
+
+	TArray<FBackupFile> BackupFiles;
+	for (const FString& FolderName : BackupFolderNames)
+	{
+		const FString FilePath = GetLocalSaveGameFilePath(SlotName, FolderName);
+		const int64 NumBytes = FileManager.FileSize(*FilePath);
+		if (NumBytes >= 0)
+		{
+			BackupFiles.Add({ FolderName, FilePath, NumBytes });
+		}
 	}
 
-	return UGameplayStatics::DeleteGameInSlot(SlotName, UserIndex);
+	// (i) Backup folders are named by their creation time (see MakeBackupFolderName), so sorting them by name puts the newest first:
+	BackupFiles.Sort([](const FBackupFile& A, const FBackupFile& B) { return (B.FolderName < A.FolderName); });
+
+	int64 NumKeptBytes = 0;
+	bool bExceededLimits = false;
+	for (int32 i = 0; i < BackupFiles.Num(); ++i)
+	{
+		NumKeptBytes += BackupFiles[i].NumBytes;
+		bExceededLimits = bExceededLimits || (i > 0 &&
+			((BackupRotation.MaxBackupsPerSlot > 0 && i >= BackupRotation.MaxBackupsPerSlot) ||
+			(BackupRotation.MaxBackupBytesPerSlot > 0 && NumKeptBytes > BackupRotation.MaxBackupBytesPerSlot)));
+		if (!bExceededLimits)
+			continue;
+
+		FileManager.Delete(*BackupFiles[i].FilePath, false, false, true);
+
+		// The folder may still hold backups of other slots, in which case it is kept:
+		FileManager.DeleteDirectory(*(GetLocalSaveGamesDir() / BackupFiles[i].FolderName), false, false);
+	}
+}
+
+bool USaveGameSerializer::TryLoadBackupDataFromSlot(const FSlotName& SlotName, const FPlatformUserId PlatformUserId, const FSaveDataVerifier& Verifier, TArray<uint8>& OutSaveData)
+{
+	OutSaveData.Reset();
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	const FSlotName BackupSlotName = GetBackupSlotName(SlotName);
+	if (SlotName.IsEmpty() || !SaveSystem || !SaveSystem->DoesSaveGameExist(*BackupSlotName, PlatformUserId) ||
+		!SaveSystem->LoadGame(false, *BackupSlotName, PlatformUserId, OUT OutSaveData))
+		return false;
+
+	if (Verifier && !Verifier(OutSaveData))
+	{
+		OutSaveData.Reset();
+		return false;
+	}
+
+	UE_LOG(LogSaveGameSerializer, Warning, TEXT("SaveGame slot %s is missing or corrupted, its backup slot from the last save is loaded instead."), *SlotName);
+	return true;
+}
+
+FString USaveGameSerializer::GetLocalSaveGameFilePath(const FSlotName& SlotName, TOptional<FString> OptionalSubFolder)
+{
+	return OptionalSubFolder.IsSet()
+		? FString(GetLocalSaveGamesDir() / *OptionalSubFolder / SlotName + ".sav")
+		: FString(GetLocalSaveGamesDir() / SlotName + ".sav");
+}
+
+FString USaveGameSerializer::GetLocalSaveGamesDir()
+{
+	return FPaths::ProjectSavedDir() / "SaveGames";
 }
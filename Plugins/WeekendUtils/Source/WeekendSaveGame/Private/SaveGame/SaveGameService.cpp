@@ -11,13 +11,19 @@
 
 #include "Engine/World.h"
 #include "GameFramework/SaveGame.h"
+#include "SaveGame/ModularSaveGame.h"
 #include "SaveGame/SaveGameSerializer.h"
 #include "SaveGame/SaveGameUtils.h"
 #include "SaveGame/SaveLoadBehavior.h"
 #include "SaveGame/Settings/SaveGameServiceSettings.h"
+#include "WeekendSaveGame.h"
 
 DEFINE_LOG_CATEGORY(LogSaveGameService);
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("USaveGameService.QueuedRequests"), STAT_SaveGameService_QueuedRequests, STATGROUP_SaveGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("USaveGameService.RequestsInProgress"), STAT_SaveGameService_RequestsInProgress, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("USaveGameService.LastRequestWaitTime (ms)"), STAT_SaveGameService_LastRequestWaitTime, STATGROUP_SaveGame);
+
 FAsyncSaveGameHandle USaveGameService::RequestAutosave(const FDebugContext& Context)
 {
 	if (!IsAutosavingAllowed())
@@ -26,7 +32,11 @@ FAsyncSaveGameHandle USaveGameService::RequestAutosave(const FDebugContext& Cont
 		return FAsyncSaveGameHandle();
 	}
 
-	return RequestSaveCurrentSaveGameToSlot(Context, GetAutosaveSlotName());
+	const FSlotName SlotName = GetAutosaveSlotName();
+	AddDebugEntry(ESaveGameDebugEvent::RequestAutosave, Context, SlotName);
+	const TSharedRef<ISaveLoadRequest> Request = MakeShared<FSaveCurrentSaveGameRequest>(*this, Context);
+	Request->bIsAutosave = true;
+	return EnqueueSaveRequest(SlotName, Request);
 }
 
 FAsyncSaveGameHandle USaveGameService::RequestAutosave(const FDebugContext& Context, const FOnSaveLoadCompleted& Callback)
@@ -37,36 +47,40 @@ FAsyncSaveGameHandle USaveGameService::RequestAutosave(const FDebugContext& Cont
 		return FAsyncSaveGameHandle();
 	}
 
-	return RequestSaveCurrentSaveGameToSlot(Context, GetAutosaveSlotName(), Callback);
+	const FSlotName SlotName = GetAutosaveSlotName();
+	AddDebugEntry(ESaveGameDebugEvent::RequestAutosave, Context, SlotName);
+	const TSharedRef<ISaveLoadRequest> Request = MakeShared<FSaveCurrentSaveGameRequest>(*this, Context, Callback);
+	Request->bIsAutosave = true;
+	return EnqueueSaveRequest(SlotName, Request);
 }
 
 FAsyncSaveGameHandle USaveGameService::RequestSaveCurrentSaveGameToSlot(const FDebugContext& Context, const FSlotName& SlotName)
 {
-	AddDebugEntry("RequestSaveCurrentSaveGameToSlot", Context + "(for " + SlotName + ")");
+	AddDebugEntry(ESaveGameDebugEvent::RequestSave, Context, SlotName);
 	return EnqueueSaveRequest(SlotName, MakeShared<FSaveCurrentSaveGameRequest>(*this, Context));
 }
 
 FAsyncSaveGameHandle USaveGameService::RequestSaveCurrentSaveGameToSlot(const FDebugContext& Context, const FSlotName& SlotName, const FOnSaveLoadCompleted& Callback)
 {
-	AddDebugEntry("RequestSaveCurrentSaveGameToSlot", Context + "(for " + SlotName + ")");
+	AddDebugEntry(ESaveGameDebugEvent::RequestSave, Context, SlotName);
 	return EnqueueSaveRequest(SlotName, MakeShared<FSaveCurrentSaveGameRequest>(*this, Context, Callback));
 }
 
 FAsyncLoadGameHandle USaveGameService::RequestLoadCurrentSaveGameFromSlot(const FDebugContext& Context, const FSlotName& SlotName)
 {
-	AddDebugEntry("RequestLoadCurrentSaveGameFromSlot", Context + "(for " + SlotName + ")");
+	AddDebugEntry(ESaveGameDebugEvent::RequestLoad, Context, SlotName);
 	return EnqueueLoadRequest(SlotName, MakeShared<FLoadToCurrentSaveGameRequest>(*this, Context, SlotName));
 }
 
 FAsyncLoadGameHandle USaveGameService::RequestLoadCurrentSaveGameFromSlot(const FDebugContext& Context, const FSlotName& SlotName, const FOnSaveLoadCompleted& Callback)
 {
-	AddDebugEntry("RequestLoadCurrentSaveGameFromSlot", Context + "(for " + SlotName + ")");
+	AddDebugEntry(ESaveGameDebugEvent::RequestLoad, Context, SlotName);
 	return EnqueueLoadRequest(SlotName, MakeShared<FLoadToCurrentSaveGameRequest>(*this, Context, Callback, SlotName));
 }
 
 FAsyncLoadGameHandle USaveGameService::RequestLoadAndTravelIntoCurrentSaveGameFromSlot(const FDebugContext& Context, const FSlotName& SlotName)
 {
-	AddDebugEntry("RequestLoadAndTravelIntoCurrentSaveGameFromSlot", Context + "(for " + SlotName + ")");
+	AddDebugEntry(ESaveGameDebugEvent::RequestLoadAndTravel, Context, SlotName);
 	return EnqueueLoadRequest(SlotName, MakeShared<FLoadAndTravelIntoToCurrentSaveGameRequest>(*this, Context, SlotName));
 }
 
@@ -77,100 +91,22 @@ FAsyncLoadGameHandle USaveGameService::RequestLoadAndTravelIntoCurrentSaveGameFr
 
 bool USaveGameService::IsSaveRequestAlive(const FAsyncSaveGameHandle& Handle) const
 {
-	if (!Handle.IsValid())
-		return false;
-
-	for (auto Itr = PendingSaveRequestsBySlot.CreateConstIterator(); Itr; ++Itr)
-	{
-		for (const TSharedRef<ISaveLoadRequest>& SaveRequest : Itr.Value())
-		{
-			if (SaveRequest->Handle == Handle)
-				return true;
-		}
-	}
-
-	for (const TSharedRef<ISaveLoadRequest>& SaveRequest : SaveRequestsInProgress)
-	{
-		if (SaveRequest->Handle == Handle)
-			return true;
-	}
-
-	return false;
+	return (Handle.IsValid() && AliveSaveRequestsByHandle.Contains(Handle));
 }
 
 bool USaveGameService::IsLoadRequestAlive(const FAsyncLoadGameHandle& Handle) const
 {
-	if (!Handle.IsValid())
-		return false;
-
-	for (auto Itr = PendingLoadRequestsBySlot.CreateConstIterator(); Itr; ++Itr)
-	{
-		for (const TSharedRef<ISaveLoadRequest>& LoadRequest : Itr.Value())
-		{
-			if (LoadRequest->Handle == Handle)
-				return true;
-		}
-	}
-
-	for (const TSharedRef<ISaveLoadRequest>& LoadRequest : LoadRequestsInProgress)
-	{
-		if (LoadRequest->Handle == Handle)
-			return true;
-	}
-
-	return false;
+	return (Handle.IsValid() && AliveLoadRequestsByHandle.Contains(Handle));
 }
 
 void USaveGameService::CancelSaveRequest(const FAsyncSaveGameHandle& Handle)
 {
-	for (TTuple<FSlotName, TArray<TSharedRef<ISaveLoadRequest>>>& RequestsBySlotName : PendingSaveRequestsBySlot)
-	{
-		TSharedPtr<ISaveLoadRequest> FoundRequest = nullptr;
-		for (TSharedRef<ISaveLoadRequest> Request : RequestsBySlotName.Value)
-		{
-			if (Request->Handle == Handle)
-			{
-				FoundRequest = Request.ToSharedPtr();
-			}
-		}
-
-		if (!FoundRequest.IsValid())
-			continue;
-
-		FoundRequest->Cancel();
-		RequestsBySlotName.Value.Remove(FoundRequest.ToSharedRef());
-		if (RequestsBySlotName.Value.IsEmpty())
-		{
-			PendingSaveRequestsBySlot.Remove(RequestsBySlotName.Key);
-		}
-		return;
-	}
+	CancelQueuedRequest(Handle, AliveSaveRequestsByHandle, PendingSaveRequestsBySlot);
 }
 
 void USaveGameService::CancelLoadRequest(const FAsyncLoadGameHandle& Handle)
 {
-	for (TTuple<FSlotName, TArray<TSharedRef<ISaveLoadRequest>>>& RequestsBySlotName : PendingLoadRequestsBySlot)
-	{
-		TSharedPtr<ISaveLoadRequest> FoundRequest = nullptr;
-		for (TSharedRef<ISaveLoadRequest> Request : RequestsBySlotName.Value)
-		{
-			if (Request->Handle == Handle)
-			{
-				FoundRequest = Request.ToSharedPtr();
-			}
-		}
-
-		if (!FoundRequest.IsValid())
-			continue;
-
-		FoundRequest->Cancel();
-		RequestsBySlotName.Value.Remove(FoundRequest.ToSharedRef());
-		if (RequestsBySlotName.Value.IsEmpty())
-		{
-			PendingLoadRequestsBySlot.Remove(RequestsBySlotName.Key);
-		}
-		return;
-	}
+	CancelQueuedRequest(Handle, AliveLoadRequestsByHandle, PendingLoadRequestsBySlot);
 }
 
 bool USaveGameService::TryLoadCurrentSaveGameFromSlotSynchronous(const FSlotName& SlotName)
@@ -190,7 +126,7 @@ bool USaveGameService::TryLoadCurrentSaveGameFromSlotSynchronous(const FSlotName
 	SetCurrentSaveGame(FCurrentSaveGame::CreateFromLoadedGame(*LoadedSaveGame, SlotName));
 
 	SetStatus(EStatus::Idle);
-	AddDebugEntry("[TryLoadCurrentSaveGameFromSlotSynchronous] " + SlotName);
+	AddDebugEntry(ESaveGameDebugEvent::LoadSynchronous, "", SlotName);
 
 	OnAfterRestored.Broadcast(CurrentSaveGame);
 	return true;
@@ -203,7 +139,7 @@ TSet<USaveGame*> USaveGameService::PreloadSaveGamesSynchronous(const TSet<FSlotN
 		return Result;
 
 	SetStatus(EStatus::Loading);
-	AddDebugEntry("[PreloadSaveGamesSynchronous] " + FString::Join(SlotNames, TEXT(", ")));
+	AddDebugEntry(ESaveGameDebugEvent::PreloadSynchronous, FString::Join(SlotNames, TEXT(", ")));
 
 	CachedSaveGames.Clear();
 	for (const FSlotName& SlotName : SlotNames)
@@ -213,6 +149,7 @@ TSet<USaveGame*> USaveGameService::PreloadSaveGamesSynchronous(const TSet<FSlotN
 		if (USaveGame* LoadedSaveGame = PerformSyncLoad(SlotName))
 		{
 			CachedSaveGames.CopyToCache(*this, SlotName, *LoadedSaveGame);
+			UpdateCachedHeaderData(SlotName);
 			Result.Add(LoadedSaveGame);
 		}
 	}
@@ -258,9 +195,9 @@ void USaveGameService::PreloadSaveGamesAsync(const TSet<FSlotName>& SlotNames, c
 				ResultSaveGames->Add(RequestedSaveGame);
 				ResultSlotNames->Add(*SlotName);
 			}
+			Service.AddDebugEntry(ESaveGameDebugEvent::PreloadAsync, "", *SlotName, bSuccess, Runtime, Service.CachedSaveGames.GetSaveDataSize(*SlotName));
 			if (--(*RemainingSlots) <= 0)
 			{
-				Service.AddDebugEntry("PreloadSaveGamesAsync", "FPreloadRequest::Finish", bSuccess, Runtime);
 				Callback.ExecuteIfBound(ResultSaveGames->Array(), ResultSlotNames->Array());
 				ObjectsToKeepInMemory->Empty();
 			}
@@ -297,11 +234,126 @@ void USaveGameService::PreloadSaveGamesAsync(const TSet<FSlotName>& SlotNames, c
 	}
 }
 
+void USaveGameService::ScanSaveGameHeadersAsync(const TSet<FSlotName>& SlotNames, const FOnHeaderScanCompleted& Callback)
+{
+	TArray<FSlotName> ExistingSlotNames = {};
+	for (const FSlotName& SlotName : SlotNames)
+	{
+		if (DoesSaveFileExist(SlotName))
+		{
+			ExistingSlotNames.Add(SlotName);
+		}
+	}
+
+	if (ExistingSlotNames.IsEmpty())
+	{
+		Callback.ExecuteIfBound({});
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	SaveGameSerializer->AsyncLoadHeaderDataFromSlots(ExistingSlotNames, GetCurrentUserIndex(), USaveGameSerializer::FOnAsyncHeaderScanCompleted::CreateWeakLambda(this,
+		[this, Callback, StartTime](const int32, const TMap<FSlotName, FInstancedStruct>& HeaderDataBySlot)
+		{
+			TArray<FSlotName> ScannedSlotNames = {};
+			HeaderDataBySlot.GetKeys(OUT ScannedSlotNames);
+			CachedHeaderDataBySlot.Append(HeaderDataBySlot);
+			AddDebugEntry(ESaveGameDebugEvent::ScanHeaders, FString::Join(ScannedSlotNames, TEXT(", ")), "", true, FPlatformTime::Seconds() - StartTime);
+			OnAvailableSaveGamesChanged.Broadcast();
+			Callback.ExecuteIfBound(HeaderDataBySlot);
+		}));
+}
+
+void USaveGameService::RefreshSlotCatalogAsync()
+{
+	if (!SaveGameSerializer || !SaveLoadBehavior || IsRefreshingSlotCatalog())
+		return;
+
+	TSet<FSlotName> SlotNames = SaveLoadBehavior->GetSaveSlotNamesAllowedForLoading(CurrentSaveGame);
+	SlotNames.Append(SaveLoadBehavior->GetSaveSlotNamesAllowedForSaving(CurrentSaveGame));
+	SlotNames.Remove(FSlotName());
+
+	++NumPendingSlotCatalogTasks;
+	const TArray<FSlotName> CheckedSlotNames = SlotNames.Array();
+	SaveGameSerializer->AsyncFindExistingSlots(CheckedSlotNames, GetCurrentUserIndex(), USaveGameSerializer::FOnAsyncFindSlotsCompleted::CreateWeakLambda(this,
+		[this, CheckedSlotNames](const int32, const TMap<FSlotName, FDateTime>& TimestampsOfExistingSlots)
+		{
+			--NumPendingSlotCatalogTasks;
+			HandleSlotCatalogRefreshed(CheckedSlotNames, TimestampsOfExistingSlots);
+		}));
+}
+
+void USaveGameService::HandleSlotCatalogRefreshed(const TArray<FSlotName>& CheckedSlotNames, const TMap<FSlotName, FDateTime>& TimestampsOfExistingSlots)
+{
+	bool bRemovedAnySlot = false;
+	TArray<FSlotName> ChangedSlotNames = {};
+	for (const FSlotName& SlotName : CheckedSlotNames)
+	{
+		// The file of a slot that is being deleted may still be found, but it must not be listed again:
+		if (SlotsBeingDeleted.Contains(SlotName))
+			continue;
+
+		const FDateTime* Timestamp = TimestampsOfExistingSlots.Find(SlotName);
+		FSlotCatalogEntry& Entry = SlotCatalog.FindOrAdd(SlotName);
+		if (!Timestamp)
+		{
+			const bool bHadHeaderData = (CachedHeaderDataBySlot.Remove(SlotName) > 0);
+			bRemovedAnySlot |= (Entry.bExists || bHadHeaderData);
+			Entry = FSlotCatalogEntry();
+			continue;
+		}
+
+		// (i) Header data is only scanned again if the file changed since the last refresh, or was never cataloged before.
+		if (!Entry.bExists || Entry.Timestamp != *Timestamp || !CachedHeaderDataBySlot.Contains(SlotName))
+		{
+			ChangedSlotNames.Add(SlotName);
+		}
+		Entry.bExists = true;
+		Entry.Timestamp = *Timestamp;
+	}
+
+	FSaveGameDebugHistoryEntry CatalogEntry;
+	CatalogEntry.Event = ESaveGameDebugEvent::RefreshSlotCatalog;
+	CatalogEntry.Timestamp = FDateTime::UtcNow();
+	CatalogEntry.NumExistingSlots = TimestampsOfExistingSlots.Num();
+	CatalogEntry.NumChangedSlots = ChangedSlotNames.Num();
+	AddDebugEntry(MoveTemp(CatalogEntry));
+	if (bRemovedAnySlot || ChangedSlotNames.IsEmpty())
+	{
+		OnAvailableSaveGamesChanged.Broadcast();
+	}
+
+	// Scan each changed slot on its own, so every slot is published as soon as its header data is available:
+	for (const FSlotName& SlotName : ChangedSlotNames)
+	{
+		++NumPendingSlotCatalogTasks;
+		SaveGameSerializer->AsyncLoadHeaderDataFromSlots({SlotName}, GetCurrentUserIndex(), USaveGameSerializer::FOnAsyncHeaderScanCompleted::CreateWeakLambda(this,
+			[this, SlotName](const int32, const TMap<FSlotName, FInstancedStruct>& HeaderDataBySlot)
+			{
+				--NumPendingSlotCatalogTasks;
+				if (const FInstancedStruct* HeaderData = HeaderDataBySlot.Find(SlotName))
+				{
+					CachedHeaderDataBySlot.Add(SlotName, *HeaderData);
+				}
+				OnAvailableSaveGamesChanged.Broadcast();
+			}));
+	}
+}
+
+bool USaveGameService::DoesCatalogedSaveFileExist(const FSlotName& SlotName) const
+{
+	// (i) While the catalog is refreshed, its entries keep the last known state. Slots it never checked are checked right away.
+	if (const FSlotCatalogEntry* Entry = SlotCatalog.Find(SlotName))
+		return Entry->bExists;
+
+	return DoesSaveFileExist(SlotName);
+}
+
 void USaveGameService::RestoreAsCurrentSaveGame(USaveGame& SaveGame, TOptional<FSlotName> LoadedFromSlotName)
 {
 	checkf(!IsCachedSaveGameSnapshot(SaveGame), TEXT("Restoring cached SaveGame snapshots is now allowed. Use runtime versions or restore by slot"));
 
-	AddDebugEntry("[RestoreAsCurrentSaveGame] " + SaveGame.GetName() + " from slot: " + LoadedFromSlotName.Get("<Unknown>"));
+	AddDebugEntry(ESaveGameDebugEvent::RestoreAsCurrent, SaveGame.GetName(), LoadedFromSlotName.Get(""));
 	SetCurrentSaveGame(FCurrentSaveGame::CreateFromLoadedGame(SaveGame, LoadedFromSlotName));
 	OnAfterRestored.Broadcast(CurrentSaveGame);
 }
@@ -319,24 +371,24 @@ bool USaveGameService::TryTravelIntoCurrentSaveGame()
 	check(SaveLoadBehavior);
 	if (!SaveLoadBehavior->TryTravelToSavedLevel(CurrentSaveGame))
 	{
-		AddDebugEntry("[TryTravelIntoCurrentSaveGame] failed");
+		AddDebugEntry(ESaveGameDebugEvent::TravelIntoCurrent, "", "", false, -1.0);
 		return false;
 	}
 
-	AddDebugEntry("[TryTravelIntoCurrentSaveGame] succeeded");
+	AddDebugEntry(ESaveGameDebugEvent::TravelIntoCurrent, "", "", true, -1.0);
 	return true;
 }
 
 void USaveGameService::CreateNewSaveGameAsCurrent()
 {
-	AddDebugEntry("[CreateNewSaveGameAsCurrent]");
+	AddDebugEntry(ESaveGameDebugEvent::CreateNewAsCurrent, "");
 	USaveGame& SaveGameObject = SaveLoadBehavior->CreateNewSavegameObject(*this);
 	SetCurrentSaveGame(FCurrentSaveGame::CreateFromNewGame(SaveGameObject));
 }
 
 void USaveGameService::CreateAndRestoreNewSaveGameAsCurrent()
 {
-	AddDebugEntry("[CreateAndRestoreNewSaveGameAsCurrent]");
+	AddDebugEntry(ESaveGameDebugEvent::CreateAndRestoreNewAsCurrent, "");
 	USaveGame& SaveGameObject = SaveLoadBehavior->CreateNewSavegameObject(*this);
 	SetCurrentSaveGame(FCurrentSaveGame::CreateFromNewGame(SaveGameObject));
 	OnAfterRestored.Broadcast(CurrentSaveGame);
@@ -344,22 +396,38 @@ void USaveGameService::CreateAndRestoreNewSaveGameAsCurrent()
 
 void USaveGameService::DeleteSaveGameAtSlot(const FSlotName& SlotName, bool bMoveToBackupFolder)
 {
-	if (!CachedSaveGames.Contains(SlotName))
+	// (i) The catalog avoids touching the file system here, unless it never checked the slot.
+	const bool bDeleteSaveFile = DoesCatalogedSaveFileExist(SlotName);
+	if (!bDeleteSaveFile && !CachedSaveGames.Contains(SlotName) && !CachedHeaderDataBySlot.Contains(SlotName))
 		return;
 
-	if (DoesSaveFileExist(SlotName))
+	CachedSaveGames.Remove(SlotName);
+	CachedHeaderDataBySlot.Remove(SlotName);
+	if (FSlotCatalogEntry* CatalogEntry = SlotCatalog.Find(SlotName))
 	{
-		SaveGameSerializer->TryDeleteGameInSlot(SlotName, GetCurrentUserIndex(),
-			bMoveToBackupFolder ? FString("Backup_" + FDateTime::Now().ToString()) : TOptional<FString>{});
+		*CatalogEntry = FSlotCatalogEntry();
 	}
 
-	CachedSaveGames.Remove(SlotName);
+	if (bDeleteSaveFile)
+	{
+		// (i) Requests for the slot wait until its file is gone, so that a new save into the slot can't be deleted along with it.
+		SlotsBeingDeleted.Add(SlotName);
+		const double StartTime = FPlatformTime::Seconds();
+		SaveGameSerializer->AsyncDeleteGameInSlot(SlotName, GetCurrentUserIndex(),
+			bMoveToBackupFolder ? USaveGameSerializer::MakeBackupFolderName() : TOptional<FString>{},
+			USaveGameSerializer::FOnAsyncDeleteCompleted::CreateWeakLambda(this, [this, StartTime](const FSlotName& DeletedSlotName, const int32, bool bSuccess)
+			{
+				SlotsBeingDeleted.Remove(DeletedSlotName);
+				AddDebugEntry(ESaveGameDebugEvent::DeleteSlotFinished, "", DeletedSlotName, bSuccess, (FPlatformTime::Seconds() - StartTime));
+				ProcessPendingRequests();
+			}));
+	}
 	OnAvailableSaveGamesChanged.Broadcast();
 }
 
 void USaveGameService::ProcessPendingRequests()
 {
-	if (IsBusySavingOrLoading())
+	if (IsBusySaving())
 		return;
 
 	///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -370,34 +438,69 @@ void USaveGameService::ProcessPendingRequests()
 	/// It might be better to accumulate similar requests in one request object to avoid this.
 	///////////////////////////////////////////////////////////////////////////////////////////////////
 
-	if (IsSavingAllowed() && PendingSaveRequestsBySlot.Num() > 0)
+	// (i) Loads may replace the current SaveGame, so waiting autosaves of the progress before them are saved right away:
+	if (!PendingLoadRequestsBySlot.IsEmpty())
 	{
-		auto RequestToProcess = PendingSaveRequestsBySlot.CreateIterator();
-		const FSlotName SlotName = RequestToProcess.Key();
-		SaveRequestsInProgress += RequestToProcess.Value();
-		for (TSharedRef<ISaveLoadRequest> Request : RequestToProcess.Value())
+		AutosaveDebounceBySlot.Empty();
+	}
+
+	// Debounced autosaves wait until no further autosave was requested for a while, without blocking saves of other slots:
+	auto SaveRequestToProcess = PendingSaveRequestsBySlot.CreateIterator();
+	while (SaveRequestToProcess && (IsAutosaveDebounced(SaveRequestToProcess.Key()) || SlotsBeingDeleted.Contains(SaveRequestToProcess.Key())))
+	{
+		++SaveRequestToProcess;
+	}
+	ScheduleDebouncedAutosaves();
+
+	if (ActiveSaveLocks.IsEmpty() && SaveRequestToProcess)
+	{
+		// Saves are exclusive: Wait until all loads in progress are done, but don't start any further loads before the save.
+		if (IsBusyLoading())
+			return;
+
+		// (i) All pending requests of the slot are completed by the same save.
+		const FSlotName SlotName = SaveRequestToProcess.Key();
+		AutosaveDebounceBySlot.Remove(SlotName);
+		UE_CLOG(SaveRequestToProcess.Value().Num() > 1, LogSaveGameService, Verbose, TEXT("Coalesced %d save requests for slot %s into one save."),
+			SaveRequestToProcess.Value().Num(), *SlotName);
+		SaveRequestsInProgress += SaveRequestToProcess.Value();
+		for (TSharedRef<ISaveLoadRequest> Request : SaveRequestToProcess.Value())
 		{
 			Request->Process();
 		}
-		RequestToProcess.RemoveCurrent();
+		SaveRequestToProcess.RemoveCurrent();
+		UpdateRequestStats();
 
 		PerformAsyncSave(SlotName);
 		return;
 	}
 
-	if (IsLoadingAllowed() && PendingLoadRequestsBySlot.Num() > 0)
+	if (!ActiveLoadLocks.IsEmpty())
+		return;
+
+	// Loads of different slots may run concurrently, but only one at a time per slot to keep their order:
+	const int32 MaxConcurrentLoads = FMath::Max<int32>(GetDefault<USaveGameServiceSettings>()->MaxConcurrentLoads, 1);
+	TArray<FSlotName> SlotNamesToLoad = {};
+	for (auto RequestToProcess = PendingLoadRequestsBySlot.CreateIterator(); RequestToProcess && LoadRequestsInProgressBySlot.Num() < MaxConcurrentLoads; ++RequestToProcess)
 	{
-		auto RequestToProcess = PendingLoadRequestsBySlot.CreateIterator();
 		const FSlotName SlotName = RequestToProcess.Key();
-		LoadRequestsInProgress += RequestToProcess.Value();
+		if (LoadRequestsInProgressBySlot.Contains(SlotName) || SlotsBeingDeleted.Contains(SlotName))
+			continue;
+
+		LoadRequestsInProgressBySlot.Add(SlotName, RequestToProcess.Value());
 		for (TSharedRef<ISaveLoadRequest> Request : RequestToProcess.Value())
 		{
 			Request->Process();
 		}
 		RequestToProcess.RemoveCurrent();
+		SlotNamesToLoad.Add(SlotName);
+	}
+	UpdateRequestStats();
 
+	// (i) Loads are only performed after iterating, since they may complete (and process further requests) immediately.
+	for (const FSlotName& SlotName : SlotNamesToLoad)
+	{
 		PerformAsyncLoad(SlotName);
-		return;
 	}
 }
 
@@ -407,7 +510,7 @@ FSaveLoadLockHandle USaveGameService::LockAutosaving(const UObject& KeyHolder, c
 	FSaveLoadLock& NewLock = ActiveAutosaveLocks.Add(NewKey);
 	NewLock.KeyHolder = MakeWeakObjectPtr(&KeyHolder);
 	NewLock.ContextString = Context;
-	AddDebugEntry("LockAutosaving", FString::Printf(TEXT("KeyHolder: %s, Context: %s, Key: %s"), *KeyHolder.GetName(), *Context, *NewKey.ToString()));
+	AddLockDebugEntry(ESaveGameDebugEvent::LockAutosaving, Context, NewKey, &KeyHolder);
 	return NewKey;
 }
 
@@ -417,7 +520,7 @@ void USaveGameService::UnlockAutosaving(const FSaveLoadLockHandle& Key, const FD
 		return;
 
 	ActiveAutosaveLocks.Remove(Key);
-	AddDebugEntry("UnlockAutosaving", FString::Printf(TEXT("Context: %s, Key: %s"), *Context, *Key.ToString()));
+	AddLockDebugEntry(ESaveGameDebugEvent::UnlockAutosaving, Context, Key);
 	ProcessPendingRequests();
 }
 
@@ -427,7 +530,7 @@ FSaveLoadLockHandle USaveGameService::LockSaving(const UObject& KeyHolder, const
 	FSaveLoadLock& NewLock = ActiveSaveLocks.Add(NewKey);
 	NewLock.KeyHolder = MakeWeakObjectPtr(&KeyHolder);
 	NewLock.ContextString = Context;
-	AddDebugEntry("LockSaving", FString::Printf(TEXT("KeyHolder: %s, Context: %s, Key: %s"), *KeyHolder.GetName(), *Context, *NewKey.ToString()));
+	AddLockDebugEntry(ESaveGameDebugEvent::LockSaving, Context, NewKey, &KeyHolder);
 	return NewKey;
 }
 
@@ -437,7 +540,7 @@ void USaveGameService::UnlockSaving(const FSaveLoadLockHandle& Key, const FDebug
 		return;
 
 	ActiveSaveLocks.Remove(Key);
-	AddDebugEntry("UnlockSaving", FString::Printf(TEXT("Context: %s, Key: %s"), *Context, *Key.ToString()));
+	AddLockDebugEntry(ESaveGameDebugEvent::UnlockSaving, Context, Key);
 	ProcessPendingRequests();
 }
 
@@ -447,7 +550,7 @@ FSaveLoadLockHandle USaveGameService::LockLoading(const UObject& KeyHolder, cons
 	FSaveLoadLock& NewLock = ActiveLoadLocks.Add(NewKey);
 	NewLock.KeyHolder = MakeWeakObjectPtr(&KeyHolder);
 	NewLock.ContextString = Context;
-	AddDebugEntry("LockLoading", FString::Printf(TEXT("KeyHolder: %s, Context: %s, Key: %s"), *KeyHolder.GetName(), *Context, *NewKey.ToString()));
+	AddLockDebugEntry(ESaveGameDebugEvent::LockLoading, Context, NewKey, &KeyHolder);
 	return NewKey;
 }
 
@@ -457,7 +560,7 @@ void USaveGameService::UnlockLoading(const FSaveLoadLockHandle& Key, const FDebu
 		return;
 
 	ActiveLoadLocks.Remove(Key);
-	AddDebugEntry("UnlockLoading", FString::Printf(TEXT("Context: %s, Key: %s"), *Context, *Key.ToString()));
+	AddLockDebugEntry(ESaveGameDebugEvent::UnlockLoading, Context, Key);
 	ProcessPendingRequests();
 }
 
@@ -478,7 +581,7 @@ bool USaveGameService::IsLoadingAllowed() const
 
 bool USaveGameService::IsBusyLoading() const
 {
-	return (LoadRequestsInProgress.Num() > 0);
+	return (LoadRequestsInProgressBySlot.Num() > 0);
 }
 
 bool USaveGameService::IsBusySaving() const
@@ -565,6 +668,7 @@ void USaveGameService::StartService()
 	const USaveGameServiceSettings& Settings = *GetDefault<USaveGameServiceSettings>();
 	DebugHistoryEntriesToKeep = Settings.DebugHistoryEntriesToKeep;
 	DebugHistory.Empty(DebugHistoryEntriesToKeep);
+	DebugHistoryHead = 0;
 
 	SaveLoadBehavior = &CreateSaveLoadBehavior(Settings);
 	SaveGameSerializer = &CreateSaveGameSerializer();
@@ -607,17 +711,41 @@ void USaveGameService::ShutdownService()
 
 	CurrentSaveGame.Reset();
 	CachedSaveGames.Clear();
+	CachedHeaderDataBySlot.Empty();
 
 	PendingSaveRequestsBySlot.Empty();
 	PendingLoadRequestsBySlot.Empty();
+	for (const TPair<FGuid, TSharedRef<ISaveLoadRequest>>& Itr : AliveSaveRequestsByHandle)
+	{
+		Itr.Value->State = ISaveLoadRequest::EState::Cancelled;
+	}
+	for (const TPair<FGuid, TSharedRef<ISaveLoadRequest>>& Itr : AliveLoadRequestsByHandle)
+	{
+		Itr.Value->State = ISaveLoadRequest::EState::Cancelled;
+	}
+	AliveSaveRequestsByHandle.Empty();
+	AliveLoadRequestsByHandle.Empty();
+	UpdateRequestStats();
+
+	AutosaveDebounceBySlot.Empty();
+	if (AutosaveDebounceTickerHandle.IsSet())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(*AutosaveDebounceTickerHandle);
+		AutosaveDebounceTickerHandle.Reset();
+	}
 
 	while (SaveRequestsInProgress.Num() > 0)
 	{
 		SaveRequestsInProgress.Pop()->Cancel();
 	}
-	while (LoadRequestsInProgress.Num() > 0)
+	TMap<FSlotName, TArray<TSharedRef<ISaveLoadRequest>>> LoadRequestsToCancel = MoveTemp(LoadRequestsInProgressBySlot);
+	LoadRequestsInProgressBySlot.Empty();
+	for (const TTuple<FSlotName, TArray<TSharedRef<ISaveLoadRequest>>>& RequestsBySlotName : LoadRequestsToCancel)
 	{
-		LoadRequestsInProgress.Pop()->Cancel();
+		for (const TSharedRef<ISaveLoadRequest>& Request : RequestsBySlotName.Value)
+		{
+			Request->Cancel();
+		}
 	}
 
 	FWorldDelegates::OnPostWorldInitialization.RemoveAll(this);
@@ -632,19 +760,31 @@ FAsyncSaveGameHandle USaveGameService::EnqueueSaveRequest(const FSlotName& SlotN
 		return FAsyncSaveGameHandle();
 	}
 
+	Request->SlotName = SlotName;
+	Request->EnqueueTime = FPlatformTime::Seconds();
 	PendingSaveRequestsBySlot.FindOrAdd(SlotName).Emplace(Request);
+	AliveSaveRequestsByHandle.Add(Request->Handle, Request);
+	UpdateAutosaveDebounce(SlotName, *Request);
+	UpdateRequestStats();
 	ProcessPendingRequests();
 	return Request->Handle;
 }
 
 void USaveGameService::ConsumeSaveRequestsInProgress(USaveGame* SavedSaveGame, bool bSuccess)
 {
-	for (const TSharedRef<ISaveLoadRequest>& SaveRequest : SaveRequestsInProgress)
+	TArray<TSharedRef<ISaveLoadRequest>> SaveRequests = MoveTemp(SaveRequestsInProgress);
+	SaveRequestsInProgress.Reset();
+	for (const TSharedRef<ISaveLoadRequest>& SaveRequest : SaveRequests)
 	{
-		SaveRequest->Finish(SavedSaveGame, bSuccess);
+		SaveRequest->State = ISaveLoadRequest::EState::Completed;
+		AliveSaveRequestsByHandle.Remove(SaveRequest->Handle);
 	}
+	UpdateRequestStats();
 
-	SaveRequestsInProgress.Empty();
+	for (const TSharedRef<ISaveLoadRequest>& SaveRequest : SaveRequests)
+	{
+		SaveRequest->Finish(SavedSaveGame, bSuccess);
+	}
 }
 
 FAsyncLoadGameHandle USaveGameService::EnqueueLoadRequest(const FSlotName& SlotName, const TSharedRef<ISaveLoadRequest>& Request, bool bCancelIfLoadingIsNotAllowed)
@@ -661,21 +801,134 @@ FAsyncLoadGameHandle USaveGameService::EnqueueLoadRequest(const FSlotName& SlotN
 	}
 	else
 	{
+		Request->SlotName = SlotName;
+		Request->EnqueueTime = FPlatformTime::Seconds();
 		PendingLoadRequestsBySlot.FindOrAdd(SlotName).Emplace(Request);
+		AliveLoadRequestsByHandle.Add(Request->Handle, Request);
+		UpdateRequestStats();
 		ProcessPendingRequests();
 	}
 
 	return Request->Handle;
 }
 
-void USaveGameService::ConsumeLoadRequestsInProgress(USaveGame* LoadedSaveGame, bool bSuccess)
+void USaveGameService::ConsumeLoadRequestsInProgress(const FSlotName& SlotName, USaveGame* LoadedSaveGame, bool bSuccess)
 {
-	for (const TSharedRef<ISaveLoadRequest>& LoadRequest : LoadRequestsInProgress)
+	TArray<TSharedRef<ISaveLoadRequest>> LoadRequests = {};
+	LoadRequestsInProgressBySlot.RemoveAndCopyValue(SlotName, OUT LoadRequests);
+	for (const TSharedRef<ISaveLoadRequest>& LoadRequest : LoadRequests)
+	{
+		LoadRequest->State = ISaveLoadRequest::EState::Completed;
+		AliveLoadRequestsByHandle.Remove(LoadRequest->Handle);
+	}
+	UpdateRequestStats();
+
+	for (const TSharedRef<ISaveLoadRequest>& LoadRequest : LoadRequests)
 	{
 		LoadRequest->Finish(LoadedSaveGame, bSuccess);
 	}
+}
+
+void USaveGameService::CancelQueuedRequest(const FGuid& Handle, TMap<FGuid, TSharedRef<ISaveLoadRequest>>& AliveRequestsByHandle, TMap<FSlotName, TArray<TSharedRef<ISaveLoadRequest>>>& PendingRequestsBySlot)
+{
+	// (i) Requests that are already in progress can't be cancelled anymore.
+	const TSharedRef<ISaveLoadRequest>* FoundRequest = AliveRequestsByHandle.Find(Handle);
+	if (!FoundRequest || (*FoundRequest)->State != ISaveLoadRequest::EState::Queued)
+		return;
 
-	LoadRequestsInProgress.Empty();
+	const TSharedRef<ISaveLoadRequest> Request = *FoundRequest;
+	AliveRequestsByHandle.Remove(Handle);
+	if (TArray<TSharedRef<ISaveLoadRequest>>* SlotRequests = (Request->SlotName.IsSet() ? PendingRequestsBySlot.Find(*Request->SlotName) : nullptr))
+	{
+		SlotRequests->Remove(Request);
+		if (SlotRequests->IsEmpty())
+		{
+			PendingRequestsBySlot.Remove(*Request->SlotName);
+		}
+	}
+	UpdateRequestStats();
+
+	Request->State = ISaveLoadRequest::EState::Cancelled;
+	Request->Cancel();
+}
+
+void USaveGameService::UpdateAutosaveDebounce(const FSlotName& SlotName, const ISaveLoadRequest& Request)
+{
+	// Any other save request to the slot is processed right away, together with the autosave requests that were waiting:
+	const float DebounceSeconds = GetDefault<USaveGameServiceSettings>()->AutosaveDebounceSeconds;
+	if (!Request.bIsAutosave || DebounceSeconds <= 0.0f)
+	{
+		AutosaveDebounceBySlot.Remove(SlotName);
+		return;
+	}
+
+	if (FAutosaveDebounce* Debounce = AutosaveDebounceBySlot.Find(SlotName))
+	{
+		Debounce->LastRequestTime = Request.EnqueueTime;
+	}
+	else
+	{
+		AutosaveDebounceBySlot.Add(SlotName, { Request.EnqueueTime, Request.EnqueueTime });
+	}
+}
+
+bool USaveGameService::IsAutosaveDebounced(const FSlotName& SlotName) const
+{
+	const FAutosaveDebounce* Debounce = AutosaveDebounceBySlot.Find(SlotName);
+	if (!Debounce)
+		return false;
+
+	const USaveGameServiceSettings* Settings = GetDefault<USaveGameServiceSettings>();
+	const double Now = FPlatformTime::Seconds();
+	return (Now - Debounce->LastRequestTime < Settings->AutosaveDebounceSeconds && Now - Debounce->FirstRequestTime < Settings->AutosaveMaxLatencySeconds);
+}
+
+void USaveGameService::ScheduleDebouncedAutosaves()
+{
+	if (AutosaveDebounceTickerHandle.IsSet() || AutosaveDebounceBySlot.IsEmpty())
+		return;
+
+	// (i) Autosaves that are no longer debounced but still waiting for another save are processed once that save completes.
+	const USaveGameServiceSettings* Settings = GetDefault<USaveGameServiceSettings>();
+	const double Now = FPlatformTime::Seconds();
+	double NextProcessTime = MAX_dbl;
+	for (const TPair<FSlotName, FAutosaveDebounce>& Itr : AutosaveDebounceBySlot)
+	{
+		const double ProcessTime = FMath::Min(Itr.Value.LastRequestTime + Settings->AutosaveDebounceSeconds,
+			Itr.Value.FirstRequestTime + Settings->AutosaveMaxLatencySeconds);
+		if (ProcessTime > Now)
+		{
+			NextProcessTime = FMath::Min(NextProcessTime, ProcessTime);
+		}
+	}
+	if (NextProcessTime == MAX_dbl)
+		return;
+
+	// (i) Further requests don't reschedule the ticker: If it fires too early, processing just schedules it again.
+	const float Delay = static_cast<float>(NextProcessTime - Now);
+	AutosaveDebounceTickerHandle = FTSTicker::GetCoreTicker().AddTicker(TEXT("USaveGameService::DebouncedAutosave"), Delay,
+		[WeakThis = MakeWeakObjectPtr(this)](float)
+		{
+			if (USaveGameService* StrongThis = WeakThis.Get())
+			{
+				StrongThis->AutosaveDebounceTickerHandle.Reset();
+				StrongThis->ProcessPendingRequests();
+			}
+			return false; // = Don't restart timer.
+		});
+}
+
+void USaveGameService::UpdateRequestStats() const
+{
+#if STATS
+	int32 NumRequestsInProgress = SaveRequestsInProgress.Num();
+	for (const TPair<FSlotName, TArray<TSharedRef<ISaveLoadRequest>>>& Itr : LoadRequestsInProgressBySlot)
+	{
+		NumRequestsInProgress += Itr.Value.Num();
+	}
+	SET_DWORD_STAT(STAT_SaveGameService_QueuedRequests, AliveSaveRequestsByHandle.Num() + AliveLoadRequestsByHandle.Num() - NumRequestsInProgress);
+	SET_DWORD_STAT(STAT_SaveGameService_RequestsInProgress, NumRequestsInProgress);
+#endif
 }
 
 USaveGameService::FSlotName USaveGameService::GetAutosaveSlotName() const
@@ -691,22 +944,40 @@ TOptional<USaveGameService::FSlotName> USaveGameService::GetMostRecentlySavedSlo
 
 const USaveGame* USaveGameService::GetCachedSaveGameSnapshotAtSlot(const FSlotName& SlotName) const
 {
-	return CachedSaveGames.Find(SlotName);
+	return CachedSaveGames.Find(*this, SlotName);
 }
 
 TMap<USaveGameService::FSlotName, const USaveGame*> USaveGameService::GetAllCachedSaveGameSnapshots() const
 {
-	return CachedSaveGames.GetAllObjectsBySlot();
+	return CachedSaveGames.GetAllObjectsBySlot(*this);
 }
 
 bool USaveGameService::IsCachedSaveGameSnapshot(const USaveGame& SaveGameObject) const
 {
-	return CachedSaveGames.GetAllObjectsBySlot().FindKey(&SaveGameObject) != nullptr;
+	return CachedSaveGames.IsSnapshotObject(SaveGameObject);
 }
 
 bool USaveGameService::HasAnyCachedSaveGameSnapshot() const
 {
-	return GetAllCachedSaveGameSnapshots().Num() > 0;
+	return (CachedSaveGames.Num() > 0);
+}
+
+const FInstancedStruct* USaveGameService::GetCachedHeaderDataAtSlot(const FSlotName& SlotName) const
+{
+	return CachedHeaderDataBySlot.Find(SlotName);
+}
+
+bool USaveGameService::HasAnyCachedHeaderData() const
+{
+	return (CachedHeaderDataBySlot.Num() > 0);
+}
+
+void USaveGameService::UpdateCachedHeaderData(const FSlotName& SlotName)
+{
+	if (const FInstancedStruct* HeaderData = CachedSaveGames.FindHeaderData(SlotName))
+	{
+		CachedHeaderDataBySlot.Add(SlotName, *HeaderData);
+	}
 }
 
 bool USaveGameService::DoesSaveFileExist(const FSlotName& SlotName) const
@@ -727,8 +998,8 @@ TSet<USaveGameService::FSlotName> USaveGameService::GetSlotNamesAllowedForLoadin
 	TSet<FSlotName> Result = {};
 	for (const FSlotName& SlotName : SaveLoadBehavior->GetSaveSlotNamesAllowedForLoading(GetCurrentSaveGame()))
 	{
-		// Check if file exists and if the preloaded savegame is loadable:
-		if (DoesSaveFileExist(SlotName) && CachedSaveGames.Contains(SlotName))
+		// Check if file exists and if the preloaded savegame (or at least its header) is loadable:
+		if ((CachedSaveGames.Contains(SlotName) || CachedHeaderDataBySlot.Contains(SlotName)) && DoesCatalogedSaveFileExist(SlotName))
 		{
 			Result.Add(SlotName);
 		}
@@ -739,7 +1010,7 @@ TSet<USaveGameService::FSlotName> USaveGameService::GetSlotNamesAllowedForLoadin
 
 void USaveGameService::AddDebugEntry(const UObject& Owner, const FString& Entry)
 {
-	AddDebugEntry(FString::Printf(TEXT("[%s] %s"), *Owner.GetPathName(Owner.GetWorld()), *Entry));
+	AddDebugEntry(ESaveGameDebugEvent::Custom, FString::Printf(TEXT("[%s] %s"), *Owner.GetPathName(Owner.GetWorld()), *Entry));
 }
 
 void USaveGameService::PerformAsyncSave(const FSlotName& SlotName)
@@ -765,8 +1036,23 @@ void USaveGameService::HandleAsyncSaveCompleted(const FSlotName& SlotName, const
 	CurrentSaveGame.UpdateTimeOfLastSave();
 	CurrentSaveGame.SetSlotLastSavedTo(SlotName);
 
-	// Cache current save game as snapshot copy, so it can be restored as the state it was saved in:
-	CachedSaveGames.CopyToCache(*this, SlotName, CurrentSaveGame.GetRef());
+	// Cache current save game as snapshot copy, so it can be restored as the state it was saved in.
+	// If possible, the bytes that were just written are reused instead of serializing the SaveGame again:
+	const TSharedPtr<const TArray<uint8>> SavedData = SaveGameSerializer->GetLastSavedData();
+	if (bSuccess && SavedData.IsValid())
+	{
+		CachedSaveGames.CopyToCache(*this, SlotName, SavedData.ToSharedRef());
+	}
+	else
+	{
+		CachedSaveGames.CopyToCache(*this, SlotName, CurrentSaveGame.GetRef());
+	}
+	UpdateCachedHeaderData(SlotName);
+	if (bSuccess)
+	{
+		// (i) The new file timestamp is unknown here, so the next catalog refresh treats the slot as changed.
+		SlotCatalog.Add(SlotName, FSlotCatalogEntry{true, FDateTime::MinValue()});
+	}
 	OnAvailableSaveGamesChanged.Broadcast();
 
 	ConsumeSaveRequestsInProgress(CurrentSaveGame.GetMutablePtr(), bSuccess);
@@ -779,12 +1065,15 @@ void USaveGameService::HandleAsyncSaveCompleted(const FSlotName& SlotName, const
 
 void USaveGameService::PerformAsyncLoad(const FSlotName& SlotName)
 {
+	const int32& UserIndex = GetCurrentUserIndex();
 	if (!DoesSaveFileExist(SlotName))
+	{
+		HandleAsyncLoadCompleted(SlotName, UserIndex, nullptr);
 		return;
+	}
 
 	SetStatus(EStatus::Loading);
 
-	const int32& UserIndex = GetCurrentUserIndex();
 	SaveGameSerializer->AsyncLoadGameFromSlot(SlotName, UserIndex,
 		USaveGameSerializer::FOnAsyncLoadCompleted::CreateUObject(this, &ThisClass::HandleAsyncLoadCompleted));
 }
@@ -798,6 +1087,7 @@ USaveGame* USaveGameService::PerformSyncLoad(const FSlotName& SlotName)
 	if (LoadedSaveGame && !CachedSaveGames.Contains(SlotName))
 	{
 		CachedSaveGames.CopyToCache(*this, SlotName, *LoadedSaveGame);
+		UpdateCachedHeaderData(SlotName);
 		OnAvailableSaveGamesChanged.Broadcast();
 	}
 
@@ -810,12 +1100,16 @@ void USaveGameService::HandleAsyncLoadCompleted(const FSlotName& SlotName, const
 	if (IsValid(LoadedSaveGame) && !CachedSaveGames.Contains(SlotName))
 	{
 		CachedSaveGames.CopyToCache(*this, SlotName, *LoadedSaveGame);
+		UpdateCachedHeaderData(SlotName);
 		OnAvailableSaveGamesChanged.Broadcast();
 	}
 
-	ConsumeLoadRequestsInProgress(LoadedSaveGame, IsValid(LoadedSaveGame));
+	ConsumeLoadRequestsInProgress(SlotName, LoadedSaveGame, IsValid(LoadedSaveGame));
 
-	SetStatus(EStatus::Idle);
+	if (!IsBusySavingOrLoading())
+	{
+		SetStatus(EStatus::Idle);
+	}
 	ProcessPendingRequests();
 }
 
@@ -913,26 +1207,91 @@ void USaveGameService::SetStatus(const EStatus& NewStatus)
 	OnStatusChanged.Broadcast(NewStatus);
 }
 
-void USaveGameService::AddDebugEntry(const FString& Entry)
+void USaveGameService::AddDebugEntry(FSaveGameDebugHistoryEntry&& Entry)
 {
-	DebugHistory.Add(FString::Printf(TEXT("(%s UTC)\t %s"), *FDateTime::UtcNow().ToString(), *Entry));
-	UE_LOG(LogSaveGameService, Verbose, TEXT("%s"), *Entry);
+	// (i) UE_LOG only evaluates its arguments when the verbosity is active, so entries are not formatted otherwise.
+	UE_LOG(LogSaveGameService, Verbose, TEXT("%s"), *LexToString(Entry));
+
+	if (DebugHistoryEntriesToKeep == 0)
+		return;
 
-	while (DebugHistory.Num() >= DebugHistoryEntriesToKeep)
+	if (DebugHistory.Num() < DebugHistoryEntriesToKeep)
 	{
-		// Shrink head-first to fit desired size:
-		DebugHistory.RemoveAt(0);
+		DebugHistory.Add(MoveTemp(Entry));
+		return;
 	}
+
+	// Overwrite the oldest entry, which makes the next one the oldest:
+	DebugHistory[DebugHistoryHead] = MoveTemp(Entry);
+	DebugHistoryHead = (DebugHistoryHead + 1) % DebugHistory.Num();
+}
+
+void USaveGameService::AddDebugEntry(ESaveGameDebugEvent Event, const FDebugContext& Context, const FSlotName& SlotName)
+{
+	FSaveGameDebugHistoryEntry Entry;
+	Entry.Event = Event;
+	Entry.Timestamp = FDateTime::UtcNow();
+	Entry.SlotName = SlotName;
+	Entry.Context = Context;
+	AddDebugEntry(MoveTemp(Entry));
+}
+
+void USaveGameService::AddDebugEntry(ESaveGameDebugEvent Event, const FDebugContext& Context, const FSlotName& SlotName, bool bSuccess, double ExecTime, int64 NumBytes)
+{
+	FSaveGameDebugHistoryEntry Entry;
+	Entry.Event = Event;
+	Entry.bSuccess = bSuccess;
+	Entry.Timestamp = FDateTime::UtcNow();
+	Entry.Duration = ExecTime;
+	Entry.NumBytes = NumBytes;
+	Entry.SlotName = SlotName;
+	Entry.Context = Context;
+	AddDebugEntry(MoveTemp(Entry));
+}
+
+void USaveGameService::AddLockDebugEntry(ESaveGameDebugEvent Event, const FDebugContext& Context, const FSaveLoadLockHandle& Key, const UObject* KeyHolder)
+{
+	FSaveGameDebugHistoryEntry Entry;
+	Entry.Event = Event;
+	Entry.Timestamp = FDateTime::UtcNow();
+	Entry.Context = Context;
+	Entry.LockKey = Key;
+	Entry.KeyHolder = (KeyHolder ? KeyHolder->GetFName() : NAME_None);
+	AddDebugEntry(MoveTemp(Entry));
+}
+
+void USaveGameService::AddDebugEntry(const FString& Entry)
+{
+	AddDebugEntry(ESaveGameDebugEvent::Custom, Entry);
 }
 
 void USaveGameService::AddDebugEntry(const FString& Operation, const FDebugContext& Context)
 {
-	AddDebugEntry(FString::Printf(TEXT("[%s] %s"), *Operation, *Context));
+	AddDebugEntry(ESaveGameDebugEvent::Custom, FString::Printf(TEXT("[%s] %s"), *Operation, *Context));
 }
 
 void USaveGameService::AddDebugEntry(const FString& Operation, const FDebugContext& Context, bool bSuccess, double ExecTime)
 {
-	AddDebugEntry(FString::Printf(TEXT("[%s] %s (took %.3f sec): %s"), *Operation, (bSuccess ? TEXT("succeeded") : TEXT("failed")), ExecTime, *Context));
+	AddDebugEntry(ESaveGameDebugEvent::Custom, FString::Printf(TEXT("[%s] %s"), *Operation, *Context), FSlotName(), bSuccess, ExecTime);
+}
+
+TArray<FString> USaveGameService::GetDebugHistory() const
+{
+	TArray<FString> Result = {};
+	Result.Reserve(DebugHistory.Num());
+	ForEachDebugHistoryEntry([&Result](const FSaveGameDebugHistoryEntry& Entry)
+	{
+		Result.Add(FString::Printf(TEXT("(%s UTC)\t %s"), *Entry.Timestamp.ToString(), *LexToString(Entry)));
+	});
+	return Result;
+}
+
+void USaveGameService::ForEachDebugHistoryEntry(TFunctionRef<void(const FSaveGameDebugHistoryEntry&)> Visitor) const
+{
+	for (int32 Offset = 0; Offset < DebugHistory.Num(); ++Offset)
+	{
+		Visitor(DebugHistory[(DebugHistoryHead + Offset) % DebugHistory.Num()]);
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -940,52 +1299,134 @@ void USaveGameService::AddDebugEntry(const FString& Operation, const FDebugConte
 
 bool USaveGameService::FSaveGamesCache::Contains(const FSlotName& SlotName) const
 {
-	return SnapshotsBySlot.Num() > 0 && SnapshotsBySlot.Contains(SlotName);
+	return SnapshotsBySlot.Contains(SlotName);
+}
+
+int32 USaveGameService::FSaveGamesCache::Num() const
+{
+	return SnapshotsBySlot.Num();
 }
 
 void USaveGameService::FSaveGamesCache::Remove(const FSlotName& SlotName)
 {
-	SnapshotsBySlot.Remove(SlotName);
+	if (const FSnapshot* Snapshot = SnapshotsBySlot.Find(SlotName))
+	{
+		SnapshotObjects.Remove(Snapshot->Object.Get());
+		SnapshotsBySlot.Remove(SlotName);
+	}
 }
 
 void USaveGameService::FSaveGamesCache::Clear()
 {
 	SnapshotsBySlot.Empty();
+	SnapshotObjects.Empty();
+}
+
+void USaveGameService::FSaveGamesCache::CopyToCache(const USaveGameService& InService, const FSlotName& SlotName, USaveGame& SaveGame)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("USaveGameService.FSaveGamesCache.CopyToCache"), STAT_SaveGamesCache_CopyToCache, STATGROUP_SaveGame);
+
+	TSharedRef<TArray<uint8>> SaveData = MakeShared<TArray<uint8>>();
+	if (!InService.SaveGameSerializer->TrySerializeSaveGame(SaveGame, OUT *SaveData))
+	{
+		UE_LOG(LogSaveGameService, Warning, TEXT("Failed to cache snapshot of SaveGame %s for slot %s"), *SaveGame.GetName(), *SlotName);
+		Remove(SlotName);
+		return;
+	}
+
+	const UModularSaveGame* ModularSaveGame = Cast<UModularSaveGame>(&SaveGame);
+	FInstancedStruct HeaderData = (ModularSaveGame && ModularSaveGame->GetInstancedHeaderData().IsValid()) ?
+		*ModularSaveGame->GetInstancedHeaderData() : FInstancedStruct();
+	AddSnapshot(InService, SlotName, SaveData, MoveTemp(HeaderData));
 }
 
-void USaveGameService::FSaveGamesCache::CopyToCache(USaveGameService& InService, const FSlotName& SlotName, const USaveGame& SaveGame)
+void USaveGameService::FSaveGamesCache::CopyToCache(const USaveGameService& InService, const FSlotName& SlotName, const TSharedRef<const TArray<uint8>>& SaveData)
 {
-	const USaveGame& Copy = InService.SaveLoadBehavior->DuplicateSaveGameObject(InService, SaveGame);
-	SnapshotsBySlot.FindOrAdd(SlotName) = TStrongObjectPtr(&Copy);
+	FInstancedStruct HeaderData = {};
+	InService.SaveGameSerializer->TryDeserializeHeaderData(*SaveData, OUT HeaderData);
+	AddSnapshot(InService, SlotName, SaveData, MoveTemp(HeaderData));
 }
 
-USaveGame* USaveGameService::FSaveGamesCache::CopyFromCache(USaveGameService& InService, const FSlotName& SlotName) const
+USaveGame* USaveGameService::FSaveGamesCache::CopyFromCache(const USaveGameService& InService, const FSlotName& SlotName) const
 {
-	if (!Contains(SlotName))
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("USaveGameService.FSaveGamesCache.CopyFromCache"), STAT_SaveGamesCache_CopyFromCache, STATGROUP_SaveGame);
+
+	const FSnapshot* Snapshot = SnapshotsBySlot.Find(SlotName);
+	if (!Snapshot)
 		return nullptr;
-	USaveGame& Copy = InService.SaveLoadBehavior->DuplicateSaveGameObject(InService, *SnapshotsBySlot[SlotName].Get());
-	return &Copy;
+
+	USaveGame* Copy = nullptr;
+	InService.SaveGameSerializer->TryDeserializeSaveGame(*Snapshot->SaveData, OUT Copy);
+	return Copy;
 }
 
-const USaveGame* USaveGameService::FSaveGamesCache::Find(const FSlotName& SlotName) const
+const USaveGame* USaveGameService::FSaveGamesCache::Find(const USaveGameService& InService, const FSlotName& SlotName) const
 {
-	return SnapshotsBySlot.Contains(SlotName) ? SnapshotsBySlot[SlotName].Get() : nullptr;
+	const FSnapshot* Snapshot = SnapshotsBySlot.Find(SlotName);
+	if (!Snapshot)
+		return nullptr;
+
+	if (!Snapshot->Object.IsValid())
+	{
+		// Materialize the snapshot object on first access, which is then kept until the snapshot is replaced:
+		USaveGame* SnapshotObject = CopyFromCache(InService, SlotName);
+		if (!SnapshotObject)
+			return nullptr;
+
+		Snapshot->Object = TStrongObjectPtr<const USaveGame>(SnapshotObject);
+		SnapshotObjects.Add(SnapshotObject);
+	}
+	return Snapshot->Object.Get();
 }
 
-///////////////////////////////////////////////////////////////////////////////////////
-/// REQUESTS
+int64 USaveGameService::FSaveGamesCache::GetSaveDataSize(const FSlotName& SlotName) const
+{
+	const FSnapshot* Snapshot = SnapshotsBySlot.Find(SlotName);
+	return (Snapshot && Snapshot->SaveData.IsValid()) ? Snapshot->SaveData->Num() : -1;
+}
+
+const FInstancedStruct* USaveGameService::FSaveGamesCache::FindHeaderData(const FSlotName& SlotName) const
+{
+	const FSnapshot* Snapshot = SnapshotsBySlot.Find(SlotName);
+	return (Snapshot && Snapshot->HeaderData.IsValid()) ? &Snapshot->HeaderData : nullptr;
+}
+
+bool USaveGameService::FSaveGamesCache::IsSnapshotObject(const USaveGame& SaveGame) const
+{
+	return SnapshotObjects.Contains(&SaveGame);
+}
+
+void USaveGameService::FSaveGamesCache::AddSnapshot(const USaveGameService& InService, const FSlotName& SlotName, const TSharedRef<const TArray<uint8>>& SaveData, FInstancedStruct&& HeaderData)
+{
+	Remove(SlotName);
+
+	FSnapshot& Snapshot = SnapshotsBySlot.Add(SlotName);
+	Snapshot.SaveData = SaveData;
+	Snapshot.HeaderData = MoveTemp(HeaderData);
+}
 
-TMap<USaveGameService::FSlotName, const USaveGame*> USaveGameService::FSaveGamesCache::GetAllObjectsBySlot() const
+TMap<USaveGameService::FSlotName, const USaveGame*> USaveGameService::FSaveGamesCache::GetAllObjectsBySlot(const USaveGameService& InService) const
 {
 	TMap<FSlotName, const USaveGame*> Result;
-	Algo::Transform(SnapshotsBySlot, OUT Result,
-		[](const TPair<FSlotName, TStrongObjectPtr<const USaveGame>>& Itr) { return TPair<FSlotName, const USaveGame*>(Itr.Key, Itr.Value.Get()); });
+	for (const TPair<FSlotName, FSnapshot>& Itr : SnapshotsBySlot)
+	{
+		if (const USaveGame* SnapshotObject = Find(InService, Itr.Key))
+		{
+			Result.Add(Itr.Key, SnapshotObject);
+		}
+	}
 	return Result;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////
+/// REQUESTS
+
+
 void USaveGameService::ISaveLoadRequest::Process()
 {
+	State = EState::InProgress;
 	StartTime = FPlatformTime::Seconds();
+	SET_FLOAT_STAT(STAT_SaveGameService_LastRequestWaitTime, (StartTime - EnqueueTime) * 1000.0);
 }
 
 void USaveGameService::ISaveLoadRequest::Finish(USaveGame* RequestedSaveGame, bool bSuccess)
@@ -1004,7 +1445,7 @@ void USaveGameService::FLoadToCurrentSaveGameRequest::Finish(USaveGame* Requeste
 	}
 
 	Runtime = FPlatformTime::Seconds() - StartTime;
-	Service.AddDebugEntry("LoadToCurrentSaveGameRequest", Context, bSuccess, Runtime);
+	Service.AddDebugEntry(ESaveGameDebugEvent::LoadRequestFinished, Context, SlotName.Get(""), bSuccess, Runtime, Service.CachedSaveGames.GetSaveDataSize(SlotName.Get("")));
 	ISaveLoadRequest::Finish(RequestedSaveGame, bSuccess);
 }
 
@@ -1016,14 +1457,14 @@ void USaveGameService::FLoadAndTravelIntoToCurrentSaveGameRequest::Finish(USaveG
 	}
 
 	Runtime = FPlatformTime::Seconds() - StartTime;
-	Service.AddDebugEntry("LoadAndTravelIntoToCurrentSaveGameRequest", Context, bSuccess, Runtime);
+	Service.AddDebugEntry(ESaveGameDebugEvent::LoadAndTravelRequestFinished, Context, SlotName.Get(""), bSuccess, Runtime, Service.CachedSaveGames.GetSaveDataSize(SlotName.Get("")));
 	ISaveLoadRequest::Finish(RequestedSaveGame, bSuccess);
 }
 
 void USaveGameService::FSaveCurrentSaveGameRequest::Finish(USaveGame* RequestedSaveGame, bool bSuccess)
 {
 	Runtime = FPlatformTime::Seconds() - StartTime;
-	Service.AddDebugEntry("SaveCurrentSaveGameRequest", Context, bSuccess, Runtime);
+	Service.AddDebugEntry(ESaveGameDebugEvent::SaveRequestFinished, Context, SlotName.Get(""), bSuccess, Runtime, Service.CachedSaveGames.GetSaveDataSize(SlotName.Get("")));
 	ISaveLoadRequest::Finish(RequestedSaveGame, bSuccess);
 }
 
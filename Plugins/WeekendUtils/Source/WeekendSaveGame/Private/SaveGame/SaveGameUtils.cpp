@@ -133,11 +133,16 @@ TArray<FString> USaveGameUtils::FindAllLocalSaveGameSlotNames()
 	TArray<FSlotName> Result = {};
 	{
 		TArray<FString> FoundFiles;
-		IFileManager::Get().FindFiles(OUT FoundFiles, *FString(FPaths::ProjectSavedDir() / "SaveGames"), TEXT(".sav"));
+		IFileManager::Get().FindFiles(OUT FoundFiles, *USaveGameSerializer::GetLocalSaveGamesDir(), TEXT(".sav"));
 		Result.Reserve(FoundFiles.Num());
 		for (const FString& Filename : FoundFiles)
 		{
-			Result.Add(FPaths::GetBaseFilename(Filename));
+			// (i) Backup slots belong to their slot, see USaveGameServiceSettings::bUseAtomicSlotWrites.
+			const FSlotName SlotName = FPaths::GetBaseFilename(Filename);
+			if (!USaveGameSerializer::IsBackupSlotName(SlotName))
+			{
+				Result.Add(SlotName);
+			}
 		}
 	}
 	return Result;
@@ -152,6 +157,13 @@ void USaveGameUtils::DeleteAllLocalSaveGames(int32 UserIndex)
 
 		UE_LOG(LogSaveGameUtils, Log, TEXT("DeleteAllLocalSaveGames: Deleting \"%s\" (user %d)"), *SlotName, UserIndex);
 		UGameplayStatics::DeleteGameInSlot(SlotName, UserIndex);
+
+		// Otherwise, the slot would be restored from its backup slot:
+		const FSlotName BackupSlotName = USaveGameSerializer::GetBackupSlotName(SlotName);
+		if (UGameplayStatics::DoesSaveGameExist(BackupSlotName, UserIndex))
+		{
+			UGameplayStatics::DeleteGameInSlot(BackupSlotName, UserIndex);
+		}
 	}
 }
 
@@ -104,6 +104,16 @@ TOptional<FDateTime> USaveLoadBehavior::FindTimeOfLastSaveFromSaveGame(const USa
 	return {};
 }
 
+TOptional<FDateTime> USaveLoadBehavior::FindTimeOfLastSaveFromHeaderData(const FInstancedStruct& HeaderData) const
+{
+	if (const FSimpleSaveGameHeaderData* SimpleHeaderData = HeaderData.GetPtr<FSimpleSaveGameHeaderData>(); (SimpleHeaderData && SimpleHeaderData->WasEverSaved()))
+	{
+		return SimpleHeaderData->UtcTimeOfLastSave;
+	}
+
+	return {};
+}
+
 bool USaveLoadBehavior::TryTravelToSavedLevel(const FCurrentSaveGame& SaveGame)
 {
 	const FSimpleSaveGameHeaderData* HeaderData = TryGetHeaderData(SaveGame);
@@ -139,12 +149,13 @@ UDefaultSaveLoadBehavior::UDefaultSaveLoadBehavior()
 
 void UDefaultSaveLoadBehavior::HandleGameStart(USaveGameService& SaveGameService)
 {
-	SaveGameService.PreloadSaveGamesAsync(GetSaveSlotNamesAllowedForLoading(SaveGameService.GetCurrentSaveGame()), USaveGameService::FOnPreloadCompleted::CreateWeakLambda(this,
-		[this, SaveGameService = MakeWeakObjectPtr(&SaveGameService)](const TArray<USaveGame*>& PreloadedSaveGames, const TArray<FSlotName>& PreloadedSlotNames)
+	// (i) Only the headers are read at first, since they contain everything needed to find the most recent SaveGame:
+	SaveGameService.ScanSaveGameHeadersAsync(GetSaveSlotNamesAllowedForLoading(SaveGameService.GetCurrentSaveGame()), USaveGameService::FOnHeaderScanCompleted::CreateWeakLambda(this,
+		[this, SaveGameService = MakeWeakObjectPtr(&SaveGameService)](const TMap<FSlotName, FInstancedStruct>& HeaderDataBySlot)
 		{
 			if (!SaveGameService.IsValid())
 				return;
-			HandlePreloadCompleted(*SaveGameService, PreloadedSaveGames, PreloadedSlotNames);
+			HandleHeaderScanCompleted(*SaveGameService, HeaderDataBySlot);
 		}));
 }
 
@@ -163,6 +174,37 @@ TSet<USaveLoadBehavior::FSlotName> UDefaultSaveLoadBehavior::GetSaveSlotNamesAll
 	return Result;
 }
 
+void UDefaultSaveLoadBehavior::HandleHeaderScanCompleted(USaveGameService& SaveGameService, const TMap<FSlotName, FInstancedStruct>& HeaderDataBySlot)
+{
+	// Attempt to find the most "recent" save game, then preload only that one:
+
+	TOptional<FDateTime> MostRecentSaveTime = {};
+	TOptional<FSlotName> MostRecentSlotName = {};
+	for (const TPair<FSlotName, FInstancedStruct>& Itr : HeaderDataBySlot)
+	{
+		TOptional<FDateTime> TimeOfLastSave = FindTimeOfLastSaveFromHeaderData(Itr.Value);
+		if (!TimeOfLastSave.IsSet())
+			continue;
+
+		if (!MostRecentSaveTime.IsSet() || ((*TimeOfLastSave) > (*MostRecentSaveTime)))
+		{
+			MostRecentSaveTime = TimeOfLastSave;
+			MostRecentSlotName = Itr.Key;
+		}
+	}
+
+	if (!MostRecentSlotName.IsSet())
+		return;
+
+	SaveGameService.PreloadSaveGamesAsync({ *MostRecentSlotName }, USaveGameService::FOnPreloadCompleted::CreateWeakLambda(this,
+		[this, SaveGameService = MakeWeakObjectPtr(&SaveGameService)](const TArray<USaveGame*>& PreloadedSaveGames, const TArray<FSlotName>& PreloadedSlotNames)
+		{
+			if (!SaveGameService.IsValid())
+				return;
+			HandlePreloadCompleted(*SaveGameService, PreloadedSaveGames, PreloadedSlotNames);
+		}));
+}
+
 void UDefaultSaveLoadBehavior::HandlePreloadCompleted(USaveGameService& SaveGameService, TArray<USaveGame*> PreloadedSaveGames, TArray<FSlotName> PreloadedSlotNames)
 {
 	// Attempt to find and restore the most "recent" save game:
@@ -29,6 +29,8 @@ void USaveGameListViewModel::BeginUsage(TSubclassOf<USaveGameSlotViewModel> Slot
 	SaveGameService = UseGameServiceAsWeakPtr<USaveGameService>();
 	SaveGameService->OnAvailableSaveGamesChanged.AddUObject(this, &ThisClass::Update);
 
+	// (i) The refresh runs in the background and calls Update() again for each slot that changed on disk.
+	SaveGameService->RefreshSlotCatalogAsync();
 	Update();
 }
 
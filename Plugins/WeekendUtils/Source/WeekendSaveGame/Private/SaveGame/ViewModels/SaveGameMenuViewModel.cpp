@@ -13,7 +13,8 @@
 
 bool USaveGameMenuViewModel::ShouldShowLoadButton() const
 {
-	return SaveGameService && SaveGameService->IsLoadingAllowed() && SaveGameService->HasAnyCachedSaveGameSnapshot();
+	return SaveGameService && SaveGameService->IsLoadingAllowed() &&
+		(SaveGameService->HasAnyCachedSaveGameSnapshot() || SaveGameService->HasAnyCachedHeaderData());
 }
 
 bool USaveGameMenuViewModel::ShouldShowSaveButton() const
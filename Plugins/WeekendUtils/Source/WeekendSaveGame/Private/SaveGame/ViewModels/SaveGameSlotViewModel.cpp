@@ -9,16 +9,25 @@
 
 #include "SaveGame/ViewModels/SaveGameSlotViewModel.h"
 
+#include "SaveGame/SaveGameHeader.h"
 #include "SaveGame/SaveGameService.h"
 
 void USaveGameSlotViewModel::BindToModel(const FSlotName& SlotName, USaveGameService& SaveGameService, bool bCanSave, bool bCanLoad)
 {
 	BoundSlotName = SlotName;
+	const FInstancedStruct* HeaderData = SaveGameService.GetCachedHeaderDataAtSlot(SlotName);
+	SetHeaderDataProperties(HeaderData);
+
 	if (const USaveGame* SaveGame = SaveGameService.GetCachedSaveGameSnapshotAtSlot(SlotName))
 	{
 		UE_MVVM_SET_PROPERTY_VALUE(bIsEmptySlot, false);
 		BindToSaveGame(SlotName, *SaveGame);
 	}
+	else if (HeaderData)
+	{
+		UE_MVVM_SET_PROPERTY_VALUE(bIsEmptySlot, false);
+		BindToSaveGameHeader(SlotName, *HeaderData);
+	}
 	else
 	{
 		UE_MVVM_SET_PROPERTY_VALUE(bIsEmptySlot, true);
@@ -41,3 +50,11 @@ bool USaveGameSlotViewModel::TrySaveGameToSlot()
 	ensureMsgf(!BoundSlotName.IsEmpty(), TEXT("SlotName should not be empty when trying to SaveGameToSlot"));
 	return (OnSaveRequested.IsBound() && OnSaveRequested.Execute(BoundSlotName));
 }
+
+void USaveGameSlotViewModel::SetHeaderDataProperties(const FInstancedStruct* HeaderData)
+{
+	const FSimpleSaveGameHeaderData* SimpleHeaderData = (HeaderData ? HeaderData->GetPtr<FSimpleSaveGameHeaderData>() : nullptr);
+	UE_MVVM_SET_PROPERTY_VALUE(UtcTimeOfLastSave, SimpleHeaderData ? SimpleHeaderData->UtcTimeOfLastSave : FDateTime());
+	UE_MVVM_SET_PROPERTY_VALUE(SaveCounter, SimpleHeaderData ? SimpleHeaderData->SaveCounter : 0);
+	UE_MVVM_SET_PROPERTY_VALUE(LoadedLevel, SimpleHeaderData ? SimpleHeaderData->LoadedLevel : FSoftObjectPath());
+}
@@ -15,10 +15,20 @@
 #include "AutosaveCheckpointRegistry.generated.h"
 
 class AAutosaveCheckpoint;
+class USaveGameModule_PlayerStart;
+class USceneComponent;
+enum class EUpdateTransformFlags : int32;
+enum class ETeleportType : uint8;
 
 /**
  * Singleton registry for registering AutosaveCheckpoint actors at runtime, on-demand.
- * Offers API to find checkpoints by PlayerStartTag.
+ * Offers API to find checkpoints by PlayerStartTag or by location.
+ *
+ * Checkpoints are indexed by tag and in a uniform grid over their locations. The index is maintained incrementally,
+ * when checkpoints are spawned, destroyed, moved or (un)registered and when levels are added to or removed from the world.
+ *
+ * Projects can call @FindCheckpointForPlayerStart when choosing the player start after a load (e.g. in an override of
+ * AGameModeBase::ChoosePlayerStart), so the player still starts near the saved location when the saved checkpoint is gone.
  */
 UCLASS()
 class WEEKENDSAVEGAME_API UAutosaveCheckpointRegistry : public UWorldSubsystem
@@ -30,20 +40,69 @@ public:
 
 	// - UWorldSubsystem
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
 	// --
 
-	/** @returns - or attempts to locate - the checkpoint with given PlayerStartTag. */
+	/** @returns the registered checkpoint with given PlayerStartTag. Editor worlds are scanned again for unregistered checkpoints on a miss. */
 	AAutosaveCheckpoint* FindCheckpoint(FName PlayerStartTag);
 
 	/** @returns the registered checkpoint with given PlayerStartTag. */
 	AAutosaveCheckpoint* GetRegisteredCheckpoint(FName PlayerStartTag) const;
 
+	/** @returns the registered checkpoint closest to given location, or nullptr if there is none within MaxDistance. */
+	AAutosaveCheckpoint* FindNearestCheckpoint(const FVector& Location, double MaxDistance = UE_BIG_NUMBER) const;
+
+	/** @returns the checkpoint with the saved PlayerStartTag, or otherwise the one closest to the saved WorldCoordinates. */
+	UFUNCTION(BlueprintCallable, Category = "Weekend Utils|Save Game")
+	AAutosaveCheckpoint* FindCheckpointForPlayerStart(const USaveGameModule_PlayerStart* PlayerStartModule);
+
 	void RegisterCheckpoint(AAutosaveCheckpoint& Checkpoint);
 	void UnregisterCheckpoint(AAutosaveCheckpoint& Checkpoint);
 
+	/** Re-indexes a registered checkpoint after its PlayerStartTag or location changed. */
+	void UpdateCheckpoint(AAutosaveCheckpoint& Checkpoint);
+
+	FORCEINLINE int32 GetNumRegisteredCheckpoints() const { return IndexedCheckpoints.Num(); }
+
 protected:
+	/** Edge length of the cells of the spatial grid (in cm). */
+	static constexpr double GridCellSize = 10000.0;
+
+	struct FIndexedCheckpoint
+	{
+		FName PlayerStartTag = NAME_None;
+		FIntVector GridCell = FIntVector::ZeroValue;
+		FDelegateHandle OnTransformUpdatedHandle;
+	};
+
+	/** Index keys of all registered checkpoints, which are kept to find the entries again after the checkpoint changed. */
+	TMap<TWeakObjectPtr<AAutosaveCheckpoint>, FIndexedCheckpoint> IndexedCheckpoints = {};
+	TMap<FName, TArray<TWeakObjectPtr<AAutosaveCheckpoint>, TInlineAllocator<1>>> CheckpointsByTag = {};
+	TMap<FIntVector, TArray<TWeakObjectPtr<AAutosaveCheckpoint>>> CheckpointsByGridCell = {};
+
+	/** Bounds of all grid cells that ever contained a checkpoint, which limit nearest-checkpoint queries. */
+	FIntVector MinGridCell = FIntVector::ZeroValue;
+	FIntVector MaxGridCell = FIntVector::ZeroValue;
+
+	FDelegateHandle OnActorSpawnedHandle;
+	FDelegateHandle OnActorDestroyedHandle;
+	FDelegateHandle OnLevelAddedToWorldHandle;
+	FDelegateHandle OnLevelRemovedFromWorldHandle;
+
 	void GatherCheckpointsInWorld();
+	void ClearCheckpointIndex();
+
+	void AddToIndex(AAutosaveCheckpoint& Checkpoint);
+	void RemoveFromIndex(const TWeakObjectPtr<AAutosaveCheckpoint>& Checkpoint);
+	void AddToGridCell(const TWeakObjectPtr<AAutosaveCheckpoint>& Checkpoint, const FIntVector& GridCell);
+	void RemoveFromGridCell(const TWeakObjectPtr<AAutosaveCheckpoint>& Checkpoint, const FIntVector& GridCell);
+	void RemoveFromTag(const TWeakObjectPtr<AAutosaveCheckpoint>& Checkpoint, FName PlayerStartTag);
+	static void UnbindTransformUpdated(const TWeakObjectPtr<AAutosaveCheckpoint>& Checkpoint, const FIndexedCheckpoint& IndexedCheckpoint);
+	static FIntVector GetGridCell(const FVector& Location);
 
-	UPROPERTY()
-	TArray<TObjectPtr<AAutosaveCheckpoint>> RegisteredCheckpoints = {};
+	void HandleActorSpawned(AActor* Actor);
+	void HandleActorDestroyed(AActor* Actor);
+	void HandleCheckpointTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+	void HandleLevelAddedToWorld(ULevel* Level, UWorld* World);
+	void HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World);
 };
@@ -30,6 +30,7 @@ public:
 	UPROPERTY(Transient)
 	mutable TArray<TObjectPtr<USaveGame>> SerializedSaveGameObjects = {};
 	TMap<FSlotName, TArray<uint8>> PretendedSaveGamesOnDisk = {};
+	TMap<FSlotName, FDateTime> PretendedTimestampsOnDisk = {};
 
 	// - USaveGameSerializer
 	using USaveGameSerializer::TrySaveGameToSlot;
@@ -42,5 +43,16 @@ public:
 	virtual bool TryLoadDataFromSlot(const FSlotName& SlotName, const int32 UserIndex, TArray<uint8>& OutSaveData) override;
 	virtual void AsyncLoadGameFromSlot(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncLoadCompleted Callback) override;
 	virtual bool TryDeleteGameInSlot(const FSlotName& SlotName, const int32 UserIndex, TOptional<FString> OptionalBackupFolder) override;
+	virtual void AsyncDeleteGameInSlot(const FSlotName& SlotName, const int32 UserIndex, TOptional<FString> OptionalBackupFolder, FOnAsyncDeleteCompleted Callback) override;
+	virtual bool UsesSlotIndex() const override;
+	virtual bool TryVerifySlot(const FSlotName& SlotName, const int32 UserIndex) override;
+	virtual void AsyncVerifySlots(const TArray<FSlotName>& SlotNames, const int32 UserIndex, FOnAsyncVerifyCompleted Callback) override;
+	virtual bool TryDeserializeHeaderData(const TArray<uint8>& InSaveData, FInstancedStruct& OutHeaderData) const override;
+	virtual bool TryLoadHeaderDataFromSlot(const FSlotName& SlotName, const int32 UserIndex, FInstancedStruct& OutHeaderData) override;
+	virtual void AsyncLoadHeaderDataFromSlots(const TArray<FSlotName>& SlotNames, const int32 UserIndex, FOnAsyncHeaderScanCompleted Callback) override;
+	virtual void AsyncFindExistingSlots(const TArray<FSlotName>& SlotNames, const int32 UserIndex, FOnAsyncFindSlotsCompleted Callback) override;
 	// --
+
+	/** @returns the object stored for given "serialized" data, without copying it. */
+	USaveGame* FindSerializedSaveGameObject(const TArray<uint8>& InSaveData) const;
 };
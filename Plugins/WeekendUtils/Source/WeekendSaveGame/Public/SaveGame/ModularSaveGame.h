@@ -11,6 +11,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/SaveGame.h"
+#include "Misc/CompressionFlags.h"
 #include "SaveGame/SaveGameHeader.h"
 #include "SaveGame/SaveGameModule.h"
 #include "SaveGame/SaveGameSerializer.h"
@@ -109,6 +110,8 @@ public:
 #endif
 
 protected:
+	friend class UModularSaveGameSerializer;
+
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif
@@ -124,6 +127,8 @@ protected:
 
 /**
  * Custom serializer for the @UModularSaveGame, to be used within the @USaveGameService.
+ * Each module is written into its own section, which is listed in a table of contents after the header.
+ * This allows reading single modules without deserializing the whole SaveGame.
  */
 UCLASS()
 class WEEKENDSAVEGAME_API UModularSaveGameSerializer : public USaveGameSerializer
@@ -132,11 +137,61 @@ class WEEKENDSAVEGAME_API UModularSaveGameSerializer : public USaveGameSerialize
 
 public:
 	// - USaveGameSerializer
-	virtual bool TrySerializeSaveGame(USaveGame& InSaveGameObject, TArray<uint8>& OutSaveData) const override;
 	virtual bool TryDeserializeSaveGame(const TArray<uint8>& InSaveData, USaveGame*& OutSaveGameObject) const override;
+	virtual bool TryDeserializeHeaderData(const TArray<uint8>& InSaveData, FInstancedStruct& OutHeaderData) const override;
+	virtual void GatherPathsToPreload(const TArray<uint8>& InSaveData, TArray<FSoftObjectPath>& OutPaths) const override;
 	// --
+
+	/** Reads the header and table of contents of the save data, without deserializing any objects. */
+	bool TryReadTableOfContents(const TArray<uint8>& InSaveData, FModularSaveGameHeader& OutHeader, FModularSaveGameTableOfContents& OutTableOfContents) const;
+
+	/**
+	 * Deserializes a single module from its section in the save data, without deserializing the SaveGame or other modules.
+	 * Save data of older file versions (without sections) is fully deserialized as fallback.
+	 */
+	virtual bool TryDeserializeModule(const TArray<uint8>& InSaveData, const FName& ModuleName, UObject& Outer, USaveGameModule*& OutModule) const;
+
+	template <typename T>
+	T* TryDeserializeModule(const TArray<uint8>& InSaveData, UObject& Outer, const TSubclassOf<T>& ModuleClass = T::StaticClass()) const;
+
+protected:
+	// - USaveGameSerializer
+	virtual bool TryCaptureSaveGameSnapshot(USaveGame& InSaveGameObject, TArray<uint8>& OutSnapshotData) const override;
+	virtual FSaveDataEncoder MakeSaveDataEncoder() const override;
+	virtual FSaveDataVerifier MakeSaveDataVerifier() const override;
+	virtual FSaveDataDecoder MakeSaveDataDecoder() const override;
+	virtual FSaveDataPreparer MakeSaveDataPreparer() const override;
+	virtual bool TryDeserializeSaveGameStep(FSaveGameDeserialization& InOutDeserialization) const override;
+	// --
+
+	/** Amount of uncompressed bytes that are compressed together, so that data can be decompressed block by block. */
+	static constexpr int32 CompressionBlockSize = 256 * 1024;
+
+	/** Thread-safe: Compresses everything after the header of uncompressed save data in place. */
+	static bool TryCompressSaveData(TArray<uint8>& InOutSaveData, ESaveGameCompressionFormat CompressionFormat, ECompressionFlags CompressionFlags);
+
+	/** Thread-safe: Decompresses compressed save data, so that the result equals the save data before compression. */
+	static bool TryDecompressSaveData(const TArray<uint8>& InSaveData, TArray<uint8>& OutSaveData);
+
+	/** @returns InSaveData if it is not compressed, otherwise its decompressed copy in OutDecompressedStorage, or nullptr on failure. */
+	static const TArray<uint8>* FindUncompressedSaveData(const TArray<uint8>& InSaveData, TArray<uint8>& OutDecompressedStorage);
+
+	USaveGameModule* DeserializeModuleSection(FMemoryReader& MemoryReader, const FModularSaveGameSection& Section, UObject& Outer,
+		FWeekendUtilsSaveGameNameTable* NameTable, FWeekendUtilsResolvedObjectCache& ResolvedObjectCache) const;
 };
 
+///////////////////////////////////////////////////////////////////////////////////////
+/// TEMPLATES @UModularSaveGameSerializer
+
+template <typename T>
+T* UModularSaveGameSerializer::TryDeserializeModule(const TArray<uint8>& InSaveData, UObject& Outer, const TSubclassOf<T>& ModuleClass) const
+{
+	static_assert(TIsDerivedFrom<T, USaveGameModule>::IsDerived, "Type is not derived from USaveGameModule.");
+	USaveGameModule* Module = nullptr;
+	TryDeserializeModule(InSaveData, GetDefault<T>(ModuleClass)->DefaultModuleName, Outer, OUT Module);
+	return ((Module && Module->GetClass() == ModuleClass) ? Cast<T>(Module) : nullptr);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////
 /// TEMPLATES @UModularSaveGame
 
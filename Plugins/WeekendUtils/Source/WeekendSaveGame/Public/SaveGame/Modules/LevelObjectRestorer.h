@@ -10,6 +10,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "SaveGame/SaveGameHeader.h"
 #include "SaveGame/SaveGameModule.h"
 
 #include "LevelObjectRestorer.generated.h"
@@ -31,6 +33,64 @@ public:
 
 	UPROPERTY(SaveGame)
 	bool bUsesCustomUniqueObjectId = false;
+
+	/** Checksum of the full ObjectId, which is independent of its @FLevelObjectStateKey, to detect key collisions. 0 = unknown. */
+	UPROPERTY(VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	uint32 ObjectIdChecksum = 0;
+
+	/** Index of the level that contains the object, see @ULevelObjectRestorer::LevelPartitionNames. INDEX_NONE = unknown. */
+	UPROPERTY(VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	int32 PartitionIndex = INDEX_NONE;
+};
+
+/** Implementation detail of @ULevelObjectRestorer: Compressed object states of a level that is not loaded. */
+USTRUCT()
+struct WEEKENDSAVEGAME_API FLevelObjectStatePartition
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	int32 NumObjectStates = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	ESaveGameCompressionFormat CompressionFormat = ESaveGameCompressionFormat::None;
+
+	UPROPERTY(VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	int32 UncompressedSize = 0;
+
+	UPROPERTY()
+	TArray<uint8> CompressedData = {};
+};
+
+/**
+ * Implementation detail of @ULevelObjectRestorer: Compact replacement of a full ObjectId (e.g. "WorldName:LevelName.ObjectPath"),
+ * consisting of the world and level prefix that is interned once per module, and a 64-bit hash of the rest of the ObjectId.
+ */
+USTRUCT()
+struct WEEKENDSAVEGAME_API FLevelObjectStateKey
+{
+	GENERATED_BODY()
+
+public:
+	/** Index of the interned prefix of the ObjectId, see @ULevelObjectRestorer::ObjectIdPrefixes. */
+	UPROPERTY(VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	int32 PrefixIndex = INDEX_NONE;
+
+	UPROPERTY(VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	uint64 PathHash = 0;
+
+	bool operator==(const FLevelObjectStateKey& Other) const { return (PrefixIndex == Other.PrefixIndex && PathHash == Other.PathHash); }
+	friend uint32 GetTypeHash(const FLevelObjectStateKey& Key) { return HashCombine(::GetTypeHash(Key.PrefixIndex), ::GetTypeHash(Key.PathHash)); }
+};
+
+/** Object to register via @ULevelObjectRestorer::RegisterLevelObjects. */
+struct FLevelObjectRegistration
+{
+	TWeakObjectPtr<UObject> Object = nullptr;
+
+	/** Only supported for actors and scene components. */
+	bool bWithTransform = false;
 };
 
 /** Behavior in case of ObjectId conflicts when upgrading a saved state to a new module version. */
@@ -42,6 +102,18 @@ enum class ELevelObjectRestorerConflictResolutionPolicy : uint8
 	DoNotResolveKeepBoth
 };
 
+/** Decides which registered objects get serialized again when the module is saved. */
+UENUM()
+enum class ELevelObjectRestorerDirtyTrackingMode : uint8
+{
+	/** Every registered object is serialized on every save. */
+	Disabled,
+	/** Only objects marked via @ULevelObjectRestorer::MarkLevelObjectDirty are serialized, others reuse their previous state. */
+	ExplicitOnly,
+	/** Like ExplicitOnly, but additionally detects changes of SaveGame properties and transforms via a cheap property hash. */
+	ExplicitAndPropertyHash
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -62,6 +134,8 @@ public:
 		ModuleVersion_Initial = 0,
 		ModuleVersion_WithSafeUniqueObjectId = 1,
 		ModuleVersion_WithSafeUniqueObjectId_Hotfix = 2,
+		ModuleVersion_WithObjectStateKeys = 3,
+		ModuleVersion_WithLevelPartitions = 4,
 
 		// ----------- Do NOT touch hardcoded versions below! -----------
 		ModuleVersion_LastPlusOne, // Automatically set to one higher than the last custom entry.
@@ -84,6 +158,34 @@ public:
 	void RegisterLevelObjectWithTransform(AActor& Actor, TOptional<FString> CustomUniqueObjectId = {}, bool bImmediatelyRestoreIfPossible = true);
 	void RegisterLevelObjectWithTransform(USceneComponent& SceneComponent, TOptional<FString> CustomUniqueObjectId = {}, bool bImmediatelyRestoreIfPossible = true);
 
+	/**
+	 * Registers multiple objects by their PathName and immediately restores their data, if possible.
+	 * With a @RegistrationBudgetMs, the registrations are queued instead and processed time-sliced over the following frames,
+	 * so objects may restore their data only some frames later. Queued objects are unknown to this module until they are processed.
+	 */
+	void RegisterLevelObjects(TConstArrayView<FLevelObjectRegistration> Registrations);
+
+	/** Processes all queued registrations of @RegisterLevelObjects right away. */
+	void FlushPendingRegistrations();
+	bool IsRegistrationPending(const UObject& Object) const { return PendingRegistrationObjects.Contains(MakeWeakObjectPtr(const_cast<UObject*>(&Object))); }
+	int32 GetNumPendingRegistrations() const { return PendingRegistrationObjects.Num(); }
+
+	/** Event fired whenever registered objects were restored after this module was restored, see @RestoreBudgetMs. */
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnObjectRestoreProgress, int32 /*NumRestoredObjects*/, int32 /*NumObjectsToRestore*/)
+	FOnObjectRestoreProgress OnObjectRestoreProgress;
+
+	/** Event fired once all registered objects were restored after this module was restored, see @RestoreBudgetMs. */
+	DECLARE_MULTICAST_DELEGATE(FOnObjectRestoreCompleted)
+	FOnObjectRestoreCompleted OnObjectRestoreCompleted;
+
+	/** Whether registered objects are still waiting to be restored after this module was restored. */
+	bool IsRestoringObjects() const { return (PendingRestores.Num() > 0); }
+	/** @returns the ratio of registered objects that were restored after this module was restored, or 1 if there is nothing to restore. */
+	float GetObjectRestoreProgress() const;
+
+	/** Restores all registered objects that are still waiting to be restored right away. */
+	void FlushPendingRestores();
+
 	/**
 	 * Deregisters an previously registered object. This should be called when the object dies.
 	 * By default, the saved object state will be updated and kept in the @UModularSaveGame and can be restored once the object registers again (@bKeepObjectState).
@@ -93,11 +195,28 @@ public:
 	void UnregisterLevelObjectWithTransform(AActor& Actor, TOptional<FString> CustomUniqueObjectId = {}, bool bKeepObjectState = true);
 	void UnregisterLevelObjectWithTransform(USceneComponent& SceneComponent, TOptional<FString> CustomUniqueObjectId = {}, bool bKeepObjectState = true);
 
+	/**
+	 * Marks a registered object as changed, so its state will be serialized again with the next save.
+	 * Only relevant when dirty tracking is enabled (@DirtyTrackingMode), otherwise all registered objects are always serialized.
+	 */
+	void MarkLevelObjectDirty(const UObject& Object);
+
+	/** Number of object states that were reused / serialized again during the last save of this module. */
+	int32 GetNumReusedObjectStatesOfLastSave() const { return NumReusedObjectStatesOfLastSave; }
+	int32 GetNumSerializedObjectStatesOfLastSave() const { return NumSerializedObjectStatesOfLastSave; }
+
+	/** Number of object states of loaded levels, and of levels that are not loaded and packed (see @bPackStatesOfUnloadedLevels). */
+	int32 GetNumActiveObjectStates() const { return KeyedObjectStates.Num(); }
+	int32 GetNumPackedObjectStates() const;
+
 	/** Constructs a unique object id for given object based on the objects PathName, with some adjustments to the world-path prefix. */
 	static FString MakeSafeUniqueObjectId(const UObject& Object);
 
 	// - USaveGameModule
 	virtual void Serialize(FArchive& Ar) override;
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+	virtual void PostDuplicate(bool bDuplicateForPIE) override;
 	virtual void BeginDestroy() override;
 #if WITH_EDITOR
 	virtual void AnalyzeAndReportModuleComposition(FMessageLog& MessageLog) const override;
@@ -109,16 +228,78 @@ protected:
 	UPROPERTY(Transient, Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game")
 	ELevelObjectRestorerConflictResolutionPolicy ConflictResolutionPolicy = ELevelObjectRestorerConflictResolutionPolicy::KeepExistingDiscardConflicting;
 
+	/**
+	 * Opt-in to skip serialization of unchanged objects when saving. Unchanged objects keep their previous ByteData.
+	 * Custom Serialize() implementations with data outside of SaveGame properties must call @MarkLevelObjectDirty themselves.
+	 */
+	UPROPERTY(Transient, Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game")
+	ELevelObjectRestorerDirtyTrackingMode DirtyTrackingMode = ELevelObjectRestorerDirtyTrackingMode::Disabled;
+
+	/**
+	 * Opt-in to keep the states of levels that are not loaded (e.g. unloaded streaming levels or World Partition cells) only as compressed bytes,
+	 * so that memory scales with the loaded content. States are packed when their level is removed from the world, or after restoring
+	 * for levels without registered objects, and unpacked when their level is added again or one of their objects registers.
+	 */
+	UPROPERTY(Transient, Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game")
+	bool bPackStatesOfUnloadedLevels = false;
+
+	UPROPERTY(Transient, Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game", meta = (EditCondition = "bPackStatesOfUnloadedLevels"))
+	ESaveGameCompressionFormat PackedStatesCompressionFormat = ESaveGameCompressionFormat::LZ4;
+
+	/**
+	 * Opt-in to spread the registrations of @RegisterLevelObjects over multiple frames, with this much time per frame.
+	 * Avoids hitches when levels with many objects are loaded. 0 = register all objects immediately.
+	 */
+	UPROPERTY(Transient, Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game", meta = (ClampMin = 0, Units = "Milliseconds"))
+	float RegistrationBudgetMs = 0.0f;
+
+	/**
+	 * Opt-in to spread restoring the registered objects after this module was restored over multiple frames, with this much time per frame.
+	 * Objects with transform near the player are restored first. See @OnObjectRestoreCompleted. 0 = restore all objects immediately.
+	 * (i) @OnAfterModuleRestored (and thus the restored events of the save game service) fire before the queued objects are restored.
+	 */
+	UPROPERTY(Transient, Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game", meta = (ClampMin = 0, Units = "Milliseconds"))
+	float RestoreBudgetMs = 0.0f;
+
 	UPROPERTY(Transient, VisibleAnywhere, meta = (DisplayThumbnail = "false"), Category = "Weekend Utils|Save Game")
 	TSet<TWeakObjectPtr<UObject>> SimpleRegisteredObjects = {};
 	UPROPERTY(Transient, VisibleAnywhere, meta = (DisplayThumbnail = "false"), Category = "Weekend Utils|Save Game")
 	TSet<TWeakObjectPtr<UObject>> RegisteredObjectsWithTransform = {};
 	UPROPERTY(Transient, VisibleAnywhere, meta = (DisplayThumbnail = "false"), Category = "Weekend Utils|Save Game")
-	TMap<TWeakObjectPtr<UObject>, FString> UniqueIdsOfRegisteredObjects = {};
+	TMap<TWeakObjectPtr<UObject>, FLevelObjectStateKey> KeysOfRegisteredObjects = {};
 
+	/**
+	 * All object states by the key of their ObjectId. (i) Not a SaveGame property: SaveGames store these in a compact binary format
+	 * since ModuleVersion_WithObjectStateKeys, see @SerializeObjectStates. The property is still used for duplication and presets.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	TMap<FLevelObjectStateKey, FLevelObjectSaveGameState> KeyedObjectStates = {};
+
+	/** World and level prefixes of all ObjectIds, referenced by @FLevelObjectStateKey::PrefixIndex. */
+	UPROPERTY(VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	TArray<FString> ObjectIdPrefixes = {};
+
+	/** Package names of the levels that contain level objects (without PIE prefix), referenced by @FLevelObjectSaveGameState::PartitionIndex. */
+	UPROPERTY(VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	TArray<FString> LevelPartitionNames = {};
+
+	/** Packed object states of levels that are not loaded by their partition index. These states are not contained in @KeyedObjectStates. */
+	UPROPERTY(VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	TMap<int32, FLevelObjectStatePartition> PackedLevelPartitions = {};
+
+	/**
+	 * Object states of module versions before ModuleVersion_WithObjectStateKeys by their full ObjectId, which keep their property name
+	 * to be restorable. Only used to upgrade restored data, which is then moved to @KeyedObjectStates.
+	 */
 	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Weekend Utils|Save Game")
 	TMap<FString, FLevelObjectSaveGameState> ObjectStates;
 
+	/** @returns the compact key for given ObjectId, interning its prefix if needed. */
+	FLevelObjectStateKey MakeObjectStateKey(const FString& ObjectId, uint32& OutObjectIdChecksum);
+
+	/** Human-readable representation of a key for logging, as the full ObjectId can't be restored from it. */
+	FString DescribeObjectStateKey(const FLevelObjectStateKey& Key) const;
+
 	virtual void SaveObjectToState(UObject& Object, bool bSaveTransform, FLevelObjectSaveGameState& InOutState) const;
 	virtual void RestoreObjectFromState(const FLevelObjectSaveGameState& State, bool bRestoreTransform, UObject& InOutObject) const;
 
@@ -127,11 +308,105 @@ protected:
 
 	virtual void UpgradeSaveGameModule();
 
+	/**
+	 * Hashes all SaveGame properties (and optionally the transform) of given object.
+	 * @returns nothing if any of the properties is not hashable, so the object has to be treated as always dirty.
+	 */
+	virtual TOptional<uint32> CalculateObjectStateHash(UObject& Object, bool bIncludeTransform) const;
+
+	/**
+	 * Registered objects are restored in ascending order of this value, when restoring is spread over multiple frames (@RestoreBudgetMs).
+	 * By default, objects with transform are ordered by their squared distance to the player, followed by all other objects.
+	 */
+	virtual double CalculateRestoreOrder(const FLevelObjectSaveGameState& State, bool bHasTransform, const TOptional<FVector>& PlayerLocation) const;
+	TOptional<FVector> FindPlayerViewLocation() const;
+
+	/** Bound to @FWorldDelegates to unpack and pack the states of levels when they are streamed in and out (@bPackStatesOfUnloadedLevels). */
+	void HandleLevelAddedToWorld(ULevel* Level, UWorld* World);
+	void HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+
 private:
 	/** Debugging option to log which (restored) object states were not claimed on this module. */
 	UPROPERTY(Config)
 	bool bReportUnclaimedObjectStatesOnDestruction = false;
-	TSet<FString> ClaimedUniqueObjectIds = {};
+	TSet<FLevelObjectStateKey> ClaimedObjectStateKeys = {};
 
 	void ReportUnclaimedObjectStates() const;
+
+	/** Shared implementation of the Register* and Unregister* functions. Transforms are only supported for actors and scene components. */
+	void RegisterObjectState(UObject& Object, bool bWithTransform, const TOptional<FString>& CustomUniqueObjectId, bool bImmediatelyRestoreIfPossible);
+	void UnregisterObjectState(UObject& Object, bool bWithTransform, const TOptional<FString>& CustomUniqueObjectId, bool bKeepObjectState);
+
+	/** Registered objects that were explicitly marked dirty since the last save. */
+	TSet<TWeakObjectPtr<UObject>> DirtyObjects = {};
+	/** Keys of object states that are known to be up-to-date, with the property hash of the object at that time (0 if not hashed). */
+	TMap<FLevelObjectStateKey, uint32> UpToDateObjectStateHashes = {};
+	int32 NumReusedObjectStatesOfLastSave = 0;
+	int32 NumSerializedObjectStatesOfLastSave = 0;
+
+	/** Reused by @SaveObjectToState for all objects, so only the final ByteData of each state has to be allocated (with exact size). */
+	mutable TArray<uint8> SaveObjectScratchBuffer = {};
+
+	bool IsObjectStateUpToDate(UObject& Object, const FLevelObjectStateKey& ObjectKey, bool bHasTransform) const;
+	void MarkObjectStateUpToDate(UObject& Object, const FLevelObjectStateKey& ObjectKey, bool bHasTransform);
+
+	/** Lookup of @ObjectIdPrefixes and @LevelPartitionNames, rebuilt on demand (e.g. after duplication). */
+	TMap<FString, int32> ObjectIdPrefixIndices = {};
+	TMap<FString, int32> LevelPartitionIndices = {};
+	/** Partition index of each loaded level with registered objects, so registrations don't have to build the partition name. */
+	TMap<TWeakObjectPtr<const ULevel>, int32> LevelPartitionIndicesByLevel = {};
+
+	int32 FindOrAddObjectIdPrefix(const FString& Prefix);
+	int32 FindOrAddLevelPartition(const ULevel& Level);
+	int32 FindLevelPartition(const ULevel& Level);
+	TSet<int32> GetLevelPartitionsOfRegisteredObjects();
+
+	/** Unpacks the states of given partition, if they are packed. Unpacked states don't replace states that are already present. */
+	void UnpackLevelPartition(int32 PartitionIndex, const TArray<int32>* PrefixIndexRemap = nullptr);
+	/** Moves the given states of a partition from @KeyedObjectStates to @PackedLevelPartitions. Callers make sure that none of them is registered. */
+	void PackLevelPartition(int32 PartitionIndex, const TArray<FLevelObjectStateKey>& ObjectKeys);
+	void PackLevelPartitionsWithoutRegisteredObjects();
+
+	/** Queued registrations of @RegisterLevelObjects in order. Entries whose object is no longer in @PendingRegistrationObjects were cancelled. */
+	TArray<FLevelObjectRegistration> PendingRegistrations = {};
+	TSet<TWeakObjectPtr<UObject>> PendingRegistrationObjects = {};
+	TOptional<FTSTicker::FDelegateHandle> PendingRegistrationsTickerHandle = {};
+
+	void ProcessRegistration(const FLevelObjectRegistration& Registration);
+	void ProcessPendingRegistrations(double BudgetSeconds);
+	bool CancelPendingRegistration(const UObject& Object);
+
+	struct FPendingObjectRestore
+	{
+		TWeakObjectPtr<UObject> Object = nullptr;
+		FLevelObjectStateKey ObjectKey = {};
+		bool bHasTransform = false;
+		double RestoreOrder = 0.0;
+	};
+
+	/** Registered objects in restore order that were not yet restored since this module was restored, see @RestoreBudgetMs. */
+	TArray<FPendingObjectRestore> PendingRestores = {};
+	TSet<TWeakObjectPtr<UObject>> PendingRestoreObjects = {};
+	TOptional<FTSTicker::FDelegateHandle> PendingRestoresTickerHandle = {};
+	int32 NumRestoredObjects = 0;
+	int32 NumObjectsToRestore = 0;
+
+	void RestoreRegisteredObjects();
+	void ProcessPendingRestores(double BudgetSeconds);
+	void ResetPendingRestores();
+
+	FDelegateHandle OnLevelAddedToWorldHandle;
+	FDelegateHandle OnLevelRemovedFromWorldHandle;
+
+	/** @returns the existing state for given key, or nullptr if there is none or it belongs to another ObjectId with the same key. */
+	FLevelObjectSaveGameState* FindObjectState(const FLevelObjectStateKey& ObjectKey, uint32 ObjectIdChecksum);
+	FLevelObjectSaveGameState& FindOrAddObjectState(const FLevelObjectStateKey& ObjectKey, uint32 ObjectIdChecksum, int32 PartitionIndex);
+
+	/** Moves the states of older module versions from @ObjectStates to @KeyedObjectStates. */
+	void UpgradeLegacyObjectStates();
+	void ConvertLegacyObjectStates();
+
+	/** Writes / reads all object states after the properties of the module. */
+	void SerializeObjectStates(FArchive& Ar);
+	void ReadKeyedObjectStates(FArchive& Ar, const TArray<int32>& PrefixIndexRemap, const TArray<int32>& PartitionIndexRemap);
 };
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "SaveGame/SaveGameDebugHistory.h"
 #include "SaveGame/SaveGameModule.h"
 
 #include "SaveGameModule_SaveLoadDebugHistory.generated.h"
@@ -19,6 +20,7 @@ class USaveGameService;
 /**
  * Module for @UModularSaveGame that stores a history of executed operations of the @USaveGameService.
  * The history is only saved, not restored, since the process of restoring would alter the history.
+ * Entries are snapshotted from the ring buffer of the service before saving and only formatted when inspected.
  */
 UCLASS(DisplayName = "Save/Load Debug History")
 class WEEKENDSAVEGAME_API USaveGameModule_SaveLoadDebugHistory : public USaveGameModule
@@ -26,18 +28,40 @@ class WEEKENDSAVEGAME_API USaveGameModule_SaveLoadDebugHistory : public USaveGam
 	GENERATED_BODY()
 
 public:
+	enum EModuleVersion : int32
+	{
+		ModuleVersion_Initial = 0,
+		ModuleVersion_WithEntryProperties = 1,
+
+		// ----------- Do NOT touch hardcoded versions below! -----------
+		ModuleVersion_LastPlusOne, // Automatically set to one higher than the last custom entry.
+		ModuleVersion_Current = ModuleVersion_LastPlusOne - 1 // Automatically set to the last custom entry.
+	};
+
 	USaveGameModule_SaveLoadDebugHistory()
 	{
 		DefaultModuleName = "SaveLoadDebugHistory";
-		ModuleVersion = 0;
+		ModuleVersion = ModuleVersion_Current;
 	}
 
 	UPROPERTY(Transient)
 	TObjectPtr<USaveGameService> SaveGameService = nullptr;
 
+	/** Formatted history of saves created before ModuleVersion_WithEntryProperties. */
 	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Weekend Utils|Save Game")
 	TArray<FString> DebugHistory = {};
 
+	/** Snapshot of the history of the service at the time of saving, oldest entry first. */
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	TArray<FSaveGameDebugHistoryEntry> DebugHistoryEntries = {};
+
+	/** Formats the saved history, oldest entry first. */
+	TArray<FString> GetFormattedDebugHistory() const;
+
+	// - UObject
+	virtual void Serialize(FArchive& Ar) override;
+	// --
+
 protected:
 	// - USaveGameModule
 	virtual void PreSaveModule() override;
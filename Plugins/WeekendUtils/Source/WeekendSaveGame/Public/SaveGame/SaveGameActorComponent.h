@@ -21,7 +21,8 @@ class ULevelObjectRestorer;
  * This means that the actor and all its components will automatically save and load
  * properties marked with the "SaveGame" specifier.
  * @note that this will only work reliably for level actors that are not spawned at runtime!
- * @note that the restoration of saved data will happen before BeginPlay (InitializeComponent).
+ * @note that the restoration of saved data will happen before BeginPlay (InitializeComponent),
+ * unless the @ULevelObjectRestorer is configured to spread registrations over multiple frames.
  * @requires UModularSaveGame
  */
 UCLASS(meta = (BlueprintSpawnableComponent))
@@ -32,6 +33,13 @@ class WEEKENDSAVEGAME_API USaveGameActorComponent : public UActorComponent
 public:
 	USaveGameActorComponent();
 
+	/**
+	 * Marks the actor and its registered components as changed, so their state will be serialized again with the next save.
+	 * Only needed when dirty tracking is enabled on the @ULevelObjectRestorer.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weekend Utils|Save Game")
+	void MarkDirtyForSaveGame();
+
 protected:
 	///////////////////////////////////////////////////////////////////////////////////////
 	/// CLASS CONFIG
@@ -0,0 +1,96 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SaveGameDebugHistory.generated.h"
+
+/** Operations of the @USaveGameService that are recorded in its debug history. Only append new entries, since they are saved by value. */
+UENUM()
+enum class ESaveGameDebugEvent : uint8
+{
+	Custom,
+	RequestAutosave,
+	RequestSave,
+	RequestLoad,
+	RequestLoadAndTravel,
+	LoadSynchronous,
+	PreloadSynchronous,
+	PreloadAsync,
+	ScanHeaders,
+	RestoreAsCurrent,
+	TravelIntoCurrent,
+	CreateNewAsCurrent,
+	CreateAndRestoreNewAsCurrent,
+	LockAutosaving,
+	UnlockAutosaving,
+	LockSaving,
+	UnlockSaving,
+	LockLoading,
+	UnlockLoading,
+	LoadRequestFinished,
+	LoadAndTravelRequestFinished,
+	SaveRequestFinished,
+	DeleteSlotFinished,
+	RefreshSlotCatalog
+};
+
+/**
+ * Structured entry of the debug history of the @USaveGameService.
+ * Entries store the raw arguments of an operation and are only formatted to strings when somebody reads them (see LexToString).
+ */
+USTRUCT()
+struct WEEKENDSAVEGAME_API FSaveGameDebugHistoryEntry
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	ESaveGameDebugEvent Event = ESaveGameDebugEvent::Custom;
+
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	bool bSuccess = true;
+
+	/** The UTC timestamp of when the operation was recorded. */
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	FDateTime Timestamp = FDateTime();
+
+	/** Execution time in seconds, or negative if the event has no duration. */
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	double Duration = -1.0;
+
+	/** Size of the saved or loaded data in bytes, or negative if unknown. */
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	int64 NumBytes = -1;
+
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	FString SlotName = {};
+
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	FString Context = {};
+
+	/** Name of the object that holds the save/load lock of a lock event. */
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	FName KeyHolder = NAME_None;
+
+	/** Key of the save/load lock of a lock or unlock event. */
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	FGuid LockKey = FGuid();
+
+	/** Number of existing and changed slots of a slot catalog refresh, or negative if not applicable. */
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	int32 NumExistingSlots = -1;
+
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Weekend Utils|Save Game")
+	int32 NumChangedSlots = -1;
+
+	friend WEEKENDSAVEGAME_API FString LexToString(const FSaveGameDebugHistoryEntry& Entry);
+};
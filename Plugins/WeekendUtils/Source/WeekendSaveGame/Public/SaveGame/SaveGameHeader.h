@@ -69,28 +69,131 @@ public:
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
+/** Codec that is used to compress the data of modular SaveGames, after their header. */
+UENUM()
+enum class ESaveGameCompressionFormat : uint8
+{
+	None,
+	Zlib,
+	LZ4,
+	Oodle
+};
+
+/** Trade-off between compression speed and compressed size. */
+UENUM()
+enum class ESaveGameCompressionLevel : uint8
+{
+	Fast,
+	Balanced,
+	Small
+};
+
+WEEKENDSAVEGAME_API FName GetCompressionFormatName(ESaveGameCompressionFormat CompressionFormat);
+
+///////////////////////////////////////////////////////////////////////////////////////
+
 #define MODULAR_SAVEGAME_FILE_TYPE_TAG	0x53415648 // = UE_SAVEGAME_FILE_TYPE_TAG + 1
-#define MODULAR_SAVEGAME_FILE_VERSION	1 // Increase when file format/compression becomes incompatible to previous version
+
+#define MODULAR_SAVEGAME_FILE_VERSION_INITIAL	1
+#define MODULAR_SAVEGAME_FILE_VERSION_SECTIONS	2 // Modules are stored in independently addressable sections, see FModularSaveGameTableOfContents
+#define MODULAR_SAVEGAME_FILE_VERSION_NAME_TABLE	3 // Names and object paths are stored once in a name table section and referenced by index
+#define MODULAR_SAVEGAME_FILE_VERSION_PRELOAD_PATHS	4 // The name table marks which object paths reference loadable assets, see USaveGameSerializer::GatherPathsToPreload
+#define MODULAR_SAVEGAME_FILE_VERSION_COMPRESSION	5 // Everything after the header may be compressed, see FModularSaveGameHeader::CompressionFormat
+#define MODULAR_SAVEGAME_FILE_VERSION_CHECKSUMS	6 // The data after the header and each section are protected by CRC32 checksums, see FModularSaveGameHeader::BodyChecksum
+
+#define MODULAR_SAVEGAME_FILE_VERSION	MODULAR_SAVEGAME_FILE_VERSION_CHECKSUMS // Increase when file format/compression becomes incompatible to previous version
+#define MODULAR_SAVEGAME_FILE_VERSION_MIN	MODULAR_SAVEGAME_FILE_VERSION_INITIAL // Oldest file version that can still be read
 
 /**
  * Implementation detail for header de-/serialization.
- * @see ModularSaveGameHeader.cpp
+ * @see ModularSaveGame.cpp
  */
-struct FModularSaveGameHeader
+struct WEEKENDSAVEGAME_API FModularSaveGameHeader
 {
 	FModularSaveGameHeader();
 	FModularSaveGameHeader(TSubclassOf<UModularSaveGame> ObjectType, const FInstancedStruct& HeaderData);
 
-	bool TryRead(FMemoryReader& MemoryReader);
+	/**
+	 * @param bSkipCustomHeaderData Thread-safe when set: Skips the custom header data, which may need to resolve its struct type.
+	 * It can then be read on the game thread by TryReadCustomHeaderData. Only supported since MODULAR_SAVEGAME_FILE_VERSION_COMPRESSION.
+	 */
+	bool TryRead(FMemoryReader& MemoryReader, bool bSkipCustomHeaderData = false);
+	bool TryReadCustomHeaderData(FMemoryReader& MemoryReader);
 	bool TryWrite(FMemoryWriter& MemoryWriter);
 	void Clear();
 
+	/** Applies the versions the data was saved with to another archive that reads the same data. */
+	void ApplyVersions(FArchive& Archive) const;
+
+	/**
+	 * Thread-safe: Reads only the fixed-size beginning of the header, which describes where and how the data after the header is stored.
+	 * Data of older file versions is reported as uncompressed. @returns false if the data is no (readable) modular SaveGame data.
+	 */
+	static bool TryReadBodyInfo(const TArray<uint8>& InSaveData, int64& OutBodyOffset, ESaveGameCompressionFormat& OutCompressionFormat);
+
+	/** Thread-safe: Updates the compression format of already written save data in place. */
+	static void WriteCompressionFormat(TArray<uint8>& InOutSaveData, ESaveGameCompressionFormat CompressionFormat);
+
+	/**
+	 * Thread-safe: Compares the checksum in the header with the data after the header, without deserializing anything.
+	 * Data of older file versions has no checksum and is reported as valid. @returns false if the data is corrupted or truncated.
+	 */
+	static bool TryVerifyBodyChecksum(const TArray<uint8>& InSaveData);
+
+	/** Thread-safe: Updates the checksum of already written save data in place, after the data after the header was changed. */
+	static void WriteBodyChecksum(TArray<uint8>& InOutSaveData);
+
 	int32 FileTypeTag;
 	int32 SaveGameFileVersion;
+	int64 BodyOffset; // Since MODULAR_SAVEGAME_FILE_VERSION_COMPRESSION: Where the data after the header begins (= size of the header).
+	ESaveGameCompressionFormat CompressionFormat; // Since MODULAR_SAVEGAME_FILE_VERSION_COMPRESSION: Only the header is written, so always None.
+	uint32 BodyChecksum; // Since MODULAR_SAVEGAME_FILE_VERSION_CHECKSUMS: CRC32 of the data after the header, as it is stored (= after compression).
 	FPackageFileVersion PackageFileUEVersion;
 	FEngineVersion SavedEngineVersion;
 	int32 CustomVersionFormat;
 	FCustomVersionContainer CustomVersions;
 	FString SaveGameClassName;
 	FInstancedStruct CustomHeaderData;
+	int64 CustomHeaderDataOffset; // Not serialized: Where the custom header data was found by TryRead.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/** Location of a section inside modular SaveGame data, relative to the beginning of the data. */
+struct WEEKENDSAVEGAME_API FModularSaveGameSection
+{
+	FName ModuleName = NAME_None;
+	FString ModuleClassName = "";
+	int32 ModuleVersion = 0;
+	int64 Offset = 0;
+	int64 Size = 0;
+	uint32 Checksum = 0; // Since MODULAR_SAVEGAME_FILE_VERSION_CHECKSUMS: CRC32 of the (uncompressed) section data.
+
+	/** Least amount of bytes a serialized section occupies (= two empty strings, version, offset and size). */
+	static constexpr int64 MinSerializedSize = 2 * sizeof(int32) + sizeof(int32) + 2 * sizeof(int64);
+
+	/** @returns whether the section data still matches its checksum. Sections of older file versions have no checksum and are always intact. */
+	bool IsIntact(const TArray<uint8>& InSaveData, int32 SaveGameFileVersion) const;
+
+	friend FArchive& operator<<(FArchive& Ar, FModularSaveGameSection& Section);
+};
+
+/**
+ * Table of contents that follows the @FModularSaveGameHeader since MODULAR_SAVEGAME_FILE_VERSION_SECTIONS.
+ * Contains one section for the SaveGame object itself (without its modules), and one section per module,
+ * so that each module can be deserialized without touching the rest of the data.
+ */
+struct WEEKENDSAVEGAME_API FModularSaveGameTableOfContents
+{
+	bool TryRead(FMemoryReader& MemoryReader, int32 SaveGameFileVersion);
+	bool TryWrite(FMemoryWriter& MemoryWriter);
+	void Clear();
+
+	const FModularSaveGameSection* FindModuleSection(const FName& ModuleName) const;
+
+	FModularSaveGameSection SaveGameSection;
+	TArray<FModularSaveGameSection> ModuleSections;
+
+	/** Location of the @FWeekendUtilsSaveGameNameTable, since MODULAR_SAVEGAME_FILE_VERSION_NAME_TABLE. */
+	FModularSaveGameSection NameTableSection;
 };
@@ -10,29 +10,233 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GameFramework/SaveGame.h"
+#include "HAL/CriticalSection.h"
 #include "UObject/Object.h"
 #include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/StrongObjectPtr.h"
 
 #include "SaveGameSerializer.generated.h"
 
-class USaveGame;
+class ISaveGameSystem;
+struct FInstancedStruct;
+struct FStreamableHandle;
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * Deduplicated table of strings (like object paths, class paths and names) that are referenced by serialized data.
+ * Each distinct string is stored only once, references to it are stored as packed indices into this table.
+ */
+struct WEEKENDSAVEGAME_API FWeekendUtilsSaveGameNameTable
+{
+	/** @param bIsLoadablePath Marks the string as path of a class or asset that can be loaded before deserializing data. */
+	int32 FindOrAdd(const FString& String, bool bIsLoadablePath = false);
+	const FString* Find(int32 Index) const;
+	int32 Num() const { return Strings.Num(); }
+	void Empty();
+
+	/** @returns all paths of classes and assets that were marked as loadable. */
+	TArray<FSoftObjectPath> GetLoadablePaths() const;
+
+	/** @param bWithLoadablePaths Whether the serialized data contains loadable path markers (not the case for older data). */
+	void Serialize(FArchive& Ar, bool bWithLoadablePaths = true);
+	friend FArchive& operator<<(FArchive& Ar, FWeekendUtilsSaveGameNameTable& NameTable);
+
+private:
+	TArray<FString> Strings = {};
+	TMap<FString, int32> IndicesByString = {};
+	TSet<int32> LoadablePathIndices = {};
+};
+
+/**
+ * Per-load cache for objects and classes resolved from their serialized paths.
+ * Failed lookups are remembered as well, so each distinct path is only looked up once per load.
+ * (i) Objects are not referenced by the cache, so it must not outlive the deserialization it is used for.
+ */
+struct WEEKENDSAVEGAME_API FWeekendUtilsResolvedObjectCache
+{
+	UObject* FindOrLoadObject(const FString& ObjectPath, bool bLoadIfFindFails);
+	UClass* FindOrLoadClass(const FString& ClassPath, bool bLoadIfFindFails);
+
+	int32 GetNumHits() const { return NumHits; }
+	int32 GetNumMisses() const { return NumMisses; }
+
+private:
+	TMap<FString, UObject*> ObjectsByPath = {};
+	TMap<FString, UClass*> ClassesByPath = {};
+	int32 NumHits = 0;
+	int32 NumMisses = 0;
+};
+
 /**
  * Extends a proxy archive that serializes UObjects and FNames as string data.
+ * If a name table is given, the strings are stored in the table and only referenced by index.
+ * Without a name table, the archive behaves exactly like @FObjectAndNameAsStringProxyArchive.
+ */
+struct WEEKENDSAVEGAME_API FWeekendUtilsNameTableProxyArchive : FObjectAndNameAsStringProxyArchive
+{
+	FWeekendUtilsNameTableProxyArchive(FArchive& InInnerArchive, FWeekendUtilsSaveGameNameTable* InNameTable, bool bInLoadIfFindFails = true);
+	virtual FArchive& operator<<(FName& Name) override;
+	virtual FArchive& operator<<(UObject*& Obj) override;
+	FWeekendUtilsSaveGameNameTable* NameTable;
+
+	/** Optional cache for resolving serialized object paths when loading. */
+	FWeekendUtilsResolvedObjectCache* ResolvedObjectCache = nullptr;
+
+protected:
+	/** Serializes a string either as table index or - without name table - as plain string. */
+	void SerializeString(FString& String, bool bIsLoadablePath = false);
+
+	UObject* ResolveObject(const FString& ObjectPath);
+	UClass* ResolveClass(const FString& ClassPath);
+
+	/** @returns whether given object is a class or asset that can be loaded up front, without loading a level. */
+	static bool IsLoadableReference(const UObject* Object);
+};
+
+/**
+ * Extends a proxy archive that serializes UObjects and FNames as string data (or name table indices).
  * Recursively serializes sub-objects nested inside serialized objects and restores
  * them by allocating them via NewObject<T>().
  */
-struct WEEKENDSAVEGAME_API FWeekendUtilsSubobjectProxyArchive : FObjectAndNameAsStringProxyArchive
+struct WEEKENDSAVEGAME_API FWeekendUtilsSubobjectProxyArchive : FWeekendUtilsNameTableProxyArchive
 {
 	FWeekendUtilsSubobjectProxyArchive(FArchive& InInnerArchive, UObject& InSubobjectOwner, bool bInLoadIfFindFails = true);
+	FWeekendUtilsSubobjectProxyArchive(FArchive& InInnerArchive, UObject& InSubobjectOwner, FWeekendUtilsSaveGameNameTable* InNameTable, bool bInLoadIfFindFails = true);
 	virtual FArchive& operator<<(UObject*& Obj) override;
 	UObject& SubobjectOwner;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
+/** Metadata of a single slot within the @FSaveGameSlotIndex. */
+struct WEEKENDSAVEGAME_API FSaveGameSlotIndexEntry
+{
+	FString SlotName = {};
+	int32 UserIndex = 0;
+
+	/** Size and last modification time of the slot file, which must both match the file for the entry to be used. */
+	int64 NumBytes = 0;
+	FDateTime Timestamp = FDateTime::MinValue();
+
+	/** CRC32 of the slot data as it is stored. 0 = unknown. Keeps the entry valid when only the timestamp of its slot file changed. */
+	uint32 Checksum = 0;
+
+	/** Header data of the slot, encoded by @FSaveGameSlotIndex::EncodeHeaderData. Empty if the slot has no header data. */
+	TArray<uint8> EncodedHeaderData = {};
+
+	bool IsUpToDate(int64 FileSize, const FDateTime& FileTimestamp) const { return (NumBytes == FileSize && Timestamp == FileTimestamp); }
+	bool HasSameContent(int64 FileSize, uint32 FileChecksum) const { return (Checksum != 0 && NumBytes == FileSize && Checksum == FileChecksum); }
+	friend FArchive& operator<<(FArchive& Ar, FSaveGameSlotIndexEntry& Entry);
+};
+
+/**
+ * Small index file next to the local save files, which holds the metadata of all slots. Slot lists can then be read from
+ * a single file, instead of opening each slot file. Entries are only used while size and timestamp of their slot file
+ * still match, or while the checksum of the slot data does. Otherwise they are rebuilt from the slot file (e.g. after
+ * a crash, or when files were copied by hand).
+ *
+ * Thread-safe: Every update is a locked read-modify-write, which replaces the index file via temporary file and rename.
+ */
+struct WEEKENDSAVEGAME_API FSaveGameSlotIndex
+{
+	using FSlotName = FString;
+
+	/** Entries are kept per slot and user, since platform save systems may store the same slot name once per user. */
+	using FEntryKey = TPair<FSlotName, int32>;
+
+	static FString GetIndexFilePath();
+	static FEntryKey MakeEntryKey(const FSlotName& SlotName, int32 UserIndex) { return FEntryKey(SlotName, UserIndex); }
+
+	/** @returns false if there is no (intact) index file, which is then rebuilt by the following updates. */
+	static bool TryReadEntries(TMap<FEntryKey, FSaveGameSlotIndexEntry>& OutEntriesByKey);
+
+	/** Adds or replaces the entries of their slots. */
+	static bool TryUpdateEntries(TArray<FSaveGameSlotIndexEntry>&& Entries);
+
+	/** Removes the entry of a slot, e.g. after the slot was deleted. */
+	static bool TryRemoveEntry(const FSlotName& SlotName, int32 UserIndex);
+
+	/**
+	 * Header data is encoded with the paths of its struct types. Both can be called from any thread, but struct types that are
+	 * not loaded yet are only loaded on the game thread. Decoding header data of such types fails on other threads.
+	 */
+	static TArray<uint8> EncodeHeaderData(const FInstancedStruct& HeaderData);
+	static bool TryDecodeHeaderData(const TArray<uint8>& EncodedHeaderData, FInstancedStruct& OutHeaderData);
+
+private:
+	static constexpr uint32 FileTypeTagValue = 0x58444957; // "WIDX"
+	static constexpr int32 FileVersionValue = 2;
+
+	static FCriticalSection IndexFileLock;
+
+	static bool TryReadEntriesLocked(TMap<FEntryKey, FSaveGameSlotIndexEntry>& OutEntriesByKey);
+	static bool TryWriteEntriesLocked(const TMap<FEntryKey, FSaveGameSlotIndexEntry>& EntriesByKey);
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/** Limits for the backups that are kept of deleted slots. Older backups are removed first, but the newest one is always kept. */
+struct WEEKENDSAVEGAME_API FSaveGameBackupRotationPolicy
+{
+	/** 0 = unlimited. */
+	int32 MaxBackupsPerSlot = 0;
+
+	/** 0 = unlimited. */
+	int64 MaxBackupBytesPerSlot = 0;
+
+	bool IsUnlimited() const { return (MaxBackupsPerSlot <= 0 && MaxBackupBytesPerSlot <= 0); }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * SaveGame object that is restored from save data step by step, so that async loads can spread the construction of its objects
+ * across frames. Everything that does not need UObjects (like parsing headers and tables) was prepared on a worker thread before.
+ * Serializers extend it with the data they prepare, see @USaveGameSerializer::MakeSaveDataPreparer.
+ */
+struct WEEKENDSAVEGAME_API FSaveGameDeserialization
+{
+	virtual ~FSaveGameDeserialization() = default;
+
+	/** Decoded save data. */
+	TSharedPtr<const TArray<uint8>> SaveData = nullptr;
+
+	/** Paths of classes and assets referenced by the save data, which are preloaded if they are not loaded yet. */
+	TArray<FSoftObjectPath> LoadablePaths = {};
+
+	/** The SaveGame object under construction, which is kept alive while its construction is spread across frames. */
+	TStrongObjectPtr<USaveGame> SaveGameObject = nullptr;
+
+	/** Reset before each time slice, since it does not keep the objects it references alive. */
+	FWeekendUtilsResolvedObjectCache ResolvedObjectCache = {};
+
+	int32 NumStepsDone = 0;
+	bool bIsComplete = false;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/** Timings and size of the most recent run through the save or load pipeline of a @USaveGameSerializer. */
+struct WEEKENDSAVEGAME_API FSaveGamePipelineStats
+{
+	/** Time (in seconds) the game thread was blocked by capturing the SaveGame snapshot, or by constructing the loaded SaveGame. */
+	double GameThreadSeconds = 0.0;
+
+	/** Time (in seconds) a worker thread spent encoding and writing the snapshot, or reading, verifying, decoding and preparing the loaded data. */
+	double WorkerSeconds = 0.0;
+
+	/** Time (in seconds) from the request until the callback, including waiting for threads, asset preloads and further frames. */
+	double LatencySeconds = 0.0;
+
+	/** Size of the final data that was written to the slot, or of the decoded data that was loaded. */
+	int64 NumBytes = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
 /**
  * Polymorphic sub-object of @USaveGameService that extracts implementation details of
  * SaveGame serialization, deserialization, and save file management.
@@ -48,7 +252,37 @@ public:
 
 	DECLARE_DELEGATE_ThreeParams(FOnAsyncSaveCompleted, const FSlotName&, const int32, bool);
 	DECLARE_DELEGATE_ThreeParams(FOnAsyncLoadCompleted, const FSlotName&, const int32, USaveGame*);
+	DECLARE_DELEGATE_TwoParams(FOnAsyncHeaderScanCompleted, const int32, const TMap<FSlotName, FInstancedStruct>& /*HeaderDataBySlot*/);
+	DECLARE_DELEGATE_TwoParams(FOnAsyncVerifyCompleted, const int32, const TMap<FSlotName, bool>& /*IsIntactBySlot*/);
+	DECLARE_DELEGATE_TwoParams(FOnAsyncFindSlotsCompleted, const int32, const TMap<FSlotName, FDateTime>& /*TimestampsOfExistingSlots*/);
+	DECLARE_DELEGATE_ThreeParams(FOnAsyncDeleteCompleted, const FSlotName&, const int32, bool);
+
+	/**
+	 * Worker stage of the save pipeline: Transforms a captured snapshot into the final save data, in place.
+	 * Created on the game thread, but executed on a worker thread during async saves. The function must
+	 * therefore be self-contained and must neither access UObjects nor this serializer.
+	 */
+	using FSaveDataEncoder = TFunction<bool(TArray<uint8>& InOutSaveData)>;
+
+	/**
+	 * Worker stage of the load pipeline: Reverts the encoding of loaded save data, in place.
+	 * Same restrictions as for @FSaveDataEncoder. TryDeserializeSaveGame must also accept data that was not decoded yet.
+	 */
+	using FSaveDataDecoder = TFunction<bool(TArray<uint8>& InOutSaveData)>;
+
+	/**
+	 * Integrity check of loaded save data (e.g. by checksums), which must not deserialize any objects.
+	 * Same restrictions as for @FSaveDataEncoder, since it is executed on worker threads as well. @returns false for corrupted data.
+	 */
+	using FSaveDataVerifier = TFunction<bool(const TArray<uint8>& InSaveData)>;
 
+	/**
+	 * Worker stage of the load pipeline: Parses decoded save data (e.g. its header and tables) without constructing any objects.
+	 * Same restrictions as for @FSaveDataEncoder. @returns nullptr if the SaveGame can only be deserialized at once (by TryDeserializeSaveGame).
+	 */
+	using FSaveDataPreparer = TFunction<TSharedPtr<FSaveGameDeserialization>(const TSharedRef<TArray<uint8>>& InSaveData)>;
+
+	/** Serializes the SaveGame object into its final save data (= snapshot + encoding) on the calling thread. */
 	virtual bool TrySerializeSaveGame(USaveGame& InSaveGameObject, TArray<uint8>& OutSaveData) const;
 	virtual bool TryDeserializeSaveGame(const TArray<uint8>& InSaveData, USaveGame*& OutSaveGameObject) const;
 
@@ -63,4 +297,178 @@ public:
 	virtual void AsyncLoadGameFromSlot(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncLoadCompleted Callback);
 
 	virtual bool TryDeleteGameInSlot(const FSlotName& SlotName, const int32 UserIndex, TOptional<FString> OptionalBackupFolder = {});
+
+	/**
+	 * Deletes a slot on a worker thread, or moves it into the backup folder (see @MakeBackupFolderName).
+	 * Older backups of the slot are then removed according to the @FSaveGameBackupRotationPolicy.
+	 * (i) Platform save systems only delete the slot, on the game thread, since they don't store local files that could be moved.
+	 */
+	virtual void AsyncDeleteGameInSlot(const FSlotName& SlotName, const int32 UserIndex, TOptional<FString> OptionalBackupFolder, FOnAsyncDeleteCompleted Callback);
+
+	/** @returns a new backup folder (relative to the local SaveGames folder) for deleted slots, which is subject to backup rotation. */
+	static FString MakeBackupFolderName();
+
+	/** @returns the folder that holds all SaveGames on platforms that store them as local files. */
+	static FString GetLocalSaveGamesDir();
+
+	/** Whether slot metadata is kept in an @FSaveGameSlotIndex, see @USaveGameServiceSettings::bUseSlotIndexFile. */
+	virtual bool UsesSlotIndex() const;
+
+	/** Whether each slot is written into its backup slot first, see @USaveGameServiceSettings::bUseAtomicSlotWrites. */
+	virtual bool UsesAtomicSlotWrites() const;
+
+	/** @returns the slot that holds the last complete write of given slot, when atomic slot writes are used. */
+	static FSlotName GetBackupSlotName(const FSlotName& SlotName) { return SlotName + BackupSlotSuffix; }
+	static bool IsBackupSlotName(const FSlotName& SlotName) { return SlotName.EndsWith(BackupSlotSuffix); }
+
+	/** Checks the integrity of the data in a slot, without deserializing it. @returns false if the slot does not exist or is corrupted. */
+	virtual bool TryVerifySlot(const FSlotName& SlotName, const int32 UserIndex);
+
+	/** Checks the integrity of multiple slots on a worker thread, e.g. to validate all slots at startup. */
+	virtual void AsyncVerifySlots(const TArray<FSlotName>& SlotNames, const int32 UserIndex, FOnAsyncVerifyCompleted Callback);
+
+	/** Reads only the custom header data from the beginning of the save data. @returns false if the save data has no header data. */
+	virtual bool TryDeserializeHeaderData(const TArray<uint8>& InSaveData, FInstancedStruct& OutHeaderData) const { return false; }
+
+	/** Reads only the header data of a slot, without reading the whole file or deserializing the SaveGame. */
+	virtual bool TryLoadHeaderDataFromSlot(const FSlotName& SlotName, const int32 UserIndex, FInstancedStruct& OutHeaderData);
+
+	/**
+	 * Reads only the header data of multiple slots. The beginning of each file is read on a worker thread,
+	 * the header data is then decoded on the game thread. Slots without (readable) header data are skipped.
+	 * With a slot index, unchanged slots are not read at all, and entries of changed slots are rebuilt along the way.
+	 */
+	virtual void AsyncLoadHeaderDataFromSlots(const TArray<FSlotName>& SlotNames, const int32 UserIndex, FOnAsyncHeaderScanCompleted Callback);
+
+	/**
+	 * Finds which of the given slots exist on a worker thread, together with the last modification time of their files.
+	 * Timestamps are FDateTime::MinValue() when the platform does not store SaveGames as local files. Missing slots are skipped.
+	 */
+	virtual void AsyncFindExistingSlots(const TArray<FSlotName>& SlotNames, const int32 UserIndex, FOnAsyncFindSlotsCompleted Callback);
+
+	/**
+	 * Collects paths of classes and assets referenced by given SaveGame data, which are not loaded yet.
+	 * AsyncLoadGameFromSlot loads them asynchronously before the data is deserialized, to avoid synchronous loads.
+	 */
+	virtual void GatherPathsToPreload(const TArray<uint8>& InSaveData, TArray<FSoftObjectPath>& OutPaths) const {}
+
+	/** @returns timings of the last save that went through the async save pipeline. */
+	const FSaveGamePipelineStats& GetLastSaveStats() const { return LastSaveStats; }
+
+	/** @returns timings of the last load that went through the async load pipeline. */
+	const FSaveGamePipelineStats& GetLastLoadStats() const { return LastLoadStats; }
+
+	/** @returns the given percentile (0 - 1) of the latencies (in seconds) of the most recent async loads, or 0 if there were none yet. */
+	double GetLoadLatencyPercentile(double Percentile) const;
+
+	/** @returns the (encoded) bytes that were written by the last successful save, which can be deserialized again. */
+	TSharedPtr<const TArray<uint8>> GetLastSavedData() const { return LastSavedData; }
+
+protected:
+	/**
+	 * Game thread stage of the save pipeline: Serializes all properties of the SaveGame object into a
+	 * self-contained byte snapshot, so the SaveGame object can be modified again right after this call.
+	 */
+	virtual bool TryCaptureSaveGameSnapshot(USaveGame& InSaveGameObject, TArray<uint8>& OutSnapshotData) const;
+
+	/** @returns the encoder that is applied to captured snapshots before they are written, or nullptr if none is needed. */
+	virtual FSaveDataEncoder MakeSaveDataEncoder() const { return nullptr; }
+
+	/** @returns the decoder that is applied to loaded data on a worker thread during async loads, or nullptr if none is needed. */
+	virtual FSaveDataDecoder MakeSaveDataDecoder() const { return nullptr; }
+
+	/** @returns the verifier that loaded data must pass before it is used, or nullptr if the data can't be verified. */
+	virtual FSaveDataVerifier MakeSaveDataVerifier() const { return nullptr; }
+
+	/** @returns the limits for backups of deleted slots, see @USaveGameServiceSettings::MaxBackupsPerSlot. */
+	virtual FSaveGameBackupRotationPolicy MakeBackupRotationPolicy() const;
+
+	/** @returns the preparer that is applied to decoded data on a worker thread during async loads, or nullptr if none is needed. */
+	virtual FSaveDataPreparer MakeSaveDataPreparer() const { return nullptr; }
+
+	/**
+	 * Game thread stage of the load pipeline: Performs the next step of constructing the SaveGame object of a prepared deserialization,
+	 * which then counts NumStepsDone up and sets bIsComplete after the last step. @returns false if the construction failed.
+	 */
+	virtual bool TryDeserializeSaveGameStep(FSaveGameDeserialization& InOutDeserialization) const { return false; }
+
+	/**
+	 * Game thread stage of updating the slot index after a save: Deserializes the header data, then encodes it and updates the index
+	 * on a worker thread. Continues on the game thread first, when called from another thread.
+	 */
+	void UpdateSlotIndexAsync(const FSlotName& SlotName, const int32 UserIndex, const TSharedRef<const TArray<uint8>>& SaveData) const;
+
+	/** State of one run through the async load pipeline, which is passed from stage to stage. */
+	struct FAsyncLoad;
+
+	/**
+	 * Worker stage of the async load pipeline: Reads the slot through the generic save system if bReadSlot is set (otherwise the data
+	 * was already loaded, see bLoadedSuccessfully), then verifies, decodes and prepares the loaded data.
+	 */
+	void LaunchAsyncLoadWorkerStage(const TSharedRef<FAsyncLoad>& AsyncLoad, bool bReadSlot, bool bLoadedSuccessfully);
+
+	/** Game thread stage of the async load pipeline for platform save systems: Loads the slot through their async API, then continues on the worker stage. */
+	void LoadSlotAsync(ISaveGameSystem& SaveSystem, const TSharedRef<FAsyncLoad>& AsyncLoad, const FSlotName& SlotNameToLoad);
+
+	/** Game thread stage of the async load pipeline for platform save systems: Loads the backup slot, after the slot was missing or corrupted. */
+	void LoadBackupSlotAsync(const TSharedRef<FAsyncLoad>& AsyncLoad);
+
+	/** Game thread stage of the async load pipeline: Preloads referenced assets if needed, then constructs the SaveGame object. */
+	void FinishAsyncLoad(const TSharedRef<FAsyncLoad>& AsyncLoad);
+
+	/** Constructs the SaveGame object right away, or spread across frames (see @USaveGameServiceSettings::AsyncLoadBudgetMs). */
+	void ConstructSaveGameAsync(const TSharedRef<FAsyncLoad>& AsyncLoad);
+
+	/** @returns true while construction steps remain after this time slice. BudgetSeconds <= 0 = all remaining steps. */
+	bool ContinueSaveGameConstruction(const TSharedRef<FAsyncLoad>& AsyncLoad, double BudgetSeconds);
+
+	void CompleteAsyncLoad(const TSharedRef<FAsyncLoad>& AsyncLoad, USaveGame* LoadedGame);
+
+	/** Amount of bytes read from the beginning of a save file when only the header data is needed. */
+	static constexpr int64 HeaderScanReadSize = 64 * 1024;
+
+	/**
+	 * Thread-safe: Reads the first MaxBytesToRead bytes of a slot. Falls back to reading the whole slot when the platform does not
+	 * store SaveGames as local files, which is only done on the game thread. @returns whether the whole slot was read.
+	 */
+	static bool TryLoadDataPrefixFromSlot(const FSlotName& SlotName, const int32 UserIndex, const int64 MaxBytesToRead, TArray<uint8>& OutData);
+
+	static FString GetLocalSaveGameFilePath(const FSlotName& SlotName, TOptional<FString> OptionalSubFolder = {});
+
+	/** Thread-safe with the generic save system only: @returns whether the slot (or its backup slot) exists, see @AsyncFindExistingSlots for the timestamp. */
+	static bool TryFindSlotTimestamp(const FSlotName& SlotName, const int32 UserIndex, bool bWithBackupSlot, FDateTime& OutTimestamp);
+
+	/**
+	 * Thread-safe with the generic save system only: Writes the data to a slot. With atomic slot writes, the data is written into the
+	 * backup slot first, and only then into the slot itself. One of both always holds a complete SaveGame, so a torn write never loses
+	 * the last good SaveGame.
+	 */
+	static bool TryWriteDataToSlot(ISaveGameSystem& SaveSystem, const TArray<uint8>& InSaveData, const FSlotName& SlotName, const FPlatformUserId PlatformUserId, bool bAtomicSlotWrite);
+
+	/** Game thread: Writes the data like @TryWriteDataToSlot, but through the async API of the save system, which platform save systems require. */
+	static void WriteDataToSlotAsync(ISaveGameSystem& SaveSystem, const TSharedRef<const TArray<uint8>>& SaveData, const FSlotName& SlotName,
+		const FPlatformUserId PlatformUserId, bool bAtomicSlotWrite, TFunction<void(bool)> OnCompleted);
+
+	/** Thread-safe with the generic save system only: Deletes a slot or moves it into the backup folder, then rotates the backups of the slot. */
+	static bool TryDeleteDataInSlot(const FSlotName& SlotName, const FPlatformUserId PlatformUserId, const TOptional<FString>& OptionalBackupFolder, const FSaveGameBackupRotationPolicy& BackupRotation);
+
+	/** Thread-safe: Removes the oldest backups of a slot from all backup folders, until the rest fits into the policy. */
+	static void RotateBackupsOfSlot(const FSlotName& SlotName, const FSaveGameBackupRotationPolicy& BackupRotation);
+
+	static constexpr const TCHAR* BackupFolderPrefix = TEXT("Backup_");
+
+	/** Thread-safe: Reads the backup slot of a slot, which was written by the last atomic write. @returns false if there is no (intact) backup. */
+	static bool TryLoadBackupDataFromSlot(const FSlotName& SlotName, const FPlatformUserId PlatformUserId, const FSaveDataVerifier& Verifier, TArray<uint8>& OutSaveData);
+
+	/** (i) Backup slots are regular slots of the ISaveGameSystem, see @USaveGameUtils::FindAllLocalSaveGameSlotNames. */
+	static constexpr const TCHAR* BackupSlotSuffix = TEXT(".bak");
+
+	FSaveGamePipelineStats LastSaveStats;
+	TSharedPtr<const TArray<uint8>> LastSavedData = nullptr;
+
+	/** Latencies of the most recent async loads as ring buffer, see @GetLoadLatencyPercentile. */
+	static constexpr int32 NumRecentLoadLatencies = 64;
+	TArray<double> RecentLoadLatencies = {};
+	int32 RecentLoadLatenciesHead = 0;
+	FSaveGamePipelineStats LastLoadStats;
 };
@@ -10,9 +10,12 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
 #include "CurrentSaveGame.h"
 #include "GameFramework/SaveGame.h"
 #include "GameService/GameServiceBase.h"
+#include "SaveGameDebugHistory.h"
+#include "StructUtils/InstancedStruct.h"
 
 #include "SaveGameService.generated.h"
 
@@ -57,6 +60,7 @@ public:
 
 	DECLARE_DELEGATE_TwoParams(FOnSaveLoadCompleted, USaveGame*, bool /*bSuccess*/)
 	DECLARE_DELEGATE_TwoParams(FOnPreloadCompleted, TArray<USaveGame*>, TArray<FSlotName>)
+	DECLARE_DELEGATE_OneParam(FOnHeaderScanCompleted, const TMap<FSlotName, FInstancedStruct>& /*HeaderDataBySlot*/)
 
 	USaveGameService()
 	{
@@ -141,6 +145,20 @@ public:
 	/** Asynchronously loads (but not restores) SaveGame files into a persistent cache. Preloading is useful for displaying available SaveGames. */
 	virtual void PreloadSaveGamesAsync(const TSet<FSlotName>& SlotNames, const FOnPreloadCompleted& Callback);
 
+	/**
+	 * Asynchronously reads only the header data of SaveGame files into a persistent cache, without loading the SaveGames.
+	 * This is much cheaper than preloading and sufficient for e.g. finding the most recent SaveGame or displaying slots.
+	 */
+	virtual void ScanSaveGameHeadersAsync(const TSet<FSlotName>& SlotNames, const FOnHeaderScanCompleted& Callback);
+
+	/**
+	 * Checks on a worker thread which slots allowed for saving or loading exist, then rescans the header data of those whose files
+	 * were added or changed since the last refresh. Each rescanned slot broadcasts @OnAvailableSaveGamesChanged on its own,
+	 * so lists can update incrementally. Afterwards, slot queries like @GetSlotNamesAllowedForLoading don't touch the file system.
+	 */
+	virtual void RefreshSlotCatalogAsync();
+	FORCEINLINE bool IsRefreshingSlotCatalog() const { return (NumPendingSlotCatalogTasks > 0); }
+
 	/** Sets and restores an already loaded SaveGame as current SaveGame. */
 	virtual void RestoreAsCurrentSaveGame(USaveGame& SaveGame, TOptional<FSlotName> LoadedFromSlotName = {});
 	/** Sets and restores an already loaded SaveGame as current SaveGame. Afterwards, travel into the level stored in the SaveGame. */
@@ -154,7 +172,7 @@ public:
 	/** Resets the current SaveGame to a new one and tells all restoring listeners. */
 	virtual void CreateAndRestoreNewSaveGameAsCurrent(); 
 
-	/** Removes a cached SaveGame, if it exists and deletes the respective save file. */
+	/** Removes the cached SaveGame and header data of the slot and deletes its save file on a worker thread, if the file exists. */
 	virtual void DeleteSaveGameAtSlot(const FSlotName& SlotName, bool bMoveToBackupFolder = true);
 
 	///////////////////////////////////////////////////////////////////////////////////////
@@ -198,7 +216,13 @@ public:
 	FORCEINLINE const FCurrentSaveGame& GetCurrentSaveGame() const { return CurrentSaveGame; }
 	FORCEINLINE virtual uint32 GetCurrentUserIndex() const { return 0; }
 	FORCEINLINE EStatus GetCurrentStatus() const { return CurrentStatus; }
-	FORCEINLINE TArray<FString> GetDebugHistory() const { return DebugHistory; }
+	FORCEINLINE int32 GetNumDebugHistoryEntries() const { return DebugHistory.Num(); }
+
+	/** Formats the debug history, oldest entry first. Prefer @ForEachDebugHistoryEntry when the strings are not needed. */
+	TArray<FString> GetDebugHistory() const;
+
+	/** Visits the structured debug history without formatting it, oldest entry first. */
+	void ForEachDebugHistoryEntry(TFunctionRef<void(const FSaveGameDebugHistoryEntry&)> Visitor) const;
 
 	virtual bool IsAutosavingAllowed() const;
 	virtual bool IsSavingAllowed() const;
@@ -227,6 +251,10 @@ public:
 	bool IsCachedSaveGameSnapshot(const USaveGame& SaveGameObject) const;
 	bool HasAnyCachedSaveGameSnapshot() const;
 
+	/** @returns header data of a slot that was either scanned, saved, or loaded before. */
+	const FInstancedStruct* GetCachedHeaderDataAtSlot(const FSlotName& SlotName) const;
+	bool HasAnyCachedHeaderData() const;
+
 protected:
 	///////////////////////////////////////////////////////////////////////////////////////
 	/// STATE
@@ -245,27 +273,68 @@ protected:
 	///////////////////////////////////////////////////////////////////////////////////////
 	/// CACHE
 
-	/** Cached snapshots may never be modified, which is why this container only provides CopyTo/CopyFrom accessors. */
+	/**
+	 * Cached snapshots may never be modified, which is why this container only provides CopyTo/CopyFrom accessors.
+	 * Snapshots are kept as serialized bytes plus decoded header data. They are only deserialized into SaveGame objects
+	 * on demand: Once for read-only access (kept until the snapshot is replaced), and once per mutable copy.
+	 */
 	struct FSaveGamesCache
 	{
 	public:
 		bool Contains(const FSlotName& SlotName) const;
+		int32 Num() const;
 		void Remove(const FSlotName& SlotName);
 		void Clear();
-		void CopyToCache(USaveGameService& InService, const FSlotName& SlotName, const USaveGame& SaveGame);
-		USaveGame* CopyFromCache(USaveGameService& InService, const FSlotName& SlotName) const;
-		const USaveGame* Find(const FSlotName& SlotName) const;
-		TMap<FSlotName, const USaveGame*> GetAllObjectsBySlot() const;
+		void CopyToCache(const USaveGameService& InService, const FSlotName& SlotName, USaveGame& SaveGame);
+		void CopyToCache(const USaveGameService& InService, const FSlotName& SlotName, const TSharedRef<const TArray<uint8>>& SaveData);
+		USaveGame* CopyFromCache(const USaveGameService& InService, const FSlotName& SlotName) const;
+		const USaveGame* Find(const USaveGameService& InService, const FSlotName& SlotName) const;
+		const FInstancedStruct* FindHeaderData(const FSlotName& SlotName) const;
+		int64 GetSaveDataSize(const FSlotName& SlotName) const;
+		bool IsSnapshotObject(const USaveGame& SaveGame) const;
+		TMap<FSlotName, const USaveGame*> GetAllObjectsBySlot(const USaveGameService& InService) const;
 
 	private:
-		TMap<FSlotName, TStrongObjectPtr<const USaveGame>> SnapshotsBySlot = {};
+		struct FSnapshot
+		{
+			TSharedPtr<const TArray<uint8>> SaveData = nullptr;
+			FInstancedStruct HeaderData = {};
+			mutable TStrongObjectPtr<const USaveGame> Object = nullptr;
+		};
+
+		TMap<FSlotName, FSnapshot> SnapshotsBySlot = {};
+		mutable TSet<const USaveGame*> SnapshotObjects = {};
+
+		void AddSnapshot(const USaveGameService& InService, const FSlotName& SlotName, const TSharedRef<const TArray<uint8>>& SaveData, FInstancedStruct&& HeaderData);
 	} CachedSaveGames;
 
+	/** Header data by slot, which is also available for slots whose SaveGames were never (pre)loaded. */
+	TMap<FSlotName, FInstancedStruct> CachedHeaderDataBySlot = {};
+	void UpdateCachedHeaderData(const FSlotName& SlotName);
+
+	/** Known existence and file timestamp of slots, which is updated by RefreshSlotCatalogAsync() and by saving or deleting slots. */
+	struct FSlotCatalogEntry
+	{
+		bool bExists = false;
+		FDateTime Timestamp = FDateTime::MinValue();
+	};
+	TMap<FSlotName, FSlotCatalogEntry> SlotCatalog = {};
+	int32 NumPendingSlotCatalogTasks = 0;
+
+	void HandleSlotCatalogRefreshed(const TArray<FSlotName>& CheckedSlotNames, const TMap<FSlotName, FDateTime>& TimestampsOfExistingSlots);
+	bool DoesCatalogedSaveFileExist(const FSlotName& SlotName) const;
+
+	/** Slots whose files are deleted on a worker thread right now. Saves and loads of these slots wait until the deletion is done. */
+	TSet<FSlotName> SlotsBeingDeleted = {};
+
 	///////////////////////////////////////////////////////////////////////////////////////
 	/// HISTORY
 
 	uint8 DebugHistoryEntriesToKeep = 0;
-	TArray<FString> DebugHistory = {};
+
+	/** Ring buffer of up to DebugHistoryEntriesToKeep entries. Once it is full, DebugHistoryHead is the index of the oldest entry. */
+	TArray<FSaveGameDebugHistoryEntry> DebugHistory = {};
+	int32 DebugHistoryHead = 0;
 
 	///////////////////////////////////////////////////////////////////////////////////////
 	/// REQUESTS
@@ -273,6 +342,14 @@ protected:
 	class ISaveLoadRequest : public TSharedFromThis<ISaveLoadRequest>
 	{
 	public:
+		enum class EState : uint8
+		{
+			Queued,
+			InProgress,
+			Completed,
+			Cancelled
+		};
+
 		virtual void Process();
 		virtual void Finish(USaveGame* RequestedSaveGame, bool bSuccess);
 		virtual void Cancel() {}
@@ -282,6 +359,9 @@ protected:
 		TOptional<FOnSaveLoadCompleted> RequestCallback = {};
 		TOptional<FSlotName> SlotName = {};
 		FDebugContext Context = FDebugContext();
+		EState State = EState::Queued;
+		bool bIsAutosave = false;
+		double EnqueueTime = 0.0;
 		double StartTime = 0.0;
 		double Runtime = 0.0;
 
@@ -326,7 +406,21 @@ protected:
 	TArray<TSharedRef<ISaveLoadRequest>> SaveRequestsInProgress = {};
 
 	TMap<FSlotName, TArray<TSharedRef<ISaveLoadRequest>>> PendingLoadRequestsBySlot = {};
-	TArray<TSharedRef<ISaveLoadRequest>> LoadRequestsInProgress = {};
+	TMap<FSlotName, TArray<TSharedRef<ISaveLoadRequest>>> LoadRequestsInProgressBySlot = {};
+
+	/** Time of the first and the last autosave request for a slot, while its autosave requests are waiting (see AutosaveDebounceSeconds). */
+	struct FAutosaveDebounce
+	{
+		double FirstRequestTime = 0.0;
+		double LastRequestTime = 0.0;
+	};
+
+	TMap<FSlotName, FAutosaveDebounce> AutosaveDebounceBySlot = {};
+	TOptional<FTSTicker::FDelegateHandle> AutosaveDebounceTickerHandle = {};
+
+	/** All queued and in-progress requests by their handle, so liveness checks and cancellation don't need to search the queues above. */
+	TMap<FGuid, TSharedRef<ISaveLoadRequest>> AliveSaveRequestsByHandle = {};
+	TMap<FGuid, TSharedRef<ISaveLoadRequest>> AliveLoadRequestsByHandle = {};
 
 	///////////////////////////////////////////////////////////////////////////////////////
 	/// LOCKS
@@ -359,7 +453,14 @@ protected:
 	void ConsumeSaveRequestsInProgress(USaveGame* SavedSaveGame, bool bSuccess);
 
 	FAsyncLoadGameHandle EnqueueLoadRequest(const FSlotName& SlotName, const TSharedRef<ISaveLoadRequest>& Request, bool bCancelIfLoadingIsNotAllowed = true);
-	void ConsumeLoadRequestsInProgress(USaveGame* LoadedSaveGame, bool bSuccess);
+	void ConsumeLoadRequestsInProgress(const FSlotName& SlotName, USaveGame* LoadedSaveGame, bool bSuccess);
+
+	void CancelQueuedRequest(const FGuid& Handle, TMap<FGuid, TSharedRef<ISaveLoadRequest>>& AliveRequestsByHandle, TMap<FSlotName, TArray<TSharedRef<ISaveLoadRequest>>>& PendingRequestsBySlot);
+	void UpdateRequestStats() const;
+
+	void UpdateAutosaveDebounce(const FSlotName& SlotName, const ISaveLoadRequest& Request);
+	bool IsAutosaveDebounced(const FSlotName& SlotName) const;
+	void ScheduleDebouncedAutosaves();
 
 	///////////////////////////////////////////////////////////////////////////////////////
 	/// SAVE & LOAD
@@ -385,8 +486,16 @@ protected:
 	virtual void CreateWorldTransitionSaveLoadLocks();
 
 	virtual void SetStatus(const EStatus& NewStatus);
+	virtual void AddDebugEntry(FSaveGameDebugHistoryEntry&& Entry);
+	void AddDebugEntry(ESaveGameDebugEvent Event, const FDebugContext& Context, const FSlotName& SlotName = FSlotName());
+	void AddDebugEntry(ESaveGameDebugEvent Event, const FDebugContext& Context, const FSlotName& SlotName, bool bSuccess, double ExecTime, int64 NumBytes = -1);
+	void AddLockDebugEntry(ESaveGameDebugEvent Event, const FDebugContext& Context, const FSaveLoadLockHandle& Key, const UObject* KeyHolder = nullptr);
+
+	UE_DEPRECATED(5.5, "Use the AddDebugEntry overloads that take an ESaveGameDebugEvent instead.")
 	virtual void AddDebugEntry(const FString& Entry);
+	UE_DEPRECATED(5.5, "Use the AddDebugEntry overloads that take an ESaveGameDebugEvent instead.")
 	virtual void AddDebugEntry(const FString& Operation, const FDebugContext& Context);
+	UE_DEPRECATED(5.5, "Use the AddDebugEntry overloads that take an ESaveGameDebugEvent instead.")
 	virtual void AddDebugEntry(const FString& Operation, const FDebugContext& Context, bool bSuccess, double ExecTime);
 };
 
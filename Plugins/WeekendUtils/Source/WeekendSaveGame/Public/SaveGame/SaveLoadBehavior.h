@@ -18,6 +18,7 @@ class USaveGame;
 class USaveGameSerializer;
 class USaveGameService;
 struct FCurrentSaveGame;
+struct FInstancedStruct;
 
 WEEKENDSAVEGAME_API DECLARE_LOG_CATEGORY_EXTERN(LogSaveLoadBehavior, Verbose, All);
 
@@ -78,6 +79,9 @@ public:
 	/** @returns timestamp of the last time given SaveGame was saved. This can return nothing if the information doesn't exist. */
 	virtual TOptional<FDateTime> FindTimeOfLastSaveFromSaveGame(const USaveGame& SaveGame) const;
 
+	/** @returns timestamp of the last time a SaveGame with given header data was saved. This can return nothing if the information doesn't exist. */
+	virtual TOptional<FDateTime> FindTimeOfLastSaveFromHeaderData(const FInstancedStruct& HeaderData) const;
+
 	/** Attempts to travel into the level (hopefully) saved in given SaveGame. @returns whether this was successful. */
 	virtual bool TryTravelToSavedLevel(const FCurrentSaveGame& SaveGame);
 
@@ -90,8 +94,8 @@ protected:
 
 /**
  * Default implementation of a regular save/load behaviour with 8 slots.
- * Preloads all available SaveGames asynchronously at game start and set the most recently
- * saved one as current SaveGame, but does not travel into the saved level.
+ * Scans the headers of all available SaveGames asynchronously at game start, then loads only the
+ * most recently saved one and sets it as current SaveGame, but does not travel into the saved level.
  */
 UCLASS()
 class WEEKENDSAVEGAME_API UDefaultSaveLoadBehavior : public USaveLoadBehavior
@@ -111,6 +115,7 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Weekend Utils|Save Game")
 	TSet<FString> SaveSlotNames;
 
+	virtual void HandleHeaderScanCompleted(USaveGameService& SaveGameService, const TMap<FSlotName, FInstancedStruct>& HeaderDataBySlot);
 	virtual void HandlePreloadCompleted(USaveGameService& SaveGameService, TArray<USaveGame*> PreloadedSaveGames, TArray<FSlotName> PreloadedSlotNames);
 };
 
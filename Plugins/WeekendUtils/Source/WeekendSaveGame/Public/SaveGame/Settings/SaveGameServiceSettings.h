@@ -11,6 +11,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
+#include "SaveGame/SaveGameHeader.h"
 #include "SaveGame/Mocks/MockableSaveLoadBehavior.h"
 #include "SaveGame/SaveLoadBehavior.h"
 
@@ -55,10 +56,67 @@ public:
 	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Behavior", meta = (EditCondition = "!bAlwaysAllowSaving", MetaClass = "/Script/Engine.GameModeBase"))
 	TSet<FSoftClassPath> GameModesWhereSavingIsAllowed = {};
 
-	/** How many save/load events to keep in the debug history of the SaveGameService. History may be saved into the save game. */
+	/** How many save/load events to keep in the debug history of the SaveGameService (0 = none). History may be saved into the save game. */
 	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Behavior", AdvancedDisplay)
 	uint8 DebugHistoryEntriesToKeep = 16;
 
+	/**
+	 * How many async loads of different slots the SaveGameService may run at the same time (e.g. when preloading SaveGames).
+	 * Saves are always exclusive and requests for the same slot are always processed in order. 1 = strictly one request at a time.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Behavior", AdvancedDisplay, meta = (ClampMin = 1, UIMin = 1))
+	uint8 MaxConcurrentLoads = 1;
+
+	/**
+	 * Autosave requests wait this long before they are processed, and each further autosave request to the same slot restarts
+	 * the wait. All waiting requests are then completed by one single save. 0 = Autosave requests are processed right away.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Behavior", AdvancedDisplay, meta = (ClampMin = 0, Units = "s"))
+	float AutosaveDebounceSeconds = 0.0f;
+
+	/** Autosave requests never wait longer than this in total, even if further autosaves keep being requested. */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Behavior", AdvancedDisplay, meta = (ClampMin = 0, Units = "s", EditCondition = "AutosaveDebounceSeconds > 0"))
+	float AutosaveMaxLatencySeconds = 2.0f;
+
+	/**
+	 * Opt-in to spread constructing the objects of an async loaded SaveGame over multiple frames, with this much time per frame.
+	 * Reading, verifying and decoding the data always happens on worker threads. 0 = construct all objects at once.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Behavior", AdvancedDisplay, meta = (ClampMin = 0, Units = "Milliseconds"))
+	float AsyncLoadBudgetMs = 0.0f;
+
+	/**
+	 * Keep the metadata of all local slots (size, timestamp, checksum and header data) in one index file next to the slots,
+	 * which is updated with each save and delete. Slot lists then read that single file instead of opening each slot file.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Behavior", AdvancedDisplay)
+	bool bUseSlotIndexFile = false;
+
+	/**
+	 * Opt-in to write each slot twice through the platform's save system: Into a backup slot first, then into the slot itself.
+	 * A slot that is missing or corrupted (e.g. by a torn write) is then loaded from its backup slot instead. Doubles the amount of writes.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Backups")
+	bool bUseAtomicSlotWrites = false;
+
+	/** How many backups of deleted SaveGames are kept per slot. Older backups are removed first. 0 = unlimited. */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Backups", meta = (ClampMin = 0, UIMin = 0))
+	int32 MaxBackupsPerSlot = 8;
+
+	/** How much disk space the backups of deleted SaveGames may take per slot. Older backups are removed first. 0 = unlimited. */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Backups", meta = (ClampMin = 0, UIMin = 0, Units = "Megabytes"))
+	int32 MaxBackupMegabytesPerSlot = 0;
+
+	/**
+	 * Compression of modular SaveGames that are written from now on. The format is recorded in each file,
+	 * so files are always loaded with the format they were written with, regardless of this setting.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Compression")
+	ESaveGameCompressionFormat CompressionFormat = ESaveGameCompressionFormat::None;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Compression", meta = (EditCondition = "CompressionFormat != ESaveGameCompressionFormat::None"))
+	ESaveGameCompressionLevel CompressionLevel = ESaveGameCompressionLevel::Balanced;
+
 	/** Name of the SaveGame slot to save to while playing in editor (see @UDefaultPlayInEditorSaveLoadBehavior). */
 	UPROPERTY(Config, EditAnywhere, Category = "Weekend Utils|PIE")
 	FString DefaultPlayInEditorSaveGameSlotName = "PlayInEditor";
@@ -26,6 +26,9 @@ class USaveGameSlotViewModel;
 /**
  * Base class of a ViewModel that lists available SaveGame slots.
  * Works in accord with @USaveGameSlotViewModel.
+ *
+ * Slots are listed from the caches of the @USaveGameService, without touching the file system on the calling thread.
+ * Beginning the usage refreshes the slot catalog of the service in the background, which updates the list slot by slot.
  */
 UCLASS(Abstract)
 class WEEKENDSAVEGAME_API USaveGameListViewModel : public UMVVMViewModelBase,
@@ -16,6 +16,7 @@
 
 class USaveGame;
 class USaveGameService;
+struct FInstancedStruct;
 
 /**
  * Base class of a SaveGame slot ViewModel that acts as list element of @USaveGameListViewModel.
@@ -45,8 +46,20 @@ public:
 	UPROPERTY(FieldNotify, BlueprintReadOnly, Category = "Weekend Utils|Save Game")
 	bool bIsEmptySlot = false;
 
+	/** Information from the header data of the bound SaveGame, available even if the SaveGame itself was never loaded. */
+	UPROPERTY(FieldNotify, BlueprintReadOnly, Category = "Weekend Utils|Save Game")
+	FDateTime UtcTimeOfLastSave = FDateTime();
+
+	UPROPERTY(FieldNotify, BlueprintReadOnly, Category = "Weekend Utils|Save Game")
+	int32 SaveCounter = 0;
+
+	UPROPERTY(FieldNotify, BlueprintReadOnly, Category = "Weekend Utils|Save Game")
+	FSoftObjectPath LoadedLevel = FSoftObjectPath();
+
 	virtual void BindToModel(const FSlotName& SlotName, USaveGameService& SaveGameService, bool bCanSave, bool bCanLoad);
 	virtual void BindToSaveGame(const FSlotName& SlotName, const USaveGame& SaveGame) PURE_VIRTUAL(BindToSaveGame);
+	/** Called instead of BindToSaveGame() for slots of which only the header data was scanned. */
+	virtual void BindToSaveGameHeader(const FSlotName& SlotName, const FInstancedStruct& HeaderData) {}
 	virtual void BindToEmptySlot(const FSlotName& SlotName) PURE_VIRTUAL(BindToEmptySlot);
 	virtual void UnbindFromModel() PURE_VIRTUAL(UnbindFromModel);
 
@@ -55,6 +68,8 @@ public:
 protected:
 	FSlotName BoundSlotName = FSlotName();
 
+	void SetHeaderDataProperties(const FInstancedStruct* HeaderData);
+
 	UFUNCTION(BlueprintCallable, Category = "Weekend Utils|SaveGame")
 	bool TryLoadGameFromSlot();
 
@@ -12,6 +12,8 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+DECLARE_STATS_GROUP(TEXT("Save Game"), STATGROUP_SaveGame, STATCAT_Advanced);
+
 class FWeekendSaveGameModule : public IModuleInterface
 {
 public:
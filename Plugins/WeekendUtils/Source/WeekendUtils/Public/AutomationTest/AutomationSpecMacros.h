@@ -41,6 +41,13 @@
 	#define WE_BEGIN_DEFINE_SPEC(SpecName) \
 		BEGIN_DEFINE_SPEC(F##SpecName##Spec, SPEC_TEST_CATEGORY "." #SpecName, EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter) \
 		static inline const FString SpecTestWorldName = "FTestWorld_" #SpecName;
+	/**
+	 * Same as @WE_BEGIN_DEFINE_SPEC, but declares a benchmark spec that is only run with the performance filter,
+	 * so it does not slow down regular test runs. Ended with @WE_END_DEFINE_SPEC as well.
+	 */
+	#define WE_BEGIN_DEFINE_BENCHMARK_SPEC(SpecName) \
+		BEGIN_DEFINE_SPEC(F##SpecName##Spec, SPEC_TEST_CATEGORY "." #SpecName, EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter) \
+		static inline const FString SpecTestWorldName = "FTestWorld_" #SpecName;
 	#define WE_END_DEFINE_SPEC(SpecName) \
 		END_DEFINE_SPEC(F##SpecName##Spec) \
 		void F##SpecName##Spec::Define()
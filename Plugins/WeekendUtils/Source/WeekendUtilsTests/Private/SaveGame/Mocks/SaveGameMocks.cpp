@@ -0,0 +1,57 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#include "SaveGame/Mocks/SaveGameMocks.h"
+
+void UMockSaveGameModule::FillWithSyntheticData(const int32 NumEntries, const int32 Seed)
+{
+	Strings.Reset(NumEntries);
+	Integers.Reset(NumEntries);
+	Transforms.Reset();
+
+	FRandomStream RandomStream(Seed);
+	for (int32 i = 0; i < NumEntries; ++i)
+	{
+		Strings.Add(FString::Printf(TEXT("/Game/Maps/SyntheticLevel_%d.SyntheticLevel_%d:PersistentLevel.Actor_%d"), Seed, Seed, i));
+		Integers.Add(RandomStream.RandHelper(MAX_int32));
+		Transforms.Add(FName("Transform", i), FTransform(FRotator(0.0, RandomStream.FRandRange(0.0, 360.0), 0.0), RandomStream.GetUnitVector() * 1000.0));
+	}
+}
+
+void UMockLevelObject::FillWithSyntheticData(const int32 PayloadSize, const int32 Seed)
+{
+	FRandomStream RandomStream(Seed);
+	Health = RandomStream.RandRange(0, 100);
+	bIsActivated = (RandomStream.FRand() > 0.5f);
+	State = FName("SyntheticState", RandomStream.RandRange(0, 8));
+
+	// (i) Repetitive on purpose, since the states of similar level objects tend to be repetitive as well:
+	Payload.SetNumUninitialized(PayloadSize);
+	for (int32 i = 0; i < PayloadSize; ++i)
+	{
+		Payload[i] = static_cast<uint8>((i + Seed) % 16);
+	}
+}
+
+void UMockLevelObjectRestorer::SerializeAsLegacyModuleVersion(FArchive& Ar, int32 LegacyModuleVersion, const TMap<FString, UObject*>& ObjectsById)
+{
+	check(Ar.IsSaving() && Ar.ArIsSaveGame && LegacyModuleVersion < ModuleVersion_WithObjectStateKeys);
+	ModuleVersion = LegacyModuleVersion;
+	ObjectStates.Reset();
+	for (const TPair<FString, UObject*>& ObjectById : ObjectsById)
+	{
+		SaveObjectToState(*ObjectById.Value, false, OUT ObjectStates.Add(ObjectById.Key));
+	}
+
+	// (i) Skips ULevelObjectRestorer::Serialize(), which would convert the legacy states to keyed states before writing them:
+	UObject::Serialize(Ar);
+
+	ObjectStates.Reset();
+	ModuleVersion = ModuleVersion_Current;
+}
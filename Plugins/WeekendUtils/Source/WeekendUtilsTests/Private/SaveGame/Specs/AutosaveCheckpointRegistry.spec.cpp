@@ -0,0 +1,194 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#if WITH_AUTOMATION_WORKER
+
+#include "AutomationTest/AutomationSpecMacros.h"
+#include "AutomationTest/AutomationTestWorld.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "SaveGame/AutosaveCheckpoint.h"
+#include "SaveGame/AutosaveCheckpointRegistry.h"
+#include "SaveGame/Modules/SaveGameModule_PlayerStart.h"
+
+#define SPEC_TEST_CATEGORY "WeekendUtils.SaveGame"
+
+using namespace WeekendUtils;
+
+WE_BEGIN_DEFINE_SPEC(AutosaveCheckpointRegistry)
+	TSharedPtr<FScopedAutomationTestWorld> TestWorld;
+	TObjectPtr<UAutosaveCheckpointRegistry> Registry;
+
+	AAutosaveCheckpoint& SpawnCheckpointAt(const FVector& Location, FName PlayerStartTag) const
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AAutosaveCheckpoint* Checkpoint = TestWorld->World->SpawnActor<AAutosaveCheckpoint>(Location, FRotator::ZeroRotator, SpawnParameters);
+		Checkpoint->SetPlayerStartTag(PlayerStartTag);
+		return *Checkpoint;
+	}
+
+	USaveGameModule_PlayerStart& CreatePlayerStartModule(const FString& PlayerStartTag, const FVector& Location) const
+	{
+		USaveGameModule_PlayerStart* PlayerStartModule = NewObject<USaveGameModule_PlayerStart>(TestWorld->AsPtr());
+		PlayerStartModule->PlayerStartTag = PlayerStartTag;
+		PlayerStartModule->WorldCoordinates = FTransform(Location);
+		return *PlayerStartModule;
+	}
+WE_END_DEFINE_SPEC(AutosaveCheckpointRegistry)
+{
+	BeforeEach([this]
+	{
+		TestWorld = MakeShared<FScopedAutomationTestWorld>(SpecTestWorldName);
+		Registry = UAutosaveCheckpointRegistry::Get(TestWorld->AsPtr());
+	});
+
+	AfterEach([this]
+	{
+		Registry = nullptr;
+		TestWorld.Reset();
+	});
+
+	It("should exist in game worlds", [this]
+	{
+		TestNotNull("Registry", Registry.Get());
+	});
+
+	Describe("FindCheckpoint", [this]
+	{
+		It("should find spawned checkpoints by their PlayerStartTag", [this]
+		{
+			SpawnCheckpointAt(FVector::ZeroVector, "CheckpointA");
+			AAutosaveCheckpoint& CheckpointB = SpawnCheckpointAt(FVector::ZeroVector, "CheckpointB");
+
+			TestEqual("Found checkpoint", Registry->FindCheckpoint("CheckpointB"), &CheckpointB);
+			TestNull("Checkpoint with unknown tag", Registry->FindCheckpoint("UnknownCheckpoint"));
+		});
+
+		It("should find checkpoints by their new PlayerStartTag after it was changed", [this]
+		{
+			AAutosaveCheckpoint& Checkpoint = SpawnCheckpointAt(FVector::ZeroVector, "OldTag");
+			Checkpoint.SetPlayerStartTag("NewTag");
+
+			TestEqual("Checkpoint with new tag", Registry->FindCheckpoint("NewTag"), &Checkpoint);
+			TestNull("Checkpoint with old tag", Registry->FindCheckpoint("OldTag"));
+		});
+
+		It("should not find destroyed checkpoints", [this]
+		{
+			AAutosaveCheckpoint& Checkpoint = SpawnCheckpointAt(FVector::ZeroVector, "Checkpoint");
+			Checkpoint.Destroy();
+
+			TestNull("Destroyed checkpoint", Registry->FindCheckpoint("Checkpoint"));
+			TestEqual("Number of registered checkpoints", Registry->GetNumRegisteredCheckpoints(), 0);
+		});
+	});
+
+	Describe("FindNearestCheckpoint", [this]
+	{
+		It("should find the checkpoint nearest to the location", [this]
+		{
+			SpawnCheckpointAt(FVector(-500.0, 0.0, 0.0), "Left");
+			AAutosaveCheckpoint& Right = SpawnCheckpointAt(FVector(300.0, 0.0, 0.0), "Right");
+			AAutosaveCheckpoint& Far = SpawnCheckpointAt(FVector(50000.0, 0.0, 0.0), "Far");
+
+			TestEqual("Nearest checkpoint", Registry->FindNearestCheckpoint(FVector(100.0, 0.0, 0.0)), &Right);
+			TestEqual("Nearest checkpoint in another grid cell", Registry->FindNearestCheckpoint(FVector(45000.0, 0.0, 0.0)), &Far);
+		});
+
+		It("should not find checkpoints that are further away than the max distance", [this]
+		{
+			SpawnCheckpointAt(FVector(1000.0, 0.0, 0.0), "Checkpoint");
+
+			TestNull("Checkpoint beyond max distance", Registry->FindNearestCheckpoint(FVector::ZeroVector, 500.0));
+			TestNotNull("Checkpoint within max distance", Registry->FindNearestCheckpoint(FVector::ZeroVector, 1500.0));
+		});
+
+		It("should find checkpoints at their new location after they moved", [this]
+		{
+			AAutosaveCheckpoint& Moving = SpawnCheckpointAt(FVector::ZeroVector, "Moving");
+			AAutosaveCheckpoint& Static = SpawnCheckpointAt(FVector(0.0, 20000.0, 0.0), "Static");
+
+			// (i) Player starts are static by default, but checkpoints may be attached to moving actors.
+			Moving.GetRootComponent()->SetMobility(EComponentMobility::Movable);
+			Moving.SetActorLocation(FVector(0.0, 60000.0, 0.0));
+
+			TestEqual("Nearest checkpoint at old location", Registry->FindNearestCheckpoint(FVector::ZeroVector), &Static);
+			TestEqual("Nearest checkpoint at new location", Registry->FindNearestCheckpoint(FVector(0.0, 59000.0, 0.0)), &Moving);
+		});
+	});
+
+	Describe("FindCheckpointForPlayerStart", [this]
+	{
+		It("should find the checkpoint with the saved PlayerStartTag", [this]
+		{
+			AAutosaveCheckpoint& Tagged = SpawnCheckpointAt(FVector(5000.0, 0.0, 0.0), "Tagged");
+			SpawnCheckpointAt(FVector::ZeroVector, "Untagged");
+
+			const USaveGameModule_PlayerStart& PlayerStartModule = CreatePlayerStartModule("Tagged", FVector::ZeroVector);
+			TestEqual("Checkpoint for player start", Registry->FindCheckpointForPlayerStart(&PlayerStartModule), &Tagged);
+		});
+
+		It("should fall back to the checkpoint nearest to the saved location, if no checkpoint has the saved PlayerStartTag", [this]
+		{
+			SpawnCheckpointAt(FVector(5000.0, 0.0, 0.0), "Far");
+			AAutosaveCheckpoint& Near = SpawnCheckpointAt(FVector(100.0, 0.0, 0.0), "Near");
+
+			const USaveGameModule_PlayerStart& PlayerStartModule = CreatePlayerStartModule("RemovedCheckpoint", FVector::ZeroVector);
+			TestEqual("Checkpoint for player start", Registry->FindCheckpointForPlayerStart(&PlayerStartModule), &Near);
+		});
+
+		It("should find nothing without a saved PlayerStartTag", [this]
+		{
+			SpawnCheckpointAt(FVector::ZeroVector, "Checkpoint");
+
+			const USaveGameModule_PlayerStart& PlayerStartModule = CreatePlayerStartModule(FString(), FVector::ZeroVector);
+			TestNull("Checkpoint for player start", Registry->FindCheckpointForPlayerStart(&PlayerStartModule));
+			TestNull("Checkpoint for missing module", Registry->FindCheckpointForPlayerStart(nullptr));
+		});
+	});
+
+	Describe("RegisterCheckpoint", [this]
+	{
+		It("should not register the same checkpoint twice", [this]
+		{
+			AAutosaveCheckpoint& Checkpoint = SpawnCheckpointAt(FVector::ZeroVector, "Checkpoint");
+			Registry->RegisterCheckpoint(Checkpoint);
+
+			TestEqual("Number of registered checkpoints", Registry->GetNumRegisteredCheckpoints(), 1);
+		});
+
+		It("should find checkpoints again after they were unregistered and registered again", [this]
+		{
+			AAutosaveCheckpoint& Checkpoint = SpawnCheckpointAt(FVector(1000.0, 0.0, 0.0), "Checkpoint");
+			Registry->UnregisterCheckpoint(Checkpoint);
+
+			TestNull("Nearest unregistered checkpoint", Registry->FindNearestCheckpoint(FVector::ZeroVector));
+			TestEqual("Number of registered checkpoints after unregistering", Registry->GetNumRegisteredCheckpoints(), 0);
+
+			Registry->RegisterCheckpoint(Checkpoint);
+
+			TestEqual("Number of registered checkpoints after registering again", Registry->GetNumRegisteredCheckpoints(), 1);
+			TestEqual("Checkpoint with tag", Registry->FindCheckpoint("Checkpoint"), &Checkpoint);
+			TestEqual("Nearest checkpoint", Registry->FindNearestCheckpoint(FVector::ZeroVector), &Checkpoint);
+		});
+
+		It("should not scan game worlds for unregistered checkpoints on a miss", [this]
+		{
+			AAutosaveCheckpoint& Checkpoint = SpawnCheckpointAt(FVector::ZeroVector, "Checkpoint");
+			Registry->UnregisterCheckpoint(Checkpoint);
+
+			TestNull("Unregistered checkpoint with tag", Registry->FindCheckpoint("Checkpoint"));
+			TestEqual("Number of registered checkpoints", Registry->GetNumRegisteredCheckpoints(), 0);
+		});
+	});
+}
+
+#undef SPEC_TEST_CATEGORY
+#endif WITH_AUTOMATION_WORKER
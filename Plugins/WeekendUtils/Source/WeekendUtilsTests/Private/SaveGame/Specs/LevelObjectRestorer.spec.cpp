@@ -0,0 +1,493 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#if WITH_AUTOMATION_WORKER
+
+#include "AutomationTest/AutomationSpecMacros.h"
+#include "AutomationTest/AutomationTestWorld.h"
+#include "Containers/Ticker.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "SaveGame/Mocks/SaveGameMocks.h"
+#include "SaveGame/Modules/LevelObjectRestorer.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+#define SPEC_TEST_CATEGORY "WeekendUtils.SaveGame"
+
+using namespace WeekendUtils;
+
+WE_BEGIN_DEFINE_SPEC(LevelObjectRestorer)
+	TSharedPtr<FScopedAutomationTestWorld> TestWorld;
+	TObjectPtr<UMockLevelObjectRestorer> Module;
+	TArray<TObjectPtr<UMockLevelObject>> LevelObjects;
+	static inline int32 NumLevelObjects = 3;
+	TArray<TObjectPtr<AActor>> Actors;
+	TArray<FVector> SavedLocations;
+
+	UMockLevelObjectRestorer& CreateModule() const
+	{
+		return *NewObject<UMockLevelObjectRestorer>(TestWorld->AsPtr());
+	}
+
+	/** Writes the module the same way as it is written into SaveGames (= SaveGame properties and object states). */
+	static TArray<uint8> SaveModule(ULevelObjectRestorer& InModule)
+	{
+		TArray<uint8> SaveData;
+		FMemoryWriter MemoryWriter(SaveData, true);
+		FObjectAndNameAsStringProxyArchive Archive(MemoryWriter, false);
+		Archive.ArIsSaveGame = true;
+		InModule.Serialize(Archive);
+		return SaveData;
+	}
+
+	static void RestoreModule(ULevelObjectRestorer& InModule, const TArray<uint8>& SaveData)
+	{
+		FMemoryReader MemoryReader(SaveData, true);
+		FObjectAndNameAsStringProxyArchive Archive(MemoryReader, true);
+		Archive.ArIsSaveGame = true;
+		InModule.Serialize(Archive);
+	}
+
+	AActor& SpawnActorAt(const FVector& Location) const
+	{
+		AActor* Actor = TestWorld->World->SpawnActor<AActor>();
+		USceneComponent* RootComponent = NewObject<USceneComponent>(Actor, "Root");
+		Actor->SetRootComponent(RootComponent);
+		RootComponent->RegisterComponent();
+		Actor->SetActorLocation(Location);
+		return *Actor;
+	}
+
+	TArray<FLevelObjectRegistration> MakeRegistrations() const
+	{
+		TArray<FLevelObjectRegistration> Registrations;
+		for (UMockLevelObject* LevelObject : LevelObjects)
+		{
+			Registrations.Add({LevelObject, false});
+		}
+		return Registrations;
+	}
+
+	UMockLevelObjectRestorer& CreatePackingModule() const
+	{
+		UMockLevelObjectRestorer& PackingModule = CreateModule();
+		PackingModule.bPackStatesOfUnloadedLevels = true;
+		return PackingModule;
+	}
+
+	/** Simulates that the level of the test objects is streamed out, after all objects unregistered themselves. */
+	void RemoveLevelOfObjects(UMockLevelObjectRestorer& InModule) const
+	{
+		for (UMockLevelObject* LevelObject : LevelObjects)
+		{
+			InModule.UnregisterLevelObject(*LevelObject);
+		}
+		InModule.HandleLevelRemovedFromWorld(TestWorld->World->PersistentLevel, TestWorld->AsPtr());
+	}
+WE_END_DEFINE_SPEC(LevelObjectRestorer)
+{
+	BeforeEach([this]
+	{
+		TestWorld = MakeShared<FScopedAutomationTestWorld>(SpecTestWorldName);
+		Module = &CreateModule();
+		for (int32 i = 0; i < NumLevelObjects; ++i)
+		{
+			// (i) Level objects need a level as outer, which is also the level partition of their states.
+			UMockLevelObject* LevelObject = NewObject<UMockLevelObject>(TestWorld->World->PersistentLevel, FName("MockLevelObject", i + 1));
+			LevelObject->FillWithSyntheticData(16, i);
+			LevelObjects.Add(LevelObject);
+		}
+	});
+
+	AfterEach([this]
+	{
+		LevelObjects.Reset();
+		Module = nullptr;
+		TestWorld.Reset();
+	});
+
+	Describe("Serialize", [this]
+	{
+		It("should restore the registered objects from the saved module.", [this]
+		{
+			for (UMockLevelObject* LevelObject : LevelObjects)
+			{
+				Module->RegisterLevelObject(*LevelObject);
+			}
+			const int32 SavedHealth = LevelObjects[0]->Health;
+			const TArray<uint8> SaveData = SaveModule(*Module);
+
+			LevelObjects[0]->Health = SavedHealth + 1;
+			RestoreModule(*Module, SaveData);
+			TestEqual("Health of registered object", LevelObjects[0]->Health, SavedHealth);
+		});
+
+		It("should restore objects that register at another module after it was restored.", [this]
+		{
+			for (UMockLevelObject* LevelObject : LevelObjects)
+			{
+				Module->RegisterLevelObject(*LevelObject);
+			}
+			const TArray<uint8> SaveData = SaveModule(*Module);
+			const int32 SavedHealth = LevelObjects[1]->Health;
+			LevelObjects[1]->Health = SavedHealth + 1;
+
+			UMockLevelObjectRestorer& RestoredModule = CreateModule();
+			RestoreModule(RestoredModule, SaveData);
+			TestEqual("ModuleVersion", RestoredModule.ModuleVersion, static_cast<int32>(ULevelObjectRestorer::ModuleVersion_Current));
+			TestEqual("Num object states", RestoredModule.GetNumActiveObjectStates(), NumLevelObjects);
+
+			RestoredModule.RegisterLevelObject(*LevelObjects[1]);
+			TestEqual("Health of registered object", LevelObjects[1]->Health, SavedHealth);
+		});
+
+		It("should upgrade the object states of ModuleVersion_WithSafeUniqueObjectId_Hotfix to keyed object states.", [this]
+		{
+			TMap<FString, UObject*> LegacyObjectsById;
+			for (UMockLevelObject* LevelObject : LevelObjects)
+			{
+				LegacyObjectsById.Add(ULevelObjectRestorer::MakeSafeUniqueObjectId(*LevelObject), LevelObject);
+			}
+			LegacyObjectsById.Add("CustomUniqueObjectId", LevelObjects[0]);
+
+			TArray<uint8> LegacySaveData;
+			FMemoryWriter MemoryWriter(LegacySaveData, true);
+			FObjectAndNameAsStringProxyArchive Archive(MemoryWriter, false);
+			Archive.ArIsSaveGame = true;
+			Module->SerializeAsLegacyModuleVersion(Archive, ULevelObjectRestorer::ModuleVersion_WithSafeUniqueObjectId_Hotfix, LegacyObjectsById);
+
+			const int32 SavedHealth = LevelObjects[2]->Health;
+			LevelObjects[2]->Health = SavedHealth + 1;
+			LevelObjects[0]->Health = -1;
+
+			UMockLevelObjectRestorer& RestoredModule = CreateModule();
+			RestoreModule(RestoredModule, LegacySaveData);
+			TestEqual("ModuleVersion", RestoredModule.ModuleVersion, static_cast<int32>(ULevelObjectRestorer::ModuleVersion_Current));
+			TestEqual("Num object states", RestoredModule.GetNumActiveObjectStates(), NumLevelObjects + 1);
+
+			RestoredModule.RegisterLevelObject(*LevelObjects[2]);
+			TestEqual("Health of object registered by its safe ObjectId", LevelObjects[2]->Health, SavedHealth);
+			RestoredModule.RegisterLevelObject(*LevelObjects[0], FString("CustomUniqueObjectId"));
+			TestNotEqual("Health of object registered by its custom ObjectId", LevelObjects[0]->Health, -1);
+
+			// The upgraded states are written in the keyed format and can be restored again:
+			const TArray<uint8> UpgradedSaveData = SaveModule(RestoredModule);
+			LevelObjects[2]->Health = SavedHealth + 1;
+			RestoreModule(RestoredModule, UpgradedSaveData);
+			TestEqual("Health of object restored from upgraded data", LevelObjects[2]->Health, SavedHealth);
+		});
+	});
+
+	Describe("RegisterLevelObjects", [this]
+	{
+		BeforeEach([this]
+		{
+			for (int32 i = 0; i < NumLevelObjects; ++i)
+			{
+				LevelObjects[i]->Health = (i + 1) * 10;
+				Module->RegisterLevelObject(*LevelObjects[i]);
+			}
+			const TArray<uint8> SaveData = SaveModule(*Module);
+			Module = &CreateModule();
+			RestoreModule(*Module, SaveData);
+			for (UMockLevelObject* LevelObject : LevelObjects)
+			{
+				LevelObject->Health = 0;
+			}
+		});
+
+		It("should register and restore all objects immediately without budget.", [this]
+		{
+			Module->RegistrationBudgetMs = 0.0f;
+			Module->RegisterLevelObjects(MakeRegistrations());
+			TestEqual("Num pending registrations", Module->GetNumPendingRegistrations(), 0);
+			for (int32 i = 0; i < NumLevelObjects; ++i)
+			{
+				TestEqual(FString::Printf(TEXT("Health of object %d"), i), LevelObjects[i]->Health, (i + 1) * 10);
+			}
+		});
+
+		It("should register and restore the objects in order over the following frames with a budget.", [this]
+		{
+			Module->RegistrationBudgetMs = UE_KINDA_SMALL_NUMBER;
+			Module->RegisterLevelObjects(MakeRegistrations());
+			TestEqual("Num pending registrations", Module->GetNumPendingRegistrations(), NumLevelObjects);
+			TestTrue("Is registration of last object pending", Module->IsRegistrationPending(*LevelObjects.Last()));
+			TestEqual("Health of first object before tick", LevelObjects[0]->Health, 0);
+
+			// (i) At least one registration is processed per frame, regardless of the budget.
+			FTSTicker::GetCoreTicker().Tick(0.0f);
+			TestFalse("Is registration of first object pending", Module->IsRegistrationPending(*LevelObjects[0]));
+			TestEqual("Health of first object after tick", LevelObjects[0]->Health, 10);
+
+			Module->FlushPendingRegistrations();
+			TestEqual("Num pending registrations after flush", Module->GetNumPendingRegistrations(), 0);
+			TestEqual("Health of last object after flush", LevelObjects.Last()->Health, NumLevelObjects * 10);
+		});
+
+		It("should only cancel pending registrations of objects that unregister, and keep their states.", [this]
+		{
+			Module->RegistrationBudgetMs = UE_KINDA_SMALL_NUMBER;
+			Module->RegisterLevelObjects(MakeRegistrations());
+			Module->UnregisterLevelObject(*LevelObjects[1]);
+			TestEqual("Num pending registrations", Module->GetNumPendingRegistrations(), NumLevelObjects - 1);
+
+			Module->FlushPendingRegistrations();
+			TestEqual("Health of unregistered object", LevelObjects[1]->Health, 0);
+			TestEqual("Health of registered object", LevelObjects[2]->Health, 30);
+
+			const TArray<uint8> SaveData = SaveModule(*Module);
+			UMockLevelObjectRestorer& RestoredModule = CreateModule();
+			RestoreModule(RestoredModule, SaveData);
+			RestoredModule.RegisterLevelObject(*LevelObjects[1]);
+			TestEqual("Health of unregistered object restored from kept state", LevelObjects[1]->Health, 20);
+		});
+	});
+
+	Describe("Restore", [this]
+	{
+		BeforeEach([this]
+		{
+			TestWorld->InitializeGame();
+			FVector PlayerLocation = FVector::ZeroVector;
+			FRotator PlayerRotation = FRotator::ZeroRotator;
+			TestWorld->World->GetFirstPlayerController()->GetPlayerViewPoint(OUT PlayerLocation, OUT PlayerRotation);
+
+			// Registered from far to near, so the restore order differs from the registration order:
+			SavedLocations = {PlayerLocation + FVector(5000, 0, 0), PlayerLocation + FVector(0, 1000, 0), PlayerLocation + FVector(0, 0, 100)};
+			for (const FVector& SavedLocation : SavedLocations)
+			{
+				AActor& Actor = SpawnActorAt(SavedLocation);
+				Module->RegisterLevelObjectWithTransform(Actor);
+				Actors.Add(&Actor);
+			}
+		});
+
+		AfterEach([this]
+		{
+			Actors.Reset();
+			SavedLocations.Reset();
+		});
+
+		It("should restore all registered objects before the module is reported as restored without budget.", [this]
+		{
+			const TArray<uint8> SaveData = SaveModule(*Module);
+			for (AActor* Actor : Actors)
+			{
+				Actor->SetActorLocation(FVector::ZeroVector);
+			}
+
+			TSharedRef<TArray<FString>> Events = MakeShared<TArray<FString>>();
+			Module->OnAfterModuleRestored.AddLambda([this, Events]
+			{
+				Events->Add("ModuleRestored");
+				TestEqual("Location of farthest object when module is restored", Actors[0]->GetActorLocation(), SavedLocations[0]);
+			});
+			Module->OnObjectRestoreCompleted.AddLambda([Events] { Events->Add("ObjectsRestored"); });
+			RestoreModule(*Module, SaveData);
+			TestEqual("Events", FString::Join(*Events, TEXT(", ")), FString("ModuleRestored, ObjectsRestored"));
+			TestFalse("Is restoring objects", Module->IsRestoringObjects());
+		});
+
+		It("should report the module as restored first, then restore the nearest objects first over the following frames with a budget.", [this]
+		{
+			Module->RestoreBudgetMs = UE_KINDA_SMALL_NUMBER;
+			const TArray<uint8> SaveData = SaveModule(*Module);
+			for (AActor* Actor : Actors)
+			{
+				Actor->SetActorLocation(FVector::ZeroVector);
+			}
+
+			TSharedRef<TArray<FString>> Events = MakeShared<TArray<FString>>();
+			Module->OnAfterModuleRestored.AddLambda([Events] { Events->Add("ModuleRestored"); });
+			Module->OnObjectRestoreCompleted.AddLambda([Events] { Events->Add("ObjectsRestored"); });
+			RestoreModule(*Module, SaveData);
+			TestEqual("Events after restore", FString::Join(*Events, TEXT(", ")), FString("ModuleRestored"));
+			TestTrue("Is restoring objects", Module->IsRestoringObjects());
+			TestEqual("Location of nearest object before tick", Actors[2]->GetActorLocation(), FVector::ZeroVector);
+
+			// (i) At least one object is restored per frame, regardless of the budget.
+			FTSTicker::GetCoreTicker().Tick(0.0f);
+			TestEqual("Location of nearest object after tick", Actors[2]->GetActorLocation(), SavedLocations[2]);
+			TestEqual("Location of farthest object after tick", Actors[0]->GetActorLocation(), FVector::ZeroVector);
+
+			Module->FlushPendingRestores();
+			TestEqual("Location of farthest object after flush", Actors[0]->GetActorLocation(), SavedLocations[0]);
+			TestEqual("Events after flush", FString::Join(*Events, TEXT(", ")), FString("ModuleRestored, ObjectsRestored"));
+			TestFalse("Is restoring objects after flush", Module->IsRestoringObjects());
+		});
+
+		It("should keep the restored state of objects that unregister before they were restored.", [this]
+		{
+			Module->RestoreBudgetMs = UE_KINDA_SMALL_NUMBER;
+			const TArray<uint8> SaveData = SaveModule(*Module);
+			RestoreModule(*Module, SaveData);
+			Actors[0]->SetActorLocation(FVector::ZeroVector);
+			Module->UnregisterLevelObjectWithTransform(*Actors[0]);
+			Module->FlushPendingRestores();
+
+			Module->RestoreBudgetMs = 0.0f;
+			Module->RegisterLevelObjectWithTransform(*Actors[0]);
+			TestEqual("Location of re-registered object", Actors[0]->GetActorLocation(), SavedLocations[0]);
+		});
+	});
+
+	Describe("Dirty Tracking", [this]
+	{
+		BeforeEach([this]
+		{
+			for (UMockLevelObject* LevelObject : LevelObjects)
+			{
+				Module->RegisterLevelObject(*LevelObject);
+			}
+		});
+
+		It("should serialize all registered objects with every save when disabled.", [this]
+		{
+			Module->DirtyTrackingMode = ELevelObjectRestorerDirtyTrackingMode::Disabled;
+			SaveModule(*Module);
+			SaveModule(*Module);
+			TestEqual("Num serialized object states", Module->GetNumSerializedObjectStatesOfLastSave(), NumLevelObjects);
+			TestEqual("Num reused object states", Module->GetNumReusedObjectStatesOfLastSave(), 0);
+		});
+
+		It("should only serialize objects that were marked dirty.", [this]
+		{
+			Module->DirtyTrackingMode = ELevelObjectRestorerDirtyTrackingMode::ExplicitOnly;
+			SaveModule(*Module);
+			LevelObjects[0]->Health = 11;
+			LevelObjects[1]->Health = 21;
+			Module->MarkLevelObjectDirty(*LevelObjects[0]);
+			const TArray<uint8> SaveData = SaveModule(*Module);
+			TestEqual("Num serialized object states", Module->GetNumSerializedObjectStatesOfLastSave(), 1);
+			TestEqual("Num reused object states", Module->GetNumReusedObjectStatesOfLastSave(), NumLevelObjects - 1);
+
+			RestoreModule(*Module, SaveData);
+			TestEqual("Health of object marked dirty", LevelObjects[0]->Health, 11);
+			TestNotEqual("Health of unmarked object", LevelObjects[1]->Health, 21);
+		});
+
+		It("should additionally serialize objects whose SaveGame properties changed.", [this]
+		{
+			Module->DirtyTrackingMode = ELevelObjectRestorerDirtyTrackingMode::ExplicitAndPropertyHash;
+			for (UMockLevelObject* LevelObject : LevelObjects)
+			{
+				// (i) The payload of the mock level objects may not be hashable, which would make them always dirty.
+				Module->UnregisterLevelObject(*LevelObject);
+			}
+			UMockHashableLevelObject* HashableObject = NewObject<UMockHashableLevelObject>(TestWorld->World->PersistentLevel);
+			UMockHashableLevelObject* OtherHashableObject = NewObject<UMockHashableLevelObject>(TestWorld->World->PersistentLevel);
+			Module->RegisterLevelObject(*HashableObject);
+			Module->RegisterLevelObject(*OtherHashableObject);
+			SaveModule(*Module);
+
+			HashableObject->Health = 21;
+			const TArray<uint8> SaveData = SaveModule(*Module);
+			TestEqual("Num serialized object states", Module->GetNumSerializedObjectStatesOfLastSave(), 1);
+			TestEqual("Num reused object states", Module->GetNumReusedObjectStatesOfLastSave(), 1);
+
+			HashableObject->Health = 0;
+			RestoreModule(*Module, SaveData);
+			TestEqual("Health of changed object", HashableObject->Health, 21);
+		});
+	});
+
+	Describe("Level Partitions", [this]
+	{
+		BeforeEach([this]
+		{
+			for (int32 i = 0; i < NumLevelObjects; ++i)
+			{
+				LevelObjects[i]->Health = (i + 1) * 10;
+			}
+		});
+
+		It("should pack the states of a removed level and unpack them when the level is added again.", [this]
+		{
+			Module = &CreatePackingModule();
+			for (UMockLevelObject* LevelObject : LevelObjects)
+			{
+				Module->RegisterLevelObject(*LevelObject);
+			}
+			LevelObjects[0]->Health = 11;
+			RemoveLevelOfObjects(*Module);
+			TestEqual("Num active object states after packing", Module->GetNumActiveObjectStates(), 0);
+			TestEqual("Num packed object states", Module->GetNumPackedObjectStates(), NumLevelObjects);
+
+			Module->HandleLevelAddedToWorld(TestWorld->World->PersistentLevel, TestWorld->AsPtr());
+			TestEqual("Num active object states after unpacking", Module->GetNumActiveObjectStates(), NumLevelObjects);
+			TestEqual("Num packed object states after unpacking", Module->GetNumPackedObjectStates(), 0);
+
+			LevelObjects[0]->Health = 0;
+			Module->RegisterLevelObject(*LevelObjects[0]);
+			TestEqual("Health of unpacked object", LevelObjects[0]->Health, 11);
+		});
+
+		It("should pack restored states of levels without registered objects, and unpack them when an object registers.", [this]
+		{
+			Module = &CreatePackingModule();
+			for (UMockLevelObject* LevelObject : LevelObjects)
+			{
+				Module->RegisterLevelObject(*LevelObject);
+			}
+			const TArray<uint8> SaveData = SaveModule(*Module);
+
+			UMockLevelObjectRestorer& RestoredModule = CreatePackingModule();
+			RestoreModule(RestoredModule, SaveData);
+			TestEqual("Num active object states after restore", RestoredModule.GetNumActiveObjectStates(), 0);
+			TestEqual("Num packed object states after restore", RestoredModule.GetNumPackedObjectStates(), NumLevelObjects);
+
+			LevelObjects[1]->Health = 0;
+			RestoredModule.RegisterLevelObject(*LevelObjects[1]);
+			TestEqual("Num active object states after registration", RestoredModule.GetNumActiveObjectStates(), NumLevelObjects);
+			TestEqual("Health of registered object", LevelObjects[1]->Health, 20);
+		});
+
+		It("should reject packed partitions with an implausible uncompressed size, but keep them packed.", [this]
+		{
+			Module = &CreatePackingModule();
+			for (UMockLevelObject* LevelObject : LevelObjects)
+			{
+				Module->RegisterLevelObject(*LevelObject);
+			}
+			RemoveLevelOfObjects(*Module);
+			if (!TestEqual("Num packed partitions", Module->PackedLevelPartitions.Num(), 1))
+				return;
+
+			FLevelObjectStatePartition& Partition = Module->PackedLevelPartitions.CreateIterator()->Value;
+			if (Partition.CompressionFormat == ESaveGameCompressionFormat::None)
+			{
+				AddInfo("Skipped: The packed states were not compressed.");
+				return;
+			}
+
+			AddExpectedError("implausible size", EAutomationExpectedErrorFlags::Contains, 1);
+			const int32 UncompressedSize = Partition.UncompressedSize;
+			Partition.UncompressedSize = MAX_int32;
+			LevelObjects[0]->Health = 0;
+			Module->RegisterLevelObject(*LevelObjects[0]);
+			TestEqual("Num packed object states", Module->GetNumPackedObjectStates(), NumLevelObjects);
+			TestEqual("Health of object without state", LevelObjects[0]->Health, 0);
+
+			// (i) The rejected partition must still be intact, so it isn't lost with the next save:
+			Partition.UncompressedSize = UncompressedSize;
+			LevelObjects[1]->Health = 0;
+			Module->RegisterLevelObject(*LevelObjects[1]);
+			TestEqual("Num packed object states after unpacking", Module->GetNumPackedObjectStates(), 0);
+			TestEqual("Health of object from unpacked partition", LevelObjects[1]->Health, 20);
+		});
+	});
+}
+
+#undef SPEC_TEST_CATEGORY
+#endif WITH_AUTOMATION_WORKER
@@ -0,0 +1,203 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#if WITH_AUTOMATION_WORKER
+
+#include "AutomationTest/AutomationSpecMacros.h"
+#include "AutomationTest/AutomationTestWorld.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "SaveGame/ModularSaveGame.h"
+#include "SaveGame/Mocks/SaveGameMocks.h"
+#include "SaveGame/Modules/LevelObjectRestorer.h"
+#include "UObject/StrongObjectPtr.h"
+
+#define SPEC_TEST_CATEGORY "WeekendUtils.SaveGame"
+
+using namespace WeekendUtils;
+
+namespace
+{
+	/** Composition of a synthetic SaveGame. Can be overridden via command line: -SaveGameBenchmarkScenarios=1:1000:100:64+4:1000:0:0 */
+	struct FSaveGameBenchmarkScenario
+	{
+		int32 NumModules = 1;
+		int32 NumEntriesPerModule = 0;
+		int32 NumLevelObjects = 0;
+		int32 LevelObjectPayloadSize = 0;
+
+		FString ToString() const
+		{
+			return FString::Printf(TEXT("%d modules x %d entries, %d level objects x %d bytes"), NumModules, NumEntriesPerModule, NumLevelObjects, LevelObjectPayloadSize);
+		}
+	};
+
+	struct FSaveGameBenchmarkResult
+	{
+		FSaveGameBenchmarkScenario Scenario;
+		int64 NumBytes = 0;
+		double GameThreadSeconds = 0.0; // Capturing the snapshot, which blocks the game thread during async saves.
+		double WorkerSeconds = 0.0; // Encoding the snapshot, which is done on a worker thread during async saves.
+		double DeserializeSeconds = 0.0;
+
+		static FString GetCsvHeader()
+		{
+			return "NumModules,NumEntriesPerModule,NumLevelObjects,LevelObjectPayloadSize,NumBytes,GameThreadMs,WorkerMs,DeserializeMs";
+		}
+
+		FString ToCsvRow() const
+		{
+			return FString::Printf(TEXT("%d,%d,%d,%d,%lld,%.3f,%.3f,%.3f"),
+				Scenario.NumModules, Scenario.NumEntriesPerModule, Scenario.NumLevelObjects, Scenario.LevelObjectPayloadSize, NumBytes,
+				GameThreadSeconds * 1000.0, WorkerSeconds * 1000.0, DeserializeSeconds * 1000.0);
+		}
+	};
+
+	TArray<FSaveGameBenchmarkScenario> GetBenchmarkScenarios()
+	{
+		FString ScenariosString;
+		if (!FParse::Value(FCommandLine::Get(), TEXT("SaveGameBenchmarkScenarios="), OUT ScenariosString))
+		{
+			return {
+				{1, 1000, 0, 0},
+				{1, 20000, 0, 0},
+				{8, 2500, 0, 0},
+				{1, 0, 1000, 64},
+				{1, 0, 10000, 64},
+				{4, 2500, 5000, 256},
+			};
+		}
+
+		TArray<FSaveGameBenchmarkScenario> Result;
+		TArray<FString> ScenarioStrings;
+		ScenariosString.ParseIntoArray(OUT ScenarioStrings, TEXT("+"));
+		for (const FString& ScenarioString : ScenarioStrings)
+		{
+			TArray<FString> Values;
+			if (ScenarioString.ParseIntoArray(OUT Values, TEXT(":")) == 4)
+			{
+				Result.Add({FCString::Atoi(*Values[0]), FCString::Atoi(*Values[1]), FCString::Atoi(*Values[2]), FCString::Atoi(*Values[3])});
+			}
+		}
+		return Result;
+	}
+
+	double GetMedian(TArray<double> Values)
+	{
+		Values.Sort();
+		return (Values.Num() > 0 ? Values[Values.Num() / 2] : 0.0);
+	}
+}
+
+WE_BEGIN_DEFINE_BENCHMARK_SPEC(SaveGameBenchmark)
+	TSharedPtr<FScopedAutomationTestWorld> TestWorld;
+	TObjectPtr<UMockPipelineSaveGameSerializer> Serializer;
+	TArray<TStrongObjectPtr<UObject>> ObjectsToKeepAlive;
+	static inline int32 NumIterations = 5;
+
+	UModularSaveGame& CreateSyntheticSaveGame(const FSaveGameBenchmarkScenario& Scenario)
+	{
+		UModularSaveGame* SaveGame = NewObject<UModularSaveGame>(TestWorld->AsPtr());
+		ObjectsToKeepAlive.Emplace(SaveGame);
+		for (int32 i = 0; i < Scenario.NumModules; ++i)
+		{
+			SaveGame->FindOrAddModule<UMockSaveGameModule>(FName("MockModule", i)).FillWithSyntheticData(Scenario.NumEntriesPerModule, i);
+		}
+
+		if (Scenario.NumLevelObjects > 0)
+		{
+			ULevelObjectRestorer& LevelObjectRestorer = SaveGame->FindOrAddModule<ULevelObjectRestorer>();
+			for (int32 i = 0; i < Scenario.NumLevelObjects; ++i)
+			{
+				// (i) Level objects need a level as outer, even if they are registered with a custom ObjectId.
+				UMockLevelObject* LevelObject = NewObject<UMockLevelObject>(TestWorld->World->PersistentLevel);
+				LevelObject->FillWithSyntheticData(Scenario.LevelObjectPayloadSize, i);
+				ObjectsToKeepAlive.Emplace(LevelObject);
+				LevelObjectRestorer.RegisterLevelObject(*LevelObject, FString::Printf(TEXT("MockLevelObject_%d"), i), false);
+			}
+		}
+		return *SaveGame;
+	}
+
+	FSaveGameBenchmarkResult RunBenchmark(const FSaveGameBenchmarkScenario& Scenario)
+	{
+		FSaveGameBenchmarkResult Result;
+		Result.Scenario = Scenario;
+
+		UModularSaveGame& SaveGame = CreateSyntheticSaveGame(Scenario);
+		TArray<double> GameThreadSeconds, WorkerSeconds, DeserializeSeconds;
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			TArray<uint8> SaveData;
+			double StartTime = FPlatformTime::Seconds();
+			Serializer->TryCaptureSaveGameSnapshot(SaveGame, OUT SaveData);
+			GameThreadSeconds.Add(FPlatformTime::Seconds() - StartTime);
+
+			StartTime = FPlatformTime::Seconds();
+			if (const USaveGameSerializer::FSaveDataEncoder Encoder = Serializer->MakeSaveDataEncoder())
+			{
+				Encoder(IN OUT SaveData);
+			}
+			WorkerSeconds.Add(FPlatformTime::Seconds() - StartTime);
+			Result.NumBytes = SaveData.Num();
+
+			StartTime = FPlatformTime::Seconds();
+			USaveGame* LoadedSaveGame = nullptr;
+			Serializer->TryDeserializeSaveGame(SaveData, OUT LoadedSaveGame);
+			DeserializeSeconds.Add(FPlatformTime::Seconds() - StartTime);
+		}
+
+		Result.GameThreadSeconds = GetMedian(GameThreadSeconds);
+		Result.WorkerSeconds = GetMedian(WorkerSeconds);
+		Result.DeserializeSeconds = GetMedian(DeserializeSeconds);
+		return Result;
+	}
+WE_END_DEFINE_SPEC(SaveGameBenchmark)
+{
+	BeforeEach([this]
+	{
+		TestWorld = MakeShared<FScopedAutomationTestWorld>(SpecTestWorldName);
+		Serializer = NewObject<UMockPipelineSaveGameSerializer>(TestWorld->AsPtr());
+	});
+
+	AfterEach([this]
+	{
+		Serializer = nullptr;
+		ObjectsToKeepAlive.Empty();
+		TestWorld.Reset();
+	});
+
+	Describe("SaveAndLoad", [this]
+	{
+		It("should report save and load performance of synthetic SaveGames to a CSV file.", [this]
+		{
+			TArray<FString> CsvLines = {FSaveGameBenchmarkResult::GetCsvHeader()};
+			for (const FSaveGameBenchmarkScenario& Scenario : GetBenchmarkScenarios())
+			{
+				const FSaveGameBenchmarkResult Result = RunBenchmark(Scenario);
+				AddInfo(FString::Printf(TEXT("%s: %lld bytes, %.3f ms game thread + %.3f ms worker to save, %.3f ms to load."),
+					*Scenario.ToString(), Result.NumBytes, Result.GameThreadSeconds * 1000.0, Result.WorkerSeconds * 1000.0,
+					Result.DeserializeSeconds * 1000.0));
+				TestTrue("NumBytes > 0", Result.NumBytes > 0);
+				CsvLines.Add(Result.ToCsvRow());
+			}
+
+			const FString CsvFilePath = FPaths::AutomationDir() / "SaveGameBenchmark" / FString::Printf(TEXT("SaveGameBenchmark_%s.csv"), *FDateTime::Now().ToString());
+			TestTrue("CSV file written", FFileHelper::SaveStringArrayToFile(CsvLines, *CsvFilePath));
+			AddInfo("Benchmark results written to: " + CsvFilePath);
+		});
+	});
+}
+
+#undef SPEC_TEST_CATEGORY
+#endif WITH_AUTOMATION_WORKER
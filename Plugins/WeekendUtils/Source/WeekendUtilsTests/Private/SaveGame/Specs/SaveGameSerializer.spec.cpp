@@ -0,0 +1,550 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#if WITH_AUTOMATION_WORKER
+
+#include "AutomationTest/AutomationSpecMacros.h"
+#include "AutomationTest/AutomationTestWorld.h"
+#include "Containers/Ticker.h"
+#include "HAL/FileManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "SaveGame/ModularSaveGame.h"
+#include "SaveGame/SaveGameUtils.h"
+#include "SaveGame/Mocks/SaveGameMocks.h"
+#include "SaveGame/Settings/SaveGameServiceSettings.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#define SPEC_TEST_CATEGORY "WeekendUtils.SaveGame"
+
+using namespace WeekendUtils;
+
+WE_BEGIN_DEFINE_SPEC(SaveGameSerializer)
+	TSharedPtr<FScopedAutomationTestWorld> TestWorld;
+	TObjectPtr<UModularSaveGameSerializer> Serializer;
+	TObjectPtr<UModularSaveGame> SaveGame;
+	static inline FString TestSlotName = "WeekendUtilsTests_SaveGameSerializer";
+	static inline int32 UserIndex = 0;
+	static inline int32 NumSyntheticEntries = 20000;
+	bool bPreviousUseSlotIndexFile = false;
+
+	/** Describes the test slot file as it is stored, but with a SaveCounter in its header data that differs from the slot's own. */
+	static FSaveGameSlotIndexEntry MakeSlotIndexEntryOfTestSlot(int32 EntryUserIndex, int32 SaveCounter)
+	{
+		const FString SlotFilePath = USaveGameSerializer::GetLocalSaveGamesDir() / TestSlotName + ".sav";
+		TArray<uint8> SlotData;
+		FFileHelper::LoadFileToArray(OUT SlotData, *SlotFilePath);
+
+		FSimpleSaveGameHeaderData HeaderData;
+		HeaderData.SaveCounter = SaveCounter;
+		FSaveGameSlotIndexEntry Entry;
+		Entry.SlotName = TestSlotName;
+		Entry.UserIndex = EntryUserIndex;
+		Entry.NumBytes = SlotData.Num();
+		Entry.Timestamp = IFileManager::Get().GetTimeStamp(*SlotFilePath);
+		Entry.Checksum = FCrc::MemCrc32(SlotData.GetData(), SlotData.Num());
+		Entry.EncodedHeaderData = FSaveGameSlotIndex::EncodeHeaderData(FInstancedStruct::Make(HeaderData));
+		return Entry;
+	}
+
+	/** Scans the header data of the test slot, then waits until the entry of the test slot in the slot index matches its file. */
+	void ScanTestSlotAndWaitForSlotIndex(TFunction<void(int32 /*SaveCounter*/, const FSaveGameSlotIndexEntry&)> OnCompleted)
+	{
+		Serializer->AsyncLoadHeaderDataFromSlots({ TestSlotName }, UserIndex, USaveGameSerializer::FOnAsyncHeaderScanCompleted::CreateLambda(
+			[OnCompleted](const int32, const TMap<FString, FInstancedStruct>& HeaderDataBySlot)
+			{
+				const FInstancedStruct* HeaderData = HeaderDataBySlot.Find(TestSlotName);
+				const FSimpleSaveGameHeaderData* SimpleHeaderData = (HeaderData ? HeaderData->GetPtr<FSimpleSaveGameHeaderData>() : nullptr);
+				const int32 SaveCounter = (SimpleHeaderData ? SimpleHeaderData->SaveCounter : INDEX_NONE);
+				const FDateTime FileTimestamp = IFileManager::Get().GetTimeStamp(*(USaveGameSerializer::GetLocalSaveGamesDir() / TestSlotName + ".sav"));
+
+				// (i) Rebuilt entries are written back on a worker thread after the scan.
+				FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([OnCompleted, SaveCounter, FileTimestamp](float)
+				{
+					TMap<FSaveGameSlotIndex::FEntryKey, FSaveGameSlotIndexEntry> EntriesByKey;
+					FSaveGameSlotIndex::TryReadEntries(OUT EntriesByKey);
+					const FSaveGameSlotIndexEntry* Entry = EntriesByKey.Find(FSaveGameSlotIndex::MakeEntryKey(TestSlotName, UserIndex));
+					if (!Entry || Entry->Timestamp != FileTimestamp)
+						return true;
+
+					OnCompleted(SaveCounter, *Entry);
+					return false;
+				}));
+			}));
+	}
+WE_END_DEFINE_SPEC(SaveGameSerializer)
+{
+	BeforeEach([this]
+	{
+		TestWorld = MakeShared<FScopedAutomationTestWorld>(SpecTestWorldName);
+		Serializer = NewObject<UModularSaveGameSerializer>(TestWorld->AsPtr());
+		SaveGame = NewObject<UModularSaveGame>(Serializer);
+		SaveGame->FindOrAddModule<UMockSaveGameModule>().FillWithSyntheticData(NumSyntheticEntries);
+	});
+
+	AfterEach([this]
+	{
+		Serializer->TryDeleteGameInSlot(TestSlotName, UserIndex);
+		SaveGame = nullptr;
+		Serializer = nullptr;
+		TestWorld.Reset();
+	});
+
+	Describe("TryDeserializeSaveGame", [this]
+	{
+		It("should restore all modules of the serialized SaveGame.", [this]
+		{
+			TArray<uint8> SaveData;
+			TestTrue("TrySerializeSaveGame", Serializer->TrySerializeSaveGame(*SaveGame, OUT SaveData));
+
+			USaveGame* LoadedSaveGame = nullptr;
+			TestTrue("TryDeserializeSaveGame", Serializer->TryDeserializeSaveGame(SaveData, OUT LoadedSaveGame));
+			const UModularSaveGame* LoadedModularSaveGame = Cast<UModularSaveGame>(LoadedSaveGame);
+			const UMockSaveGameModule* LoadedModule = (LoadedModularSaveGame ? LoadedModularSaveGame->FindModule<UMockSaveGameModule>() : nullptr);
+			if (TestNotNull("LoadedModule", LoadedModule))
+			{
+				const UMockSaveGameModule* OriginalModule = SaveGame->FindModule<UMockSaveGameModule>();
+				TestEqual("Strings", LoadedModule->Strings, OriginalModule->Strings);
+				TestEqual("Integers", LoadedModule->Integers, OriginalModule->Integers);
+				TestEqual("Num Transforms", LoadedModule->Transforms.Num(), OriginalModule->Transforms.Num());
+			}
+		});
+	});
+
+	Describe("TryDeserializeHeaderData", [this]
+	{
+		It("should restore the header data without deserializing the SaveGame.", [this]
+		{
+			SaveGame->GetMutableHeaderData<FSimpleSaveGameHeaderData>().SaveCounter = 42;
+			TArray<uint8> SaveData;
+			Serializer->TrySerializeSaveGame(*SaveGame, OUT SaveData);
+
+			FInstancedStruct HeaderData;
+			TestTrue("TryDeserializeHeaderData", Serializer->TryDeserializeHeaderData(SaveData, OUT HeaderData));
+			const FSimpleSaveGameHeaderData* SimpleHeaderData = HeaderData.GetPtr<FSimpleSaveGameHeaderData>();
+			if (TestNotNull("SimpleHeaderData", SimpleHeaderData))
+			{
+				TestEqual("SaveCounter", SimpleHeaderData->SaveCounter, 42);
+			}
+		});
+
+		It("should fail for data that does not start with a header.", [this]
+		{
+			const TArray<uint8> InvalidData = {0, 1, 2, 3, 4, 5, 6, 7};
+			FInstancedStruct HeaderData;
+			TestFalse("TryDeserializeHeaderData", Serializer->TryDeserializeHeaderData(InvalidData, OUT HeaderData));
+		});
+	});
+
+	Describe("FWeekendUtilsNameTableProxyArchive", [this]
+	{
+		It("should store repeated names only once and restore them from the name table.", [this]
+		{
+			auto WriteNames = [](FWeekendUtilsSaveGameNameTable* NameTable, TArray<uint8>& OutData)
+			{
+				FMemoryWriter MemoryWriter(OutData);
+				FWeekendUtilsNameTableProxyArchive Archive(MemoryWriter, NameTable);
+				for (int32 i = 0; i < 100; ++i)
+				{
+					FName Name = (i % 2 == 0) ? FName("/Script/WeekendUtilsTests.MockSaveGameModule") : FName("OtherName");
+					Archive << Name;
+				}
+			};
+
+			TArray<uint8> PlainData, IndexedData;
+			FWeekendUtilsSaveGameNameTable NameTable;
+			WriteNames(nullptr, OUT PlainData);
+			WriteNames(&NameTable, OUT IndexedData);
+			TestEqual("Num names in table", NameTable.Num(), 2);
+			TestTrue("Indexed data is smaller than plain data", IndexedData.Num() < PlainData.Num());
+
+			FMemoryReader MemoryReader(IndexedData);
+			FWeekendUtilsNameTableProxyArchive Archive(MemoryReader, &NameTable);
+			FName FirstName, SecondName;
+			Archive << FirstName;
+			Archive << SecondName;
+			TestEqual("FirstName", FirstName, FName("/Script/WeekendUtilsTests.MockSaveGameModule"));
+			TestEqual("SecondName", SecondName, FName("OtherName"));
+		});
+
+		It("should resolve each distinct object path only once when a resolved object cache is used.", [this]
+		{
+			TArray<uint8> Data;
+			FWeekendUtilsSaveGameNameTable NameTable;
+			FMemoryWriter MemoryWriter(Data);
+			FWeekendUtilsNameTableProxyArchive WriteArchive(MemoryWriter, &NameTable);
+			for (int32 i = 0; i < 10; ++i)
+			{
+				UObject* Object = UMockSaveGameModule::StaticClass();
+				WriteArchive << Object;
+			}
+
+			FWeekendUtilsResolvedObjectCache ResolvedObjectCache;
+			FMemoryReader MemoryReader(Data);
+			FWeekendUtilsNameTableProxyArchive ReadArchive(MemoryReader, &NameTable);
+			ReadArchive.ResolvedObjectCache = &ResolvedObjectCache;
+			for (int32 i = 0; i < 10; ++i)
+			{
+				UObject* Object = nullptr;
+				ReadArchive << Object;
+				TestEqual("Restored object", Object, static_cast<UObject*>(UMockSaveGameModule::StaticClass()));
+			}
+			TestEqual("NumMisses", ResolvedObjectCache.GetNumMisses(), 1);
+			TestEqual("NumHits", ResolvedObjectCache.GetNumHits(), 9);
+		});
+	});
+
+	Describe("TryDeserializeModule", [this]
+	{
+		It("should list every module in the table of contents of the serialized data.", [this]
+		{
+			SaveGame->FindOrAddModule<UMockSaveGameModule>(FName("OtherMockModule"));
+			TArray<uint8> SaveData;
+			Serializer->TrySerializeSaveGame(*SaveGame, OUT SaveData);
+
+			FModularSaveGameHeader Header;
+			FModularSaveGameTableOfContents TableOfContents;
+			TestTrue("TryReadTableOfContents", Serializer->TryReadTableOfContents(SaveData, OUT Header, OUT TableOfContents));
+			TestEqual("SaveGameFileVersion", Header.SaveGameFileVersion, MODULAR_SAVEGAME_FILE_VERSION);
+			TestNotNull("MockModule section", TableOfContents.FindModuleSection(FName("MockModule")));
+			TestNotNull("OtherMockModule section", TableOfContents.FindModuleSection(FName("OtherMockModule")));
+		});
+
+		It("should restore only the requested module without creating a SaveGame object.", [this]
+		{
+			TArray<uint8> SaveData;
+			Serializer->TrySerializeSaveGame(*SaveGame, OUT SaveData);
+
+			const UMockSaveGameModule* LoadedModule = Serializer->TryDeserializeModule<UMockSaveGameModule>(SaveData, *Serializer);
+			if (TestNotNull("LoadedModule", LoadedModule))
+			{
+				TestEqual("Outer", LoadedModule->GetOuter(), static_cast<UObject*>(Serializer.Get()));
+				TestEqual("Strings", LoadedModule->Strings, SaveGame->FindModule<UMockSaveGameModule>()->Strings);
+			}
+		});
+	});
+
+	Describe("Compression", [this]
+	{
+		It("should write smaller data with compression enabled, which still restores the same SaveGame.", [this]
+		{
+			TArray<uint8> UncompressedData;
+			Serializer->TrySerializeSaveGame(*SaveGame, OUT UncompressedData);
+
+			USaveGameServiceSettings* Settings = GetMutableDefault<USaveGameServiceSettings>();
+			const ESaveGameCompressionFormat PreviousCompressionFormat = Settings->CompressionFormat;
+			Settings->CompressionFormat = ESaveGameCompressionFormat::Zlib;
+			TArray<uint8> CompressedData;
+			Serializer->TrySerializeSaveGame(*SaveGame, OUT CompressedData);
+			Settings->CompressionFormat = PreviousCompressionFormat;
+
+			AddInfo(FString::Printf(TEXT("%d bytes uncompressed vs. %d bytes compressed."), UncompressedData.Num(), CompressedData.Num()));
+			TestTrue("Compressed data is smaller than uncompressed data", CompressedData.Num() < UncompressedData.Num());
+
+			FInstancedStruct HeaderData;
+			TestTrue("TryDeserializeHeaderData", Serializer->TryDeserializeHeaderData(CompressedData, OUT HeaderData));
+
+			const UMockSaveGameModule* LoadedModule = Serializer->TryDeserializeModule<UMockSaveGameModule>(CompressedData, *Serializer);
+			if (TestNotNull("LoadedModule", LoadedModule))
+			{
+				TestEqual("Strings", LoadedModule->Strings, SaveGame->FindModule<UMockSaveGameModule>()->Strings);
+			}
+		});
+	});
+
+	Describe("Integrity", [this]
+	{
+		It("should detect corrupted data by its checksums without deserializing it.", [this]
+		{
+			TArray<uint8> SaveData;
+			Serializer->TrySerializeSaveGame(*SaveGame, OUT SaveData);
+			TestTrue("Intact data is verified", FModularSaveGameHeader::TryVerifyBodyChecksum(SaveData));
+
+			FModularSaveGameHeader Header;
+			FModularSaveGameTableOfContents TableOfContents;
+			Serializer->TryReadTableOfContents(SaveData, OUT Header, OUT TableOfContents);
+			const FModularSaveGameSection* Section = TableOfContents.FindModuleSection(FName("MockModule"));
+			if (!TestNotNull("MockModule section", Section))
+				return;
+
+			SaveData[static_cast<int32>(Section->Offset + Section->Size / 2)] ^= 0xFF;
+			TestFalse("Corrupted data is verified", FModularSaveGameHeader::TryVerifyBodyChecksum(SaveData));
+			TestFalse("Corrupted section is intact", Section->IsIntact(SaveData, Header.SaveGameFileVersion));
+			TestNull("Module restored from corrupted section", Serializer->TryDeserializeModule<UMockSaveGameModule>(SaveData, *Serializer));
+		});
+
+		It("should reject a corrupted number of module sections before allocating them.", [this]
+		{
+			TArray<uint8> SaveData;
+			Serializer->TrySerializeSaveGame(*SaveGame, OUT SaveData);
+
+			// Find the number of module sections, which follows the header and the section of the save game object:
+			FMemoryReader MemoryReader(SaveData, true);
+			MemoryReader.ArIsSaveGame = true;
+			FModularSaveGameHeader Header;
+			FModularSaveGameSection SaveGameSection;
+			Header.TryRead(MemoryReader);
+			MemoryReader << SaveGameSection;
+			const int32 CorruptedNumModuleSections = MAX_int32;
+			FMemory::Memcpy(&SaveData[static_cast<int32>(MemoryReader.Tell())], &CorruptedNumModuleSections, sizeof(int32));
+
+			FModularSaveGameTableOfContents TableOfContents;
+			TestFalse("TryReadTableOfContents", Serializer->TryReadTableOfContents(SaveData, OUT Header, OUT TableOfContents));
+			TestEqual("Num module sections", TableOfContents.ModuleSections.Num(), 0);
+			TestNull("Module restored from corrupted table of contents", Serializer->TryDeserializeModule<UMockSaveGameModule>(SaveData, *Serializer));
+		});
+
+		It("should detect truncated data.", [this]
+		{
+			TArray<uint8> SaveData;
+			Serializer->TrySerializeSaveGame(*SaveGame, OUT SaveData);
+			SaveData.SetNum(SaveData.Num() / 2);
+			TestFalse("Truncated data is verified", FModularSaveGameHeader::TryVerifyBodyChecksum(SaveData));
+		});
+
+#if PLATFORM_DESKTOP
+		It("should load the backup slot of the last save when the slot file is corrupted.", [this]
+		{
+			USaveGameServiceSettings* Settings = GetMutableDefault<USaveGameServiceSettings>();
+			const bool bPreviousUseAtomicSlotWrites = Settings->bUseAtomicSlotWrites;
+			Settings->bUseAtomicSlotWrites = true;
+
+			TestTrue("First save", Serializer->TrySaveGameToSlot(*SaveGame, TestSlotName, UserIndex));
+			SaveGame->FindOrAddModule<UMockSaveGameModule>().Strings.SetNum(1);
+			TestTrue("Second save", Serializer->TrySaveGameToSlot(*SaveGame, TestSlotName, UserIndex));
+			TestTrue("Slot is intact", Serializer->TryVerifySlot(TestSlotName, UserIndex));
+			TestFalse("Backup slot is listed as slot", USaveGameUtils::FindAllLocalSaveGameSlotNames().Contains(USaveGameSerializer::GetBackupSlotName(TestSlotName)));
+
+			// Simulate a torn write of the slot file:
+			const FString SlotFilePath = FPaths::ProjectSavedDir() / "SaveGames" / TestSlotName + ".sav";
+			TArray<uint8> SlotData;
+			FFileHelper::LoadFileToArray(OUT SlotData, *SlotFilePath);
+			SlotData.SetNum(SlotData.Num() / 2);
+			FFileHelper::SaveArrayToFile(SlotData, *SlotFilePath);
+			TestFalse("Slot is intact after torn write", Serializer->TryVerifySlot(TestSlotName, UserIndex));
+
+			USaveGame* LoadedSaveGame = nullptr;
+			TestTrue("TryLoadGameFromSlot", Serializer->TryLoadGameFromSlot(TestSlotName, UserIndex, OUT LoadedSaveGame));
+			const UModularSaveGame* LoadedModularSaveGame = Cast<UModularSaveGame>(LoadedSaveGame);
+			const UMockSaveGameModule* LoadedModule = (LoadedModularSaveGame ? LoadedModularSaveGame->FindModule<UMockSaveGameModule>() : nullptr);
+			if (TestNotNull("LoadedModule", LoadedModule))
+			{
+				TestEqual("Num entries of the last save", LoadedModule->Strings.Num(), 1);
+			}
+
+			TestTrue("TryDeleteGameInSlot", Serializer->TryDeleteGameInSlot(TestSlotName, UserIndex));
+			TestFalse("Slot exists after deletion", Serializer->DoesSaveGameExist(TestSlotName, UserIndex));
+			Settings->bUseAtomicSlotWrites = bPreviousUseAtomicSlotWrites;
+		});
+#endif
+	});
+
+#if PLATFORM_DESKTOP
+	Describe("SlotIndex", [this]
+	{
+		BeforeEach([this]
+		{
+			// (i) The slot index is only enabled afterward, so its entries are only written by the tests and their scans:
+			SaveGame->GetMutableHeaderData<FSimpleSaveGameHeaderData>().SaveCounter = 1;
+			Serializer->TrySaveGameToSlot(*SaveGame, TestSlotName, UserIndex);
+			USaveGameServiceSettings* Settings = GetMutableDefault<USaveGameServiceSettings>();
+			bPreviousUseSlotIndexFile = Settings->bUseSlotIndexFile;
+			Settings->bUseSlotIndexFile = true;
+		});
+
+		AfterEach([this]
+		{
+			GetMutableDefault<USaveGameServiceSettings>()->bUseSlotIndexFile = bPreviousUseSlotIndexFile;
+			FSaveGameSlotIndex::TryRemoveEntry(TestSlotName, UserIndex);
+			FSaveGameSlotIndex::TryRemoveEntry(TestSlotName, UserIndex + 1);
+		});
+
+		LatentIt("should serve the header data of an unchanged slot from the entry of its user.", [this](const FDoneDelegate& Done)
+		{
+			FSaveGameSlotIndex::TryUpdateEntries({ MakeSlotIndexEntryOfTestSlot(UserIndex + 1, 7), MakeSlotIndexEntryOfTestSlot(UserIndex, 42) });
+			ScanTestSlotAndWaitForSlotIndex([this, Done](int32 SaveCounter, const FSaveGameSlotIndexEntry&)
+			{
+				TestEqual("SaveCounter", SaveCounter, 42);
+				Done.Execute();
+			});
+		});
+
+		LatentIt("should rebuild the entry of a slot whose content changed, even if its size did not.", [this](const FDoneDelegate& Done)
+		{
+			FSaveGameSlotIndexEntry ChangedEntry = MakeSlotIndexEntryOfTestSlot(UserIndex, 42);
+			const uint32 SlotChecksum = ChangedEntry.Checksum;
+			ChangedEntry.Timestamp -= FTimespan::FromHours(1.0);
+			ChangedEntry.Checksum = (SlotChecksum + 1);
+			FSaveGameSlotIndex::TryUpdateEntries({ ChangedEntry });
+
+			ScanTestSlotAndWaitForSlotIndex([this, Done, SlotChecksum](int32 SaveCounter, const FSaveGameSlotIndexEntry& RebuiltEntry)
+			{
+				TestEqual("SaveCounter", SaveCounter, 1);
+				TestEqual("Checksum of rebuilt entry", RebuiltEntry.Checksum, SlotChecksum);
+				Done.Execute();
+			});
+		});
+
+		LatentIt("should keep the header data of an entry whose slot file was only touched, by its checksum.", [this](const FDoneDelegate& Done)
+		{
+			FSaveGameSlotIndexEntry TouchedEntry = MakeSlotIndexEntryOfTestSlot(UserIndex, 42);
+			TouchedEntry.Timestamp -= FTimespan::FromHours(1.0);
+			FSaveGameSlotIndex::TryUpdateEntries({ TouchedEntry });
+
+			ScanTestSlotAndWaitForSlotIndex([this, Done](int32 SaveCounter, const FSaveGameSlotIndexEntry& RebuiltEntry)
+			{
+				TestEqual("SaveCounter", SaveCounter, 42);
+
+				FInstancedStruct HeaderData;
+				FSaveGameSlotIndex::TryDecodeHeaderData(RebuiltEntry.EncodedHeaderData, OUT HeaderData);
+				const FSimpleSaveGameHeaderData* SimpleHeaderData = HeaderData.GetPtr<FSimpleSaveGameHeaderData>();
+				TestEqual("SaveCounter of rebuilt entry", (SimpleHeaderData ? SimpleHeaderData->SaveCounter : INDEX_NONE), 42);
+				Done.Execute();
+			});
+		});
+	});
+#endif
+
+	Describe("AsyncSaveGameToSlot", [this]
+	{
+		LatentIt("should call the Callback on the game thread after the game was saved.", [this](const FDoneDelegate& Done)
+		{
+			Serializer->AsyncSaveGameToSlot(*SaveGame, TestSlotName, UserIndex, USaveGameSerializer::FOnAsyncSaveCompleted::CreateLambda(
+				[this, Done](const FString& SlotName, const int32, bool bSuccess)
+				{
+					TestTrue("Callback is called on game thread", IsInGameThread());
+					TestTrue("bSuccess", bSuccess);
+					TestTrue("Save file exists", Serializer->DoesSaveGameExist(SlotName, UserIndex));
+					Done.Execute();
+				}));
+		});
+
+		LatentIt("should save the state of the SaveGame at the time of the call, even if it is modified afterward.", [this](const FDoneDelegate& Done)
+		{
+			Serializer->AsyncSaveGameToSlot(*SaveGame, TestSlotName, UserIndex, USaveGameSerializer::FOnAsyncSaveCompleted::CreateLambda(
+				[this, Done](const FString& SlotName, const int32, bool)
+				{
+					USaveGame* LoadedSaveGame = nullptr;
+					Serializer->TryLoadGameFromSlot(SlotName, UserIndex, OUT LoadedSaveGame);
+					const UModularSaveGame* LoadedModularSaveGame = Cast<UModularSaveGame>(LoadedSaveGame);
+					const UMockSaveGameModule* LoadedModule = (LoadedModularSaveGame ? LoadedModularSaveGame->FindModule<UMockSaveGameModule>() : nullptr);
+					if (TestNotNull("LoadedModule", LoadedModule))
+					{
+						TestEqual("Num saved entries", LoadedModule->Strings.Num(), NumSyntheticEntries);
+					}
+					Done.Execute();
+				}));
+
+			// Modify the SaveGame while the save is still in progress:
+			SaveGame->FindOrAddModule<UMockSaveGameModule>().Strings.Reset();
+		});
+
+		LatentIt("should report the timings of the save compared to a fully synchronous save.", [this](const FDoneDelegate& Done)
+		{
+			// (i) Timings are only reported, since wall-clock comparisons are not reliable on busy machines. See SaveGameBenchmark.spec.cpp.
+			// Before: Serialization, encoding, and writing the file all happen on the game thread:
+			double StartTime = FPlatformTime::Seconds();
+			Serializer->TrySaveGameToSlot(*SaveGame, TestSlotName, UserIndex);
+			const double SynchronousBlockTime = (FPlatformTime::Seconds() - StartTime);
+
+			// After: Only the snapshot is captured on the game thread:
+			StartTime = FPlatformTime::Seconds();
+			TSharedRef<double> AsyncBlockTime = MakeShared<double>(0.0);
+			Serializer->AsyncSaveGameToSlot(*SaveGame, TestSlotName, UserIndex, USaveGameSerializer::FOnAsyncSaveCompleted::CreateLambda(
+				[this, Done, SynchronousBlockTime, AsyncBlockTime](const FString&, const int32, bool bSuccess)
+				{
+					const FSaveGamePipelineStats& Stats = Serializer->GetLastSaveStats();
+					AddInfo(FString::Printf(TEXT("Game thread blocked for %.3f ms before vs. %.3f ms after (%.3f ms in the call, + %.3f ms on worker thread) for %lld bytes."),
+						SynchronousBlockTime * 1000.0, Stats.GameThreadSeconds * 1000.0, *AsyncBlockTime * 1000.0, Stats.WorkerSeconds * 1000.0, Stats.NumBytes));
+
+					TestTrue("bSuccess", bSuccess);
+					TestTrue("NumBytes > 0", Stats.NumBytes > 0);
+					Done.Execute();
+				}));
+			*AsyncBlockTime = (FPlatformTime::Seconds() - StartTime);
+		});
+	});
+
+	Describe("AsyncLoadGameFromSlot", [this]
+	{
+		LatentIt("should construct the SaveGame across frames within the budget and record its load latency.", [this](const FDoneDelegate& Done)
+		{
+			USaveGameServiceSettings* Settings = GetMutableDefault<USaveGameServiceSettings>();
+			const float PreviousAsyncLoadBudgetMs = Settings->AsyncLoadBudgetMs;
+			Settings->AsyncLoadBudgetMs = 0.001f;
+
+			Serializer->TrySaveGameToSlot(*SaveGame, TestSlotName, UserIndex);
+			Serializer->AsyncLoadGameFromSlot(TestSlotName, UserIndex, USaveGameSerializer::FOnAsyncLoadCompleted::CreateLambda(
+				[this, Done, Settings, PreviousAsyncLoadBudgetMs](const FString&, const int32, USaveGame* LoadedSaveGame)
+				{
+					Settings->AsyncLoadBudgetMs = PreviousAsyncLoadBudgetMs;
+					TestTrue("Callback is called on game thread", IsInGameThread());
+
+					const UModularSaveGame* LoadedModularSaveGame = Cast<UModularSaveGame>(LoadedSaveGame);
+					const UMockSaveGameModule* LoadedModule = (LoadedModularSaveGame ? LoadedModularSaveGame->FindModule<UMockSaveGameModule>() : nullptr);
+					if (TestNotNull("LoadedModule", LoadedModule))
+					{
+						TestEqual("Num loaded entries", LoadedModule->Strings.Num(), NumSyntheticEntries);
+					}
+
+					const FSaveGamePipelineStats& Stats = Serializer->GetLastLoadStats();
+					AddInfo(FString::Printf(TEXT("Game thread blocked for %.3f ms (+ %.3f ms on worker thread) with a latency of %.3f ms for %lld bytes."),
+						Stats.GameThreadSeconds * 1000.0, Stats.WorkerSeconds * 1000.0, Stats.LatencySeconds * 1000.0, Stats.NumBytes));
+					TestTrue("NumBytes > 0", Stats.NumBytes > 0);
+					TestTrue("LatencySeconds >= GameThreadSeconds", Stats.LatencySeconds >= Stats.GameThreadSeconds);
+					TestEqual("Median load latency", Serializer->GetLoadLatencyPercentile(0.5), Stats.LatencySeconds);
+					Done.Execute();
+				}));
+		});
+	});
+
+#if PLATFORM_DESKTOP
+	Describe("AsyncDeleteGameInSlot", [this]
+	{
+		LatentIt("should move the slot into its backup folder and only keep the newest backups.", [this](const FDoneDelegate& Done)
+		{
+			USaveGameServiceSettings* Settings = GetMutableDefault<USaveGameServiceSettings>();
+			const int32 PreviousMaxBackupsPerSlot = Settings->MaxBackupsPerSlot;
+			Settings->MaxBackupsPerSlot = 2;
+
+			// (i) Backup folders are rotated by name, so these are ordered from oldest to newest:
+			const TArray<FString> BackupFolders = { "Backup_WeekendUtilsTests_1", "Backup_WeekendUtilsTests_2", "Backup_WeekendUtilsTests_3" };
+			for (int32 i = 0; i < BackupFolders.Num() - 1; ++i)
+			{
+				Serializer->TrySaveGameToSlot(*SaveGame, TestSlotName, UserIndex);
+				Serializer->TryDeleteGameInSlot(TestSlotName, UserIndex, BackupFolders[i]);
+			}
+
+			Serializer->TrySaveGameToSlot(*SaveGame, TestSlotName, UserIndex);
+			Serializer->AsyncDeleteGameInSlot(TestSlotName, UserIndex, BackupFolders.Last(), USaveGameSerializer::FOnAsyncDeleteCompleted::CreateLambda(
+				[this, Done, Settings, PreviousMaxBackupsPerSlot, BackupFolders](const FString& SlotName, const int32, bool bSuccess)
+				{
+					Settings->MaxBackupsPerSlot = PreviousMaxBackupsPerSlot;
+					TestTrue("Callback is called on game thread", IsInGameThread());
+					TestTrue("bSuccess", bSuccess);
+					TestFalse("Slot exists", Serializer->DoesSaveGameExist(SlotName, UserIndex));
+
+					IFileManager& FileManager = IFileManager::Get();
+					for (int32 i = 0; i < BackupFolders.Num(); ++i)
+					{
+						const FString BackupFolderPath = USaveGameSerializer::GetLocalSaveGamesDir() / BackupFolders[i];
+						TestEqual(FString::Printf(TEXT("Backup %s exists"), *BackupFolders[i]),
+							FileManager.FileExists(*(BackupFolderPath / SlotName + ".sav")), (i > 0));
+						FileManager.DeleteDirectory(*BackupFolderPath, false, true);
+					}
+					Done.Execute();
+				}));
+		});
+	});
+#endif
+}
+
+#undef SPEC_TEST_CATEGORY
+#endif WITH_AUTOMATION_WORKER
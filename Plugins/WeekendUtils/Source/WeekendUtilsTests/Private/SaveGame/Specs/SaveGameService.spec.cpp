@@ -13,7 +13,9 @@
 #include "AutomationTest/AutomationTestWorld.h"
 #include "GameService/GameServiceManager.h"
 #include "SaveGame/Mocks/MockSaveGameSerializer.h"
+#include "SaveGame/SaveGameHeader.h"
 #include "SaveGame/SaveGameService.h"
+#include "SaveGame/Settings/SaveGameServiceSettings.h"
 
 #define SPEC_TEST_CATEGORY "WeekendUtils.SaveGame"
 
@@ -73,6 +75,73 @@ WE_END_DEFINE_SPEC(SaveGameService)
 			TestNotNull("SaveGamePassedByCallback", SaveGamePassedByCallback);
 			TestTrue("bWasCallbackCalledWithSuccess", *bWasCallbackCalledWithSuccess);
 		});
+
+		It("should coalesce debounced autosave requests into one save, which any other save request to the slot triggers right away.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			USaveGameServiceSettings* Settings = GetMutableDefault<USaveGameServiceSettings>();
+			const float PreviousAutosaveDebounceSeconds = Settings->AutosaveDebounceSeconds;
+			const float PreviousAutosaveMaxLatencySeconds = Settings->AutosaveMaxLatencySeconds;
+			Settings->AutosaveDebounceSeconds = 10.0f;
+			Settings->AutosaveMaxLatencySeconds = 10.0f;
+
+			const FString AutosaveSlotName = SaveGameService->GetAutosaveSlotName();
+			const int32 NumSerializedBefore = SaveGameSerializer->SerializedSaveGameObjects.Num();
+			int32 NumCallbacks = 0;
+			const auto CountCallback = USaveGameService::FOnSaveLoadCompleted::CreateLambda([&NumCallbacks](USaveGame*, bool) { ++NumCallbacks; });
+			TArray<FAsyncSaveGameHandle> AutosaveHandles = {};
+			for (int32 i = 0; i < 3; ++i)
+			{
+				AutosaveHandles.Add(SaveGameService->RequestAutosave("Test", CountCallback));
+			}
+			TestFalse("Autosave file exists while debounced", SaveGameSerializer->DoesSaveGameExist(AutosaveSlotName, UserIndex));
+			TestTrue("IsSaveRequestAlive while debounced", SaveGameService->IsSaveRequestAlive(AutosaveHandles.Last()));
+
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", AutosaveSlotName, CountCallback);
+			Settings->AutosaveDebounceSeconds = PreviousAutosaveDebounceSeconds;
+			Settings->AutosaveMaxLatencySeconds = PreviousAutosaveMaxLatencySeconds;
+
+			TestTrue("Autosave file exists", SaveGameSerializer->DoesSaveGameExist(AutosaveSlotName, UserIndex));
+			TestEqual("Num callbacks", NumCallbacks, 4);
+			TestEqual("Num saves", SaveGameSerializer->SerializedSaveGameObjects.Num() - NumSerializedBefore, 1);
+		});
+
+		It("should save debounced autosaves right away, before a requested load replaces the current SaveGame.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			USaveGameServiceSettings* Settings = GetMutableDefault<USaveGameServiceSettings>();
+			const float PreviousAutosaveDebounceSeconds = Settings->AutosaveDebounceSeconds;
+			const float PreviousAutosaveMaxLatencySeconds = Settings->AutosaveMaxLatencySeconds;
+			Settings->AutosaveDebounceSeconds = 10.0f;
+			Settings->AutosaveMaxLatencySeconds = 10.0f;
+
+			const FString AutosaveSlotName = SaveGameService->GetAutosaveSlotName();
+			TSharedRef<bool> bWasAutosaved = MakeShared<bool>(false);
+			TSharedRef<bool> bWasAutosavedBeforeLoad = MakeShared<bool>(false);
+			SaveGameService->RequestAutosave("Test", USaveGameService::FOnSaveLoadCompleted::CreateLambda([bWasAutosaved](USaveGame*, bool bSuccess)
+			{
+				*bWasAutosaved = bSuccess;
+			}));
+			TestFalse("Autosave file exists while debounced", SaveGameSerializer->DoesSaveGameExist(AutosaveSlotName, UserIndex));
+
+			TSharedRef<bool> bWasLoaded = MakeShared<bool>(false);
+			SaveGameService->RequestLoadCurrentSaveGameFromSlot("Test", AutosaveSlotName, USaveGameService::FOnSaveLoadCompleted::CreateLambda(
+				[bWasAutosaved, bWasAutosavedBeforeLoad, bWasLoaded](USaveGame*, bool bSuccess)
+				{
+					*bWasAutosavedBeforeLoad = *bWasAutosaved;
+					*bWasLoaded = bSuccess;
+				}));
+			Settings->AutosaveDebounceSeconds = PreviousAutosaveDebounceSeconds;
+			Settings->AutosaveMaxLatencySeconds = PreviousAutosaveMaxLatencySeconds;
+
+			TestTrue("Autosave file exists", SaveGameSerializer->DoesSaveGameExist(AutosaveSlotName, UserIndex));
+			TestTrue("bWasAutosavedBeforeLoad", *bWasAutosavedBeforeLoad);
+			TestTrue("bWasLoaded", *bWasLoaded);
+		});
 	});
 
 	Describe("RequestSaveCurrentSaveGameToSlot", [this]
@@ -105,6 +174,19 @@ WE_END_DEFINE_SPEC(SaveGameService)
 			TestTrue("bWasCallbackCalledWithSuccess", *bWasCallbackCalledWithSuccess);
 		});
 
+		It("should no longer report the request as alive once the game was saved.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			const FAsyncSaveGameHandle Handle = SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName);
+			TestTrue("Handle is valid", Handle.IsValid());
+			TestFalse("IsSaveRequestAlive", SaveGameService->IsSaveRequestAlive(Handle));
+
+			SaveGameService->CancelSaveRequest(Handle); // Must be ignored for completed requests.
+			TestTrue("Save file exists", SaveGameSerializer->DoesSaveGameExist(TestSlotName, UserIndex));
+		});
+
 		It("should cache the saved SaveGame", [this]
 		{
 			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
@@ -115,6 +197,175 @@ WE_END_DEFINE_SPEC(SaveGameService)
 			const USaveGame* CachedSaveGame = SaveGameService->GetCachedSaveGameSnapshotAtSlot(TestSlotName);
 			TestNotNull("CachedSaveGame", CachedSaveGame);
 		});
+
+		It("should cache the header data of the saved SaveGame", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName);
+
+			TestNotNull("CachedHeaderData", SaveGameService->GetCachedHeaderDataAtSlot(TestSlotName));
+		});
+
+		It("should only identify the cached snapshot itself as snapshot, but neither the current SaveGame nor copies loaded from cache", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName);
+
+			const USaveGame* CachedSaveGame = SaveGameService->GetCachedSaveGameSnapshotAtSlot(TestSlotName);
+			if (!TestNotNull("CachedSaveGame", CachedSaveGame))
+				return;
+
+			USaveGame* LoadedSaveGame = nullptr;
+			SaveGameService->RequestLoadCurrentSaveGameFromSlot("Test", TestSlotName, USaveGameService::FOnSaveLoadCompleted::CreateLambda([&](USaveGame* SaveGame, bool)
+			{
+				LoadedSaveGame = SaveGame;
+			}));
+
+			TestTrue("Cached snapshot is snapshot", SaveGameService->IsCachedSaveGameSnapshot(*CachedSaveGame));
+			TestNotNull("LoadedSaveGame", LoadedSaveGame);
+			TestNotEqual("LoadedSaveGame", static_cast<const USaveGame*>(LoadedSaveGame), CachedSaveGame);
+			TestFalse("Current SaveGame is snapshot", SaveGameService->IsCachedSaveGameSnapshot(SaveGameService->GetCurrentSaveGame().GetRef()));
+			TestEqual("Cached snapshot after loading", SaveGameService->GetCachedSaveGameSnapshotAtSlot(TestSlotName), CachedSaveGame);
+		});
+	});
+
+	Describe("ScanSaveGameHeadersAsync", [this]
+	{
+		It("should pass the header data of all existing slots to the Callback.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName);
+
+			TMap<FString, FInstancedStruct> ScannedHeaderData = {};
+			SaveGameService->ScanSaveGameHeadersAsync({TestSlotName, "NonExistingSlot"}, USaveGameService::FOnHeaderScanCompleted::CreateLambda(
+				[&ScannedHeaderData](const TMap<FString, FInstancedStruct>& HeaderDataBySlot)
+				{
+					ScannedHeaderData = HeaderDataBySlot;
+				}));
+
+			TestEqual("Num scanned slots", ScannedHeaderData.Num(), 1);
+			const FInstancedStruct* HeaderData = ScannedHeaderData.Find(TestSlotName);
+			TestNotNull("SimpleHeaderData", HeaderData ? HeaderData->GetPtr<FSimpleSaveGameHeaderData>() : nullptr);
+		});
+	});
+
+	Describe("RefreshSlotCatalogAsync", [this]
+	{
+		It("should list existing slots, which were neither saved nor scanned by the service before.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			// (i) Copying the data of another slot pretends a file that was written without the service knowing about it.
+			const FString AutosaveSlotName = SaveGameService->GetAutosaveSlotName();
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName);
+			SaveGameSerializer->TrySaveDataToSlot(SaveGameSerializer->PretendedSaveGamesOnDisk.FindChecked(TestSlotName), AutosaveSlotName, UserIndex);
+			TestFalse("Autosave slot is listed before refreshing", SaveGameService->GetSlotNamesAllowedForLoading().Contains(AutosaveSlotName));
+
+			int32 NumBroadcasts = 0;
+			const FDelegateHandle OnChangedHandle = SaveGameService->OnAvailableSaveGamesChanged.AddLambda([&NumBroadcasts] { ++NumBroadcasts; });
+			SaveGameService->RefreshSlotCatalogAsync();
+
+			TestFalse("IsRefreshingSlotCatalog", SaveGameService->IsRefreshingSlotCatalog());
+			TestTrue("Autosave slot is listed after refreshing", SaveGameService->GetSlotNamesAllowedForLoading().Contains(AutosaveSlotName));
+			TestTrue("OnAvailableSaveGamesChanged was broadcast", (NumBroadcasts > 0));
+			SaveGameService->OnAvailableSaveGamesChanged.Remove(OnChangedHandle);
+		});
+
+		It("should keep listing cataloged slots until a refresh finds their files to be missing.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			const FString AutosaveSlotName = SaveGameService->GetAutosaveSlotName();
+			SaveGameService->RequestAutosave("Test");
+			SaveGameService->RefreshSlotCatalogAsync();
+			SaveGameSerializer->TryDeleteGameInSlot(AutosaveSlotName, UserIndex, {});
+			TestTrue("Autosave slot is listed before refreshing", SaveGameService->GetSlotNamesAllowedForLoading().Contains(AutosaveSlotName));
+
+			SaveGameService->RefreshSlotCatalogAsync();
+			TestFalse("Autosave slot is listed after refreshing", SaveGameService->GetSlotNamesAllowedForLoading().Contains(AutosaveSlotName));
+		});
+
+		It("should allow to delete slots, which were only found by the refresh.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			const FString AutosaveSlotName = SaveGameService->GetAutosaveSlotName();
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName);
+			SaveGameSerializer->TrySaveDataToSlot(SaveGameSerializer->PretendedSaveGamesOnDisk.FindChecked(TestSlotName), AutosaveSlotName, UserIndex);
+			SaveGameService->RefreshSlotCatalogAsync();
+
+			SaveGameService->DeleteSaveGameAtSlot(AutosaveSlotName, false);
+			TestFalse("Autosave file exists after deleting", SaveGameSerializer->DoesSaveGameExist(AutosaveSlotName, UserIndex));
+			TestFalse("Autosave slot is listed after deleting", SaveGameService->GetSlotNamesAllowedForLoading().Contains(AutosaveSlotName));
+		});
+	});
+
+	Describe("DeleteSaveGameAtSlot", [this]
+	{
+		It("should delete the file and cached SaveGame of the slot.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName);
+			SaveGameService->DeleteSaveGameAtSlot(TestSlotName, false);
+
+			TestFalse("Test file exists after deleting", SaveGameSerializer->DoesSaveGameExist(TestSlotName, UserIndex));
+			TestNull("Cached snapshot after deleting", SaveGameService->GetCachedSaveGameSnapshotAtSlot(TestSlotName));
+		});
+
+		It("should delete the file of a slot, which the service neither cached nor cataloged.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			const FString UnknownSlotName = "Unknown";
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName);
+			SaveGameSerializer->TrySaveDataToSlot(SaveGameSerializer->PretendedSaveGamesOnDisk.FindChecked(TestSlotName), UnknownSlotName, UserIndex);
+
+			SaveGameService->DeleteSaveGameAtSlot(UnknownSlotName, false);
+			TestFalse("Unknown file exists after deleting", SaveGameSerializer->DoesSaveGameExist(UnknownSlotName, UserIndex));
+			TestTrue("Test file exists after deleting another slot", SaveGameSerializer->DoesSaveGameExist(TestSlotName, UserIndex));
+		});
+	});
+
+	Describe("PreloadSaveGamesAsync", [this]
+	{
+		It("should preload all existing slots when loads of different slots may run concurrently.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			USaveGameServiceSettings* Settings = GetMutableDefault<USaveGameServiceSettings>();
+			const uint8 PreviousMaxConcurrentLoads = Settings->MaxConcurrentLoads;
+			Settings->MaxConcurrentLoads = 4;
+
+			const TSet<FString> SlotNames = {"Test1", "Test2", "Test3", "Test4", "Test5"};
+			for (const FString& SlotName : SlotNames)
+			{
+				SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", SlotName);
+			}
+
+			TArray<FString> PreloadedSlotNames = {};
+			SaveGameService->PreloadSaveGamesAsync(SlotNames, USaveGameService::FOnPreloadCompleted::CreateLambda(
+				[&PreloadedSlotNames](TArray<USaveGame*>, TArray<FString> ResultSlotNames)
+				{
+					PreloadedSlotNames = ResultSlotNames;
+				}));
+			Settings->MaxConcurrentLoads = PreviousMaxConcurrentLoads;
+
+			TestEqual("Num preloaded slots", PreloadedSlotNames.Num(), SlotNames.Num());
+			TestFalse("IsBusyLoading", SaveGameService->IsBusyLoading());
+		});
 	});
 }
 
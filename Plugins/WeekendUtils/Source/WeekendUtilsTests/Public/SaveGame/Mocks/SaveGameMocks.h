@@ -0,0 +1,115 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SaveGame/ModularSaveGame.h"
+#include "SaveGame/SaveGameModule.h"
+#include "SaveGame/Modules/LevelObjectRestorer.h"
+
+#include "SaveGameMocks.generated.h"
+
+/**
+ * SaveGame module that carries synthetic payload data, so tests can produce
+ * @UModularSaveGame objects of a deterministic composition and size.
+ */
+UCLASS(Hidden, NotBlueprintable, NotBlueprintType, ClassGroup=Tests)
+class WEEKENDUTILSTESTS_API UMockSaveGameModule : public USaveGameModule
+{
+	GENERATED_BODY()
+
+public:
+	UMockSaveGameModule()
+	{
+		DefaultModuleName = "MockModule";
+	}
+
+	UPROPERTY(SaveGame)
+	TArray<FString> Strings = {};
+
+	UPROPERTY(SaveGame)
+	TArray<int32> Integers = {};
+
+	UPROPERTY(SaveGame)
+	TMap<FName, FTransform> Transforms = {};
+
+	/** Replaces the payload with NumEntries deterministic entries per container, derived from the Seed. */
+	void FillWithSyntheticData(const int32 NumEntries, const int32 Seed = 0);
+};
+
+/**
+ * Object with a deterministic set of SaveGame properties, which can be
+ * registered at a @ULevelObjectRestorer when created inside a game world.
+ */
+UCLASS(Hidden, NotBlueprintable, NotBlueprintType, ClassGroup=Tests)
+class WEEKENDUTILSTESTS_API UMockLevelObject : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(SaveGame)
+	int32 Health = 100;
+
+	UPROPERTY(SaveGame)
+	bool bIsActivated = false;
+
+	UPROPERTY(SaveGame)
+	FName State = NAME_None;
+
+	UPROPERTY(SaveGame)
+	TArray<uint8> Payload = {};
+
+	/** Replaces the SaveGame properties with deterministic values and PayloadSize bytes, derived from the Seed. */
+	void FillWithSyntheticData(const int32 PayloadSize, const int32 Seed = 0);
+};
+
+/** Level object with only hashable SaveGame properties, so changes can be detected by the dirty tracking of the @ULevelObjectRestorer. */
+UCLASS(Hidden, NotBlueprintable, NotBlueprintType, ClassGroup=Tests)
+class WEEKENDUTILSTESTS_API UMockHashableLevelObject : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(SaveGame)
+	int32 Health = 100;
+
+	UPROPERTY(SaveGame)
+	FName State = NAME_None;
+};
+
+/** Exposes the settings of the @ULevelObjectRestorer, and writes data like older module versions did, so tests can cover their upgrades. */
+UCLASS(Hidden, ClassGroup=Tests)
+class WEEKENDUTILSTESTS_API UMockLevelObjectRestorer : public ULevelObjectRestorer
+{
+	GENERATED_BODY()
+
+public:
+	using ULevelObjectRestorer::DirtyTrackingMode;
+	using ULevelObjectRestorer::bPackStatesOfUnloadedLevels;
+	using ULevelObjectRestorer::PackedLevelPartitions;
+	using ULevelObjectRestorer::RegistrationBudgetMs;
+	using ULevelObjectRestorer::RestoreBudgetMs;
+	using ULevelObjectRestorer::HandleLevelAddedToWorld;
+	using ULevelObjectRestorer::HandleLevelRemovedFromWorld;
+
+	/** Writes the states of given objects by their full ObjectId, like modules before ModuleVersion_WithObjectStateKeys did. */
+	void SerializeAsLegacyModuleVersion(FArchive& Ar, int32 LegacyModuleVersion, const TMap<FString, UObject*>& ObjectsById);
+};
+
+/** Exposes the separate stages of the save pipeline, so they can be measured individually. */
+UCLASS(Hidden, ClassGroup=Tests)
+class WEEKENDUTILSTESTS_API UMockPipelineSaveGameSerializer : public UModularSaveGameSerializer
+{
+	GENERATED_BODY()
+
+public:
+	using UModularSaveGameSerializer::TryCaptureSaveGameSnapshot;
+	using UModularSaveGameSerializer::MakeSaveDataEncoder;
+};